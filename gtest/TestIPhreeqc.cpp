@@ -4781,3 +4781,1527 @@ TEST(TestIPhreeqc, TestEx10)
 		ASSERT_EQ(std::string(expected), obj.GetAccumulatedLines());
 	}
 }
+
+TEST(TestIPhreeqc, TestSparseNewton)
+{
+	const char input[] =
+		"SOLUTION 1\n"
+		"  pH 7.5; Na 10; Cl 10; Ca 2; Mg 1; Zn 0.01; S(6) 1; C 3\n"
+		"EXCHANGE 1\n"
+		"  X 0.1\n"
+		"  -equilibrate 1\n"
+		"SURFACE 1\n"
+		"  Hfo_wOH 0.01 600 1\n"
+		"  Hfo_sOH 0.0005\n"
+		"  -equilibrate 1\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -pH true\n"
+		"  -totals Ca Zn\n"
+		"END\n";
+
+	IPhreeqc dense;
+	ASSERT_EQ(0, dense.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, dense.RunString(input));
+
+	IPhreeqc sparse;
+	ASSERT_EQ(0, sparse.LoadDatabase("phreeqc.dat"));
+	std::string sparse_input("KNOBS\n  -sparse_newton true\n");
+	sparse_input += input;
+	ASSERT_EQ(0, sparse.RunString(sparse_input.c_str()));
+
+	ASSERT_EQ(dense.GetSelectedOutputRowCount(), sparse.GetSelectedOutputRowCount());
+	ASSERT_EQ(dense.GetSelectedOutputColumnCount(), sparse.GetSelectedOutputColumnCount());
+	for (int r = 1; r < dense.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < dense.GetSelectedOutputColumnCount(); ++c)
+		{
+			CVar vd, vs;
+			ASSERT_EQ(VR_OK, dense.GetSelectedOutputValue(r, c, &vd));
+			ASSERT_EQ(VR_OK, sparse.GetSelectedOutputValue(r, c, &vs));
+			ASSERT_EQ(TT_DOUBLE, vd.type);
+			ASSERT_NEAR(vd.dVal, vs.dVal, 1e-8 * fabs(vd.dVal) + 1e-20);
+		}
+	}
+}
+
+TEST(TestIPhreeqc, TestLogkCache)
+{
+	const char input[] =
+		"SOLUTION 1-10\n"
+		"  temp 10\n"
+		"  pH 7.5; Na 10; Cl 10; Ca 2; C 3\n"
+		"EQUILIBRIUM_PHASES 1-10\n"
+		"  Calcite 0 0.1\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 10\n"
+		"  -shifts 5\n"
+		"SOLUTION 0\n"
+		"  temp 25\n"
+		"  pH 6.5; Na 1; Cl 1\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -pH true\n"
+		"  -totals Ca\n"
+		"END\n";
+
+	IPhreeqc cached;
+	ASSERT_EQ(0, cached.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, cached.RunString(input));
+	ASSERT_GT(cached.GetLogkCacheHits(), 0);
+	ASSERT_GT(cached.GetLogkCacheMisses(), 0);
+
+	IPhreeqc uncached;
+	ASSERT_EQ(0, uncached.LoadDatabase("phreeqc.dat"));
+	int hits = uncached.GetLogkCacheHits();
+	int misses = uncached.GetLogkCacheMisses();
+	std::string uncached_input("KNOBS\n  -logk_cache_size 0\n");
+	uncached_input += input;
+	ASSERT_EQ(0, uncached.RunString(uncached_input.c_str()));
+	ASSERT_EQ(hits, uncached.GetLogkCacheHits());
+	ASSERT_EQ(misses, uncached.GetLogkCacheMisses());
+
+	ASSERT_EQ(cached.GetSelectedOutputRowCount(), uncached.GetSelectedOutputRowCount());
+	for (int r = 1; r < cached.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < cached.GetSelectedOutputColumnCount(); ++c)
+		{
+			CVar vc, vu;
+			ASSERT_EQ(VR_OK, cached.GetSelectedOutputValue(r, c, &vc));
+			ASSERT_EQ(VR_OK, uncached.GetSelectedOutputValue(r, c, &vu));
+			ASSERT_EQ(vu.dVal, vc.dVal);
+		}
+	}
+}
+
+TEST(TestIPhreeqc, TestPitzerBrine)
+{
+	const char input[] =
+		"SOLUTION 1 seawater\n"
+		"  units mg/L\n"
+		"  pH 8.2\n"
+		"  Ca 412; Mg 1291; Na 10768; K 399; Cl 19353; S(6) 2712; Alkalinity 141 as HCO3; Br 67\n"
+		"REACTION 1\n"
+		"  H2O -1\n"
+		"  45 53\n"
+		"EQUILIBRIUM_PHASES 1\n"
+		"  Gypsum 0 0; Halite 0 0; Anhydrite 0 0; Glauberite 0 0\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -ionic_strength true\n"
+		"  -activities H2O\n"
+		"  -saturation_indices Halite\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("pitzer.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_EQ(4, obj.GetSelectedOutputRowCount());
+
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 0, &v));
+	ASSERT_NEAR(0.722246, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(3, 0, &v));
+	ASSERT_NEAR(8.229901, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(3, 1, &v));
+	ASSERT_NEAR(-0.140973, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(3, 2, &v));
+	ASSERT_NEAR(0.0, v.dVal, 1e-8);
+}
+
+TEST(TestIPhreeqc, TestSitBrine)
+{
+	const char input[] =
+		"SOLUTION 1\n"
+		"  units mol/kgw\n"
+		"  pH 7\n"
+		"  Na 1; Cl 1 charge; Ca 0.01; S(6) 0.005; C 0.001\n"
+		"REACTION 1\n"
+		"  NaCl 1\n"
+		"  0.5 1 1.5 2\n"
+		"EQUILIBRIUM_PHASES 1\n"
+		"  Calcite 0 0\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -ionic_strength true\n"
+		"  -activities H2O Na+\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("sit.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_EQ(6, obj.GetSelectedOutputRowCount());
+
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 0, &v));
+	ASSERT_NEAR(1.033885, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(5, 0, &v));
+	ASSERT_NEAR(3.034122, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(5, 1, &v));
+	ASSERT_NEAR(-0.047881, v.dVal, 1e-6);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(5, 2, &v));
+	ASSERT_NEAR(0.320855, v.dVal, 1e-6);
+}
+
+TEST(TestIPhreeqc, TestImplicitStagnant)
+{
+	const char input[] =
+		"SOLUTION 0\n"
+		"  pH 7 charge; Na 20; Cl 20; K 2\n"
+		"SOLUTION 1-10\n"
+		"  pH 7 charge; Na 1; Cl 1; Ca 1\n"
+		"SOLUTION 12-21\n"
+		"  pH 7 charge; Na 1; Cl 1; Ca 1\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 10\n"
+		"  -shifts 5\n"
+		"  -flow_direction diffusion_only\n"
+		"  -time_step 3600\n"
+		"  -lengths 0.01\n"
+		"  -boundary_conditions constant closed\n"
+		"  -multi_d true 1e-9 0.3 0.05 1.0\n"
+		"  -stagnant 1 6.8e-6 0.3 0.1\n"
+		"  -implicit true\n"
+		"  -punch_cells 2 13\n"
+		"  -punch_frequency 5\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -totals K Ca\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_EQ(5, obj.GetSelectedOutputRowCount());
+
+	// mobile cell 2 and its stagnant cell 13 after 5 shifts
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(3, 0, &v));
+	ASSERT_NEAR(1.8292577e-05, v.dVal, 1e-12);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(3, 1, &v));
+	ASSERT_NEAR(1.0025779e-03, v.dVal, 1e-10);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(4, 0, &v));
+	ASSERT_NEAR(4.6811884e-06, v.dVal, 1e-12);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(4, 1, &v));
+	ASSERT_NEAR(1.0006850e-03, v.dVal, 1e-10);
+}
+
+TEST(TestIPhreeqc, TestMcdFlux)
+{
+	const char input[] =
+		"SOLUTION 0\n"
+		"  pH 7 charge; Na 20; Cl 20; K 2\n"
+		"SOLUTION 1-10\n"
+		"  pH 7 charge; Na 1; Cl 1; Ca 1\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 10\n"
+		"  -shifts 5\n"
+		"  -flow_direction diffusion_only\n"
+		"  -time_step 3600\n"
+		"  -lengths 0.01\n"
+		"  -boundary_conditions constant closed\n"
+		"  -multi_d true 1e-9 0.3 0.05 1.0\n"
+		"  -punch_cells 1\n"
+		"  -punch_frequency 5\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"USER_PUNCH\n"
+		"  -headings jtot_K jconc_K jtot_Ca jtot_Mg\n"
+		"  10 PUNCH MCD_JTOT(\"K+\"), MCD_JCONC(\"K+\"), MCD_JTOT(\"Ca+2\"), MCD_JTOT(\"Mg+2\")\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_EQ(3, obj.GetSelectedOutputRowCount());
+
+	// fluxes into cell 1 after 5 shifts, Mg+2 is not in the column
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 0, &v));
+	ASSERT_NEAR(6.9962209e-06, v.dVal, 1e-12);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 1, &v));
+	ASSERT_NEAR(6.8211203e-06, v.dVal, 1e-12);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 2, &v));
+	ASSERT_NEAR(-1.4827885e-07, v.dVal, 1e-13);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 3, &v));
+	ASSERT_EQ(0.0, v.dVal);
+}
+
+TEST(TestIPhreeqc, TestMcdElectromigration)
+{
+	const char input[] =
+		"SOLUTION 0\n"
+		"  pH 7 charge; Na 10; Cl 10; K 2; Fe(2) 0.1\n"
+		"  potential 1\n"
+		"SOLUTION 1-10\n"
+		"  pH 7 charge; Na 1; Cl 1; Ca 1; Fe(3) 0.01\n"
+		"SOLUTION 11\n"
+		"  pH 7 charge; Na 1; Cl 1\n"
+		"  potential 0\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 10\n"
+		"  -shifts 5\n"
+		"  -flow_direction diffusion_only\n"
+		"  -time_step 1800\n"
+		"  -lengths 0.01\n"
+		"  -boundary_conditions constant constant\n"
+		"  -multi_d true 1e-9 0.3 0.05 1.0\n"
+		"  -punch_cells 3\n"
+		"  -punch_frequency 5\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -totals K Fe(3)\n"
+		"USER_PUNCH\n"
+		"  -headings pot_v\n"
+		"  10 PUNCH POT_V\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_EQ(3, obj.GetSelectedOutputRowCount());
+
+	// cell 3 after 5 shifts with 1 V over the column
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 0, &v));
+	ASSERT_NEAR(5.6826610e-07, v.dVal, 1e-13);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 1, &v));
+	ASSERT_NEAR(1.0000613e-05, v.dVal, 1e-11);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(2, 2, &v));
+	ASSERT_NEAR(0.78265696, v.dVal, 1e-7);
+}
+
+TEST(TestIPhreeqc, TestSolutionRangeCopies)
+{
+	const char input[] =
+		"SOLUTION 5\n"
+		"  Na 5; Cl 5\n"
+		"SOLUTION 12\n"
+		"  K 2; Cl 2\n"
+		"END\n"
+		"SOLUTION 1-10\n"
+		"  Ca 1; Cl 2\n"
+		"END\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -solution true\n"
+		"  -totals Na Ca K\n"
+		"RUN_CELLS\n"
+		"  -cells 4-5 10-12\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+
+	// the range replaces solution 5, leaves 12 and does not create 11
+	ASSERT_EQ(5, obj.GetSelectedOutputRowCount());
+	const int n_user[] = {4, 5, 10, 12};
+	CVar v;
+	for (int r = 1; r <= 4; ++r)
+	{
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, 0, &v));
+		ASSERT_EQ(n_user[r - 1], v.lVal);
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, 1, &v));
+		ASSERT_EQ(0.0, v.dVal);
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, 2, &v));
+		ASSERT_NEAR(r < 4 ? 1e-3 : 0.0, v.dVal, 1e-12);
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, 3, &v));
+		ASSERT_NEAR(r < 4 ? 0.0 : 2e-3, v.dVal, 1e-12);
+	}
+}
+
+TEST(TestIPhreeqc, TestAllocationStatistics)
+{
+	const char input[] =
+		"SOLUTION 0\n"
+		"  pH 7; Na 1; Cl 1\n"
+		"SOLUTION 1-10\n"
+		"  pH 7; K 1; Br 1\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 10\n"
+		"  -shifts 5\n"
+		"  -multi_d true 1e-9 0.3 0.05 1.0\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(input));
+
+	double bytes = obj.GetAllocatedBytes();
+	double peak = obj.GetPeakAllocatedBytes();
+	double total = obj.GetTotalAllocatedBytes();
+	double count = obj.GetAllocationCount();
+	ASSERT_GT(bytes, 0.0);
+	ASSERT_GE(peak, bytes);
+	ASSERT_GE(total, peak);
+	ASSERT_GT(count, 0.0);
+
+	// a second run allocates more, but frees what the first run left for transport
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_GT(obj.GetTotalAllocatedBytes(), total);
+	ASSERT_GT(obj.GetAllocationCount(), count);
+	ASSERT_GE(obj.GetPeakAllocatedBytes(), peak);
+	ASSERT_LE(obj.GetAllocatedBytes(), obj.GetPeakAllocatedBytes());
+}
+
+struct StreamedRows
+{
+	std::vector<std::string> headings;
+	std::vector< std::vector<CVar> > rows;
+};
+
+static int stream_row(int n_user, int ncols, const char* const* headings, const VAR* values, void *cookie)
+{
+	StreamedRows* streamed = (StreamedRows*)cookie;
+	EXPECT_EQ(1, n_user);
+	if (streamed->headings.empty())
+	{
+		streamed->headings.assign(headings, headings + ncols);
+	}
+	streamed->rows.push_back(std::vector<CVar>());
+	for (int c = 0; c < ncols; ++c)
+	{
+		CVar v;
+		::VarCopy(&v, &values[c]);
+		streamed->rows.back().push_back(v);
+	}
+	return 0;
+}
+
+TEST(TestIPhreeqc, TestSelectedOutputCallback)
+{
+	const char input[] =
+		"SOLUTION 0\n"
+		"  pH 7; Na 1; Cl 1\n"
+		"SOLUTION 1-5\n"
+		"  pH 7; K 1; Br 1\n"
+		"END\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -step true\n"
+		"  -totals Na K\n"
+		"USER_PUNCH\n"
+		"  -headings desc\n"
+		"  10 PUNCH DESCRIPTION\n"
+		"TRANSPORT\n"
+		"  -cells 5\n"
+		"  -shifts 4\n"
+		"END\n";
+
+	IPhreeqc buffered;
+	ASSERT_EQ(0, buffered.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, buffered.RunString(input));
+	ASSERT_EQ(4, buffered.GetSelectedOutputColumnCount());
+
+	StreamedRows streamed;
+	IPhreeqc streaming;
+	ASSERT_EQ(0, streaming.LoadDatabase("phreeqc.dat"));
+	streaming.SetSelectedOutputCallback(stream_row, &streamed);
+	ASSERT_EQ(0, streaming.RunString(input));
+
+	// only the headings are kept
+	ASSERT_EQ(1, streaming.GetSelectedOutputRowCount());
+	ASSERT_EQ(4, streaming.GetSelectedOutputColumnCount());
+	ASSERT_EQ((size_t)buffered.GetSelectedOutputRowCount() - 1, streamed.rows.size());
+
+	CVar v;
+	for (int c = 0; c < buffered.GetSelectedOutputColumnCount(); ++c)
+	{
+		ASSERT_EQ(VR_OK, buffered.GetSelectedOutputValue(0, c, &v));
+		ASSERT_EQ(std::string(v.sVal), streamed.headings[c]);
+	}
+	for (int r = 1; r < buffered.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < buffered.GetSelectedOutputColumnCount(); ++c)
+		{
+			const CVar& s = streamed.rows[r - 1][c];
+			ASSERT_EQ(VR_OK, buffered.GetSelectedOutputValue(r, c, &v));
+			ASSERT_EQ(v.type, s.type);
+			switch (v.type)
+			{
+			case TT_DOUBLE:
+				ASSERT_EQ(v.dVal, s.dVal);
+				break;
+			case TT_LONG:
+				ASSERT_EQ(v.lVal, s.lVal);
+				break;
+			case TT_STRING:
+				ASSERT_EQ(std::string(v.sVal), std::string(s.sVal));
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	// back to in-memory rows
+	streaming.SetSelectedOutputCallback(NULL, NULL);
+	ASSERT_EQ(0, streaming.RunString(input));
+	ASSERT_EQ(0, buffered.RunString(input));
+	ASSERT_EQ(buffered.GetSelectedOutputRowCount(), streaming.GetSelectedOutputRowCount());
+}
+
+static int stop_after_two_rows(int n_user, int ncols, const char* const* headings, const VAR* values, void *cookie)
+{
+	int* count = (int*)cookie;
+	return (++(*count) >= 2) ? 1 : 0;
+}
+
+TEST(TestIPhreeqc, TestSelectedOutputCallbackStop)
+{
+	int count = 0;
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	obj.SetSelectedOutputCallback(stop_after_two_rows, &count);
+	ASSERT_EQ(1, obj.RunString(
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -solution true\n"
+		"SOLUTION 1\n"
+		"SOLUTION 2\n"
+		"SOLUTION 3\n"
+		"END\n"));
+	ASSERT_EQ(2, count);
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Selected output callback returned 1") != NULL);
+
+	// rows are kept again once the callback is cleared
+	obj.SetSelectedOutputCallback(NULL, NULL);
+	ASSERT_EQ(0, obj.RunString("SOLUTION 1\nEND\n"));
+	ASSERT_EQ(2, obj.GetSelectedOutputRowCount());
+}
+
+TEST(TestIPhreeqc, TestGetSelectedOutputColumn)
+{
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -solution true\n"
+		"  -pH true\n"
+		"  -totals Na\n"
+		"USER_PUNCH\n"
+		"  -headings desc\n"
+		"  10 PUNCH DESCRIPTION\n"
+		"SOLUTION 1\n"
+		"  pH 7; Na 1; Cl 1\n"
+		"SOLUTION 2\n"
+		"  pH 7.5; Na 2; Cl 2\n"
+		"SOLUTION 3\n"
+		"  pH 8; Na 3; Cl 3\n"
+		"END\n"));
+
+	int rows = obj.GetSelectedOutputRowCount() - 1;
+	ASSERT_EQ(3, rows);
+	ASSERT_EQ(4, obj.GetSelectedOutputColumnCount());
+
+	std::vector<double> values(rows + 1, -1.0);
+	CVar v;
+	int copied = -1;
+	for (int c = 0; c < 3; ++c)
+	{
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputColumn(c, &values[0], rows, &copied));
+		ASSERT_EQ(rows, copied);
+		for (int r = 1; r <= rows; ++r)
+		{
+			ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, c, &v));
+			ASSERT_EQ(v.type == TT_LONG ? (double)v.lVal : v.dVal, values[r - 1]);
+		}
+		ASSERT_EQ(-1.0, values[rows]);
+	}
+
+	// string column
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputColumn(3, &values[0], rows + 1, &copied));
+	ASSERT_EQ(rows, copied);
+	ASSERT_EQ((double)1.0e30f, values[0]);
+	ASSERT_EQ(-1.0, values[rows]);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 3, &v));
+	ASSERT_EQ(TT_STRING, v.type);
+
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputColumn(0, &values[0], 2, NULL));
+	ASSERT_EQ(VR_INVALIDCOL, obj.GetSelectedOutputColumn(4, &values[0], rows, &copied));
+	ASSERT_EQ(VR_INVALIDCOL, obj.GetSelectedOutputColumn(-1, &values[0], rows, &copied));
+	ASSERT_EQ(VR_INVALIDARG, obj.GetSelectedOutputColumn(0, NULL, rows, &copied));
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputColumn(0, NULL, 0, &copied));
+	ASSERT_EQ(0, copied);
+}
+
+TEST(TestIPhreeqc, TestLogicalLines)
+{
+	// CR-LF line ends, ';' separators, '\\' continuations, comments and
+	// mixed-case keywords and options read the same as plain input
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(
+		"Selected_Output\r\n"
+		"  -Reset false ; -totals \\\r\n"
+		"      Na Cl # comment ; -pH true\r\n"
+		"solution 1 # comment\r\n"
+		"  pH 7;  Na 1;  Cl 1\r\n"
+		"END"));
+	ASSERT_EQ(2, obj.GetSelectedOutputRowCount());
+	ASSERT_EQ(2, obj.GetSelectedOutputColumnCount());
+
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(0, 0, &v));
+	ASSERT_STREQ("Na(mol/kgw)", v.sVal);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(0, 1, &v));
+	ASSERT_STREQ("Cl(mol/kgw)", v.sVal);
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 0, &v));
+	ASSERT_NEAR(1e-3, v.dVal, 1e-5);
+}
+
+class BarSeparator : public IPhreeqc
+{
+public:
+	virtual int getc(void)
+	{
+		// '|' separates logical lines like ';'
+		int c = this->IPhreeqc::getc();
+		return (c == '|') ? ';' : c;
+	}
+};
+
+TEST(TestIPhreeqc, TestLogicalLinesGetc)
+{
+	// input lines are read through the virtual getc
+	BarSeparator obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, obj.RunString(
+		"SELECTED_OUTPUT | -reset false | -totals Na\n"
+		"SOLUTION 1 | pH 7 | Na 1\n"
+		"END\n"));
+	ASSERT_EQ(2, obj.GetSelectedOutputRowCount());
+	ASSERT_EQ(1, obj.GetSelectedOutputColumnCount());
+}
+
+TEST(TestIPhreeqc, TestRunTemplate)
+{
+	const char input[] =
+		"SOLUTION_MASTER_SPECIES\n"
+		"  Xx Xx+2 0 Xx 50\n"
+		"SOLUTION_SPECIES\n"
+		"  Xx+2 = Xx+2\n"
+		"  log_k 0\n"
+		"PHASES\n"
+		"  Xxite; XxCO3 = Xx+2 + CO3-2; log_k {logk}\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -si Xxite\n"
+		"SOLUTION 1\n"
+		"  pH {ph}; temp {temp}; Ca 1; C 2; Xx 0.1\n"
+		"  # {not a slot}\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	int t = obj.CreateTemplate(input);
+	ASSERT_EQ(0, t);
+	ASSERT_EQ(3, obj.GetTemplateSlotCount(t));
+	ASSERT_STREQ("logk", obj.GetTemplateSlotName(t, 0));
+	ASSERT_STREQ("ph", obj.GetTemplateSlotName(t, 1));
+	ASSERT_STREQ("temp", obj.GetTemplateSlotName(t, 2));
+	ASSERT_STREQ("", obj.GetTemplateSlotName(t, 3));
+	ASSERT_EQ(-1, obj.GetTemplateSlotCount(1));
+	ASSERT_EQ(-1, obj.CreateTemplate(NULL));
+
+	// same results as running the filled-in input with RunString
+	IPhreeqc ref;
+	ASSERT_EQ(0, ref.LoadDatabase("phreeqc.dat"));
+	for (int i = 0; i < 3; ++i)
+	{
+		double values[3] = { -8.3 + 0.1 * i, 7.0 + 0.25 * i, 25.0 + 5.0 * i };
+		std::ostringstream oss;
+		oss.precision(17);
+		oss <<
+			"SOLUTION_MASTER_SPECIES\n"
+			"  Xx Xx+2 0 Xx 50\n"
+			"SOLUTION_SPECIES\n"
+			"  Xx+2 = Xx+2\n"
+			"  log_k 0\n"
+			"PHASES\n"
+			"  Xxite; XxCO3 = Xx+2 + CO3-2; log_k " << values[0] << "\n"
+			"SELECTED_OUTPUT\n"
+			"  -reset false; -pH true; -si Xxite\n"
+			"SOLUTION 1\n"
+			"  pH " << values[1] << "; temp " << values[2] << "; Ca 1; C 2; Xx 0.1\n"
+			"  # {not a slot}\n"
+			"END\n";
+		ASSERT_EQ(0, ref.RunString(oss.str().c_str()));
+		ASSERT_EQ(0, obj.RunTemplate(t, values));
+		ASSERT_EQ(ref.GetSelectedOutputRowCount(), obj.GetSelectedOutputRowCount());
+		ASSERT_EQ(2, obj.GetSelectedOutputColumnCount());
+		for (int c = 0; c < 2; ++c)
+		{
+			CVar v1, v2;
+			ASSERT_EQ(VR_OK, ref.GetSelectedOutputValue(1, c, &v1));
+			ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, c, &v2));
+			ASSERT_EQ(TT_DOUBLE, v2.type);
+			ASSERT_EQ(v1.dVal, v2.dVal);
+		}
+	}
+
+	ASSERT_EQ(1, obj.RunTemplate(t, NULL));
+	ASSERT_EQ(1, obj.RunTemplate(5, NULL));
+}
+
+TEST(TestIPhreeqc, TestRunTemplateRedefinition)
+{
+	// Xxite is redefined by the second simulation, so neither PHASES block
+	// may be left out of a rerun
+	const char input[] =
+		"SOLUTION_MASTER_SPECIES\n"
+		"  Xx Xx+2 0 Xx 50\n"
+		"SOLUTION_SPECIES\n"
+		"  Xx+2 = Xx+2\n"
+		"  log_k 0\n"
+		"PHASES\n"
+		"  Xxite; XxCO3 = Xx+2 + CO3-2; log_k -8.0\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -si Xxite\n"
+		"SOLUTION 1\n"
+		"  pH {ph}; Ca 1; C 2; Xx 0.1\n"
+		"END\n"
+		"PHASES\n"
+		"  Xxite; XxCO3 = Xx+2 + CO3-2; log_k -7.0\n"
+		"SOLUTION 2\n"
+		"  pH {ph}; Ca 1; C 2; Xx 0.1\n"
+		"END\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	int t = obj.CreateTemplate(input);
+	ASSERT_EQ(0, t);
+	ASSERT_EQ(1, obj.GetTemplateSlotCount(t));
+
+	for (int i = 0; i < 3; ++i)
+	{
+		double ph = 7.0 + 0.25 * i;
+		std::string filled(input);
+		std::ostringstream oss;
+		oss.precision(17);
+		oss << ph;
+		for (size_t pos; (pos = filled.find("{ph}")) != std::string::npos; )
+		{
+			filled.replace(pos, 4, oss.str());
+		}
+
+		// a fresh instance for each reference run
+		IPhreeqc ref;
+		ASSERT_EQ(0, ref.LoadDatabase("phreeqc.dat"));
+		ASSERT_EQ(0, ref.RunString(filled.c_str()));
+		ASSERT_EQ(0, obj.RunTemplate(t, &ph));
+		ASSERT_EQ(3, ref.GetSelectedOutputRowCount());
+		ASSERT_EQ(ref.GetSelectedOutputRowCount(), obj.GetSelectedOutputRowCount());
+		ASSERT_EQ(2, obj.GetSelectedOutputColumnCount());
+		for (int r = 1; r < 3; ++r)
+		{
+			for (int c = 0; c < 2; ++c)
+			{
+				CVar v1, v2;
+				ASSERT_EQ(VR_OK, ref.GetSelectedOutputValue(r, c, &v1));
+				ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, c, &v2));
+				ASSERT_EQ(TT_DOUBLE, v2.type);
+				ASSERT_EQ(v1.dVal, v2.dVal);
+			}
+		}
+	}
+}
+
+TEST(TestIPhreeqc, TestGetOutputLines)
+{
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	obj.SetOutputStringOn(true);
+	obj.SetSelectedOutputStringOn(true);
+
+	std::ostringstream input;
+	input << "SELECTED_OUTPUT\n";
+	input << "  -reset false; -pH true\n";
+	for (int i = 1; i <= 20; ++i)
+	{
+		input << "SOLUTION " << i << "\n";
+		input << "  pH " << 6 + 0.1 * i << "; Ca 1; C 2\n";
+	}
+	input << "END\n";
+
+	for (int run = 0; run < 2; ++run)
+	{
+		ASSERT_EQ(0, obj.RunString(input.str().c_str()));
+
+		std::vector< std::string > expected;
+		std::istringstream iss(obj.GetOutputString());
+		std::string line;
+		while (std::getline(iss, line))
+		{
+			expected.push_back(line);
+		}
+		ASSERT_EQ((int)expected.size(), obj.GetOutputStringLineCount());
+		ASSERT_TRUE(expected.size() > 500);
+
+		// read in blocks that do not divide the line count
+		std::vector< const char* > lines(97);
+		int start = 0;
+		int n;
+		while ((n = obj.GetOutputLines(start, (int)lines.size(), &lines[0])) > 0)
+		{
+			for (int i = 0; i < n; ++i)
+			{
+				ASSERT_EQ(expected[start + i], std::string(lines[i]));
+				ASSERT_EQ(lines[i], obj.GetOutputStringLine(start + i));
+			}
+			start += n;
+		}
+		ASSERT_EQ((int)expected.size(), start);
+		ASSERT_EQ(0, obj.GetOutputLines(-1, 10, &lines[0]));
+		ASSERT_EQ(std::string(""), obj.GetOutputStringLine((int)expected.size()));
+
+		// selected output lines are not carried over from the previous run
+		ASSERT_EQ(21, obj.GetSelectedOutputStringLineCount());
+		ASSERT_TRUE(::strstr(obj.GetSelectedOutputStringLine(0), "pH") != NULL);
+	}
+}
+
+TEST(TestIPhreeqc, TestSaveLoadState)
+{
+	const char setup[] =
+		"SOLUTION 1-3\n"
+		"  pH 7; Ca 1; Na 2; Cl 2; C 3\n"
+		"EXCHANGE 1-3\n"
+		"  X 0.01; -equilibrate 1\n"
+		"EQUILIBRIUM_PHASES 1-3\n"
+		"  Calcite 0 0.1\n"
+		"  CO2(g) -2 1\n"
+		"GAS_PHASE 2\n"
+		"  -fixed_volume; CO2(g) 0.01\n"
+		"SAVE solution 1-3\n"
+		"END\n";
+	const char run[] =
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -totals Ca Na C; -molalities NaX CaX2\n"
+		"RUN_CELLS\n"
+		"  -cells 1-3\n"
+		"END\n";
+	const char filename[] = "TestSaveLoadState.bin";
+
+	IPhreeqc src;
+	ASSERT_EQ(0, src.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, src.RunString(setup));
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 3));
+	ASSERT_TRUE(src.GetStateBufferSize() > 0);
+	std::string buffer((const char*)src.GetStateBuffer(), src.GetStateBufferSize());
+
+	FileTest file(filename);
+	ASSERT_TRUE(file.RemoveExisting());
+	ASSERT_EQ(0, src.SaveState(1, 3, filename));
+	ASSERT_TRUE(file.VerifyExists());
+	ASSERT_EQ(buffer.size(), file.Size());
+
+	ASSERT_EQ(0, src.RunString(run));
+
+	for (int i = 0; i < 2; ++i)
+	{
+		IPhreeqc dst;
+		ASSERT_EQ(0, dst.LoadDatabase("phreeqc.dat"));
+		if (i == 0)
+		{
+			ASSERT_EQ(0, dst.LoadStateBuffer(buffer.c_str(), (int)buffer.size()));
+		}
+		else
+		{
+			ASSERT_EQ(0, dst.LoadState(filename));
+		}
+		ASSERT_EQ(0, dst.RunString(run));
+
+		ASSERT_EQ(4, dst.GetSelectedOutputRowCount());
+		ASSERT_EQ(src.GetSelectedOutputColumnCount(), dst.GetSelectedOutputColumnCount());
+		for (int r = 1; r < src.GetSelectedOutputRowCount(); ++r)
+		{
+			for (int c = 0; c < src.GetSelectedOutputColumnCount(); ++c)
+			{
+				CVar v1, v2;
+				ASSERT_EQ(VR_OK, src.GetSelectedOutputValue(r, c, &v1));
+				ASSERT_EQ(VR_OK, dst.GetSelectedOutputValue(r, c, &v2));
+				ASSERT_EQ(TT_DOUBLE, v2.type);
+				ASSERT_NEAR(v1.dVal, v2.dVal, ::fabs(v1.dVal) * 1e-12);
+			}
+		}
+	}
+	ASSERT_TRUE(file.RemoveExisting());
+
+	// damaged snapshot
+	IPhreeqc bad;
+	ASSERT_EQ(0, bad.LoadDatabase("phreeqc.dat"));
+	std::string damaged(buffer);
+	damaged[damaged.size() / 2] ^= 0x10;
+	ASSERT_EQ(1, bad.LoadStateBuffer(damaged.c_str(), (int)damaged.size()));
+	ASSERT_TRUE(::strstr(bad.GetErrorString(), "corrupt") != NULL);
+	ASSERT_EQ(1, bad.LoadStateBuffer(buffer.c_str(), (int)buffer.size() - 1));
+
+	// snapshot from another database
+	IPhreeqc other;
+	ASSERT_EQ(0, other.LoadDatabase("llnl.dat"));
+	ASSERT_EQ(1, other.LoadStateBuffer(buffer.c_str(), (int)buffer.size()));
+	ASSERT_TRUE(::strstr(other.GetErrorString(), "different database") != NULL);
+}
+
+static void rehash_snapshot(std::string& snapshot)
+{
+	// FNV-1a trailer over all preceding bytes
+	unsigned long long h = 14695981039346656037ULL;
+	size_t n = snapshot.size() - sizeof(h);
+	for (size_t i = 0; i < n; ++i)
+	{
+		h ^= (unsigned char)snapshot[i];
+		h *= 1099511628211ULL;
+	}
+	::memcpy(&snapshot[n], &h, sizeof(h));
+}
+
+TEST(TestIPhreeqc, TestLoadStateModel)
+{
+	const char setup[] =
+		"SOLUTION_MASTER_SPECIES\n"
+		"  %s %s+ 0 %s 10\n"
+		"SOLUTION_SPECIES\n"
+		"  %s+ = %s+\n"
+		"  log_k 0\n"
+		"SOLUTION 1\n"
+		"  pH 7; Na 1; Cl 1\n"
+		"END\n";
+	char input[512];
+
+	IPhreeqc src;
+	ASSERT_EQ(0, src.LoadDatabase("phreeqc.dat"));
+	::sprintf(input, setup, "Aa", "Aa", "Aa", "Aa", "Aa");
+	ASSERT_EQ(0, src.RunString(input));
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 1));
+	std::string buffer((const char*)src.GetStateBuffer(), src.GetStateBufferSize());
+
+	// same species and master species counts, different names
+	IPhreeqc other;
+	ASSERT_EQ(0, other.LoadDatabase("phreeqc.dat"));
+	::sprintf(input, setup, "Bb", "Bb", "Bb", "Bb", "Bb");
+	ASSERT_EQ(0, other.RunString(input));
+	ASSERT_EQ(1, other.LoadStateBuffer(buffer.c_str(), (int)buffer.size()));
+	ASSERT_TRUE(::strstr(other.GetErrorString(), "different database") != NULL);
+
+	IPhreeqc same;
+	ASSERT_EQ(0, same.LoadDatabase("phreeqc.dat"));
+	::sprintf(input, setup, "Aa", "Aa", "Aa", "Aa", "Aa");
+	ASSERT_EQ(0, same.RunString(input));
+	ASSERT_EQ(0, same.LoadStateBuffer(buffer.c_str(), (int)buffer.size()));
+
+	// well-formed snapshot that does not unpack: the first packed int is the entity type
+	size_t pos = 4 + 2 * sizeof(unsigned int) + sizeof(unsigned long long);
+	unsigned int nwords;
+	::memcpy(&nwords, &buffer[pos], sizeof(nwords));
+	pos += sizeof(nwords);
+	for (unsigned int i = 0; i < nwords; ++i)
+	{
+		unsigned int len;
+		::memcpy(&len, &buffer[pos], sizeof(len));
+		pos += sizeof(len) + len;
+	}
+	pos += sizeof(unsigned long long);
+	int type = 99;
+	::memcpy(&buffer[pos], &type, sizeof(type));
+	rehash_snapshot(buffer);
+	ASSERT_EQ(1, same.LoadStateBuffer(buffer.c_str(), (int)buffer.size()));
+	ASSERT_TRUE(::strstr(same.GetErrorString(), "could not be unpacked") != NULL);
+	ASSERT_EQ(0, same.RunString("SOLUTION 2\nEND\n"));
+}
+
+static int count_substr(const char* str, const char* sub)
+{
+	int n = 0;
+	for (const char* p = ::strstr(str, sub); p; p = ::strstr(p + 1, sub))
+	{
+		++n;
+	}
+	return n;
+}
+
+TEST(TestIPhreeqc, TestDeltaExport)
+{
+	const char setup[] =
+		"SOLUTION 1-5\n"
+		"  pH 7; Ca 1; Na 2; Cl 2; C 3\n"
+		"EQUILIBRIUM_PHASES 1-5\n"
+		"  Calcite 0 0.1\n"
+		"  CO2(g) -2 1\n"
+		"SAVE solution 1-5\n"
+		"END\n";
+	const char run[] =
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -totals Ca Na C\n"
+		"RUN_CELLS\n"
+		"  -cells 1-3 5\n"
+		"END\n";
+
+	IPhreeqc src;
+	ASSERT_EQ(0, src.LoadDatabase("phreeqc.dat"));
+	ASSERT_FALSE(src.GetDeltaExportOn());
+	src.SetDeltaExportOn(true);
+	ASSERT_TRUE(src.GetDeltaExportOn());
+	ASSERT_EQ(0, src.RunString(setup));
+
+	// the first export has every entity
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 5));
+	std::string base((const char*)src.GetStateBuffer(), src.GetStateBufferSize());
+
+	// only cell 2 changes
+	ASSERT_EQ(0, src.RunString("RUN_CELLS\n  -cells 2\nEND\n"));
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 5));
+	std::string delta((const char*)src.GetStateBuffer(), src.GetStateBufferSize());
+	ASSERT_TRUE(delta.size() * 4 < base.size());
+
+	// nothing changed since
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 5));
+	ASSERT_TRUE(src.GetStateBufferSize() < (int)delta.size());
+
+	// deletions are exported
+	ASSERT_EQ(0, src.RunString("DELETE\n  -cells 4\nEND\n"));
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 5));
+	std::string deleted((const char*)src.GetStateBuffer(), src.GetStateBufferSize());
+
+	IPhreeqc dst;
+	ASSERT_EQ(0, dst.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, dst.LoadStateBuffer(base.c_str(), (int)base.size()));
+	ASSERT_EQ(0, dst.LoadStateBuffer(delta.c_str(), (int)delta.size()));
+	ASSERT_EQ(0, dst.LoadStateBuffer(deleted.c_str(), (int)deleted.size()));
+
+	ASSERT_EQ(0, src.RunString(run));
+	ASSERT_EQ(0, dst.RunString(run));
+	ASSERT_EQ(5, dst.GetSelectedOutputRowCount());
+	ASSERT_EQ(src.GetSelectedOutputColumnCount(), dst.GetSelectedOutputColumnCount());
+	for (int r = 1; r < src.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < src.GetSelectedOutputColumnCount(); ++c)
+		{
+			CVar v1, v2;
+			ASSERT_EQ(VR_OK, src.GetSelectedOutputValue(r, c, &v1));
+			ASSERT_EQ(VR_OK, dst.GetSelectedOutputValue(r, c, &v2));
+			ASSERT_EQ(TT_DOUBLE, v2.type);
+			ASSERT_NEAR(v1.dVal, v2.dVal, ::fabs(v1.dVal) * 1e-12);
+		}
+	}
+
+	// DUMP writes only the changed cells
+	dst.SetDumpStringOn(true);
+	ASSERT_EQ(0, dst.RunString("DUMP\n  -solution 1-5\nEND\n"));
+	ASSERT_EQ(4, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+	dst.SetDeltaExportOn(true);
+	ASSERT_EQ(0, dst.RunString("DUMP\n  -solution 1-5\nEND\n"));
+	ASSERT_EQ(4, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+	ASSERT_EQ(0, dst.RunString("RUN_CELLS\n  -cells 3\nDUMP\n  -solution 1-5\nEND\n"));
+	ASSERT_EQ(1, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+	ASSERT_EQ(0, dst.RunString("DUMP\n  -solution 1-5\nEND\n"));
+	ASSERT_EQ(0, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+
+	// changes are not tracked while delta export is off
+	dst.SetDeltaExportOn(false);
+	ASSERT_EQ(0, dst.RunString("RUN_CELLS\n  -cells 3\nEND\n"));
+	dst.SetDeltaExportOn(true);
+	ASSERT_EQ(0, dst.RunString("DUMP\n  -solution 1-5\nEND\n"));
+	ASSERT_EQ(4, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+}
+
+TEST(TestIPhreeqc, TestEntityBlobs)
+{
+	const char setup[] =
+		"SOLUTION 1\n"
+		"  pH 7; Ca 1; Na 2; Cl 2; C 3; Fe 0.01\n"
+		"EXCHANGE 1\n"
+		"  X 0.01; -equilibrate 1\n"
+		"SURFACE 1\n"
+		"  Hfo_wOH 0.001 600 1; -equilibrate 1\n"
+		"EQUILIBRIUM_PHASES 1\n"
+		"  Calcite 0 0.1\n"
+		"GAS_PHASE 1\n"
+		"  -fixed_volume; CO2(g) 0.01\n"
+		"END\n";
+	const char run[] =
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -totals Ca Na C; -molalities NaX CaX2 Hfo_wOH\n"
+		"RUN_CELLS\n"
+		"  -cells %d\n"
+		"END\n";
+
+	IPhreeqc src;
+	ASSERT_EQ(0, src.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, src.RunString(setup));
+
+	IPhreeqc dst;
+	ASSERT_EQ(0, dst.LoadDatabase("phreeqc.dat"));
+
+	int size = 0;
+	const void* blob = src.GetSolutionBlob(1, &size);
+	ASSERT_TRUE(blob != NULL);
+	ASSERT_TRUE(size > 0);
+	ASSERT_EQ(0, dst.SetSolutionBlob(7, blob, size));
+
+	// the wrong kind of entity
+	ASSERT_EQ(1, dst.SetExchangeBlob(7, blob, size));
+	ASSERT_TRUE(::strstr(dst.GetErrorString(), "different kind") != NULL);
+
+	// a state snapshot is not an entity blob
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 1));
+	ASSERT_EQ(1, dst.SetSolutionBlob(8, src.GetStateBuffer(), src.GetStateBufferSize()));
+	ASSERT_TRUE(::strstr(dst.GetErrorString(), "more than one entity") != NULL);
+	src.SetDeltaExportOn(true);
+	ASSERT_EQ(0, src.SaveStateBuffer(1, 1));
+	ASSERT_EQ(1, dst.SetSolutionBlob(8, src.GetStateBuffer(), src.GetStateBufferSize()));
+	ASSERT_TRUE(::strstr(dst.GetErrorString(), "not a single entity") != NULL);
+	src.SetDeltaExportOn(false);
+	dst.SetDumpStringOn(true);
+	ASSERT_EQ(0, dst.RunString("DUMP\n  -solution 7-8\nEND\n"));
+	ASSERT_EQ(1, count_substr(dst.GetDumpString(), "SOLUTION_RAW"));
+	dst.SetDumpStringOn(false);
+
+	blob = src.GetExchangeBlob(1, &size);
+	ASSERT_EQ(0, dst.SetExchangeBlob(7, blob, size));
+	blob = src.GetSurfaceBlob(1, &size);
+	ASSERT_EQ(0, dst.SetSurfaceBlob(7, blob, size));
+	blob = src.GetEquilibriumPhasesBlob(1, &size);
+	ASSERT_EQ(0, dst.SetEquilibriumPhasesBlob(7, blob, size));
+	blob = src.GetGasPhaseBlob(1, &size);
+	ASSERT_EQ(0, dst.SetGasPhaseBlob(7, blob, size));
+
+	ASSERT_TRUE(src.GetKineticsBlob(1, &size) == NULL);
+	ASSERT_EQ(0, size);
+	ASSERT_TRUE(::strstr(src.GetErrorString(), "not found") != NULL);
+
+	char buffer[200];
+	::sprintf(buffer, run, 1);
+	ASSERT_EQ(0, src.RunString(buffer));
+	::sprintf(buffer, run, 7);
+	ASSERT_EQ(0, dst.RunString(buffer));
+
+	ASSERT_EQ(2, dst.GetSelectedOutputRowCount());
+	ASSERT_EQ(src.GetSelectedOutputColumnCount(), dst.GetSelectedOutputColumnCount());
+	for (int c = 0; c < src.GetSelectedOutputColumnCount(); ++c)
+	{
+		CVar v1, v2;
+		ASSERT_EQ(VR_OK, src.GetSelectedOutputValue(1, c, &v1));
+		ASSERT_EQ(VR_OK, dst.GetSelectedOutputValue(1, c, &v2));
+		ASSERT_EQ(TT_DOUBLE, v2.type);
+		ASSERT_NEAR(v1.dVal, v2.dVal, ::fabs(v1.dVal) * 1e-12);
+	}
+}
+
+TEST(TestIPhreeqc, TestRegisterVirtualFile)
+{
+	std::ifstream ifs("phreeqc.dat");
+	ASSERT_TRUE(ifs.is_open());
+	std::string db((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+	const char include[] =
+		"SOLUTION 1\n"
+		"  pH 7; Na 1; Cl 1\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(VR_INVALIDARG, obj.RegisterVirtualFile(NULL, include, -1));
+	ASSERT_EQ(VR_INVALIDARG, obj.RegisterVirtualFile("", include, -1));
+
+	// neither file exists on disk
+	ASSERT_FALSE(::FileExists("virtual.dat"));
+	ASSERT_FALSE(::FileExists("virtual.inc"));
+	ASSERT_EQ(VR_OK, obj.RegisterVirtualFile("virtual.dat", db.c_str(), (int)db.size()));
+	ASSERT_EQ(VR_OK, obj.RegisterVirtualFile("virtual.inc", include, -1));
+
+	ASSERT_EQ(0, obj.LoadDatabase("virtual.dat"));
+	for (int i = 0; i < 2; ++i)
+	{
+		ASSERT_EQ(0, obj.RunString(
+			"INCLUDE$ virtual.inc\n"
+			"SELECTED_OUTPUT\n"
+			"  -reset false; -totals Na\n"
+			"END\n"));
+		ASSERT_EQ(2, obj.GetSelectedOutputRowCount());
+		CVar v;
+		ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 0, &v));
+		ASSERT_EQ(TT_DOUBLE, v.type);
+		ASSERT_NEAR(1e-3, v.dVal, 1e-6);
+	}
+
+	ASSERT_EQ(VR_OK, obj.RegisterVirtualFile("virtual.dat", NULL, 0));
+	ASSERT_TRUE(obj.LoadDatabase("virtual.dat") > 0);
+}
+
+class ReRegisterInclude : public IPhreeqc
+{
+public:
+	virtual std::istream * open_include(const char *file_name)
+	{
+		// replace the file while its stream is open
+		std::istream* is = this->IPhreeqc::open_include(file_name);
+		std::string replacement(4096, '#');
+		this->RegisterVirtualFile(file_name, replacement.c_str(), (int)replacement.size());
+		return is;
+	}
+};
+
+TEST(TestIPhreeqc, TestRegisterVirtualFileWhileOpen)
+{
+	std::string include(
+		"SOLUTION 1\n"
+		"  pH 7; Na 1; Cl 1\n");
+	include.append(1000, ' ');
+	include.append("\n");
+
+	ReRegisterInclude obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(VR_OK, obj.RegisterVirtualFile("virtual.inc", include.c_str(), (int)include.size()));
+	ASSERT_EQ(0, obj.RunString(
+		"INCLUDE$ virtual.inc\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -totals Na\n"
+		"END\n"));
+	ASSERT_EQ(2, obj.GetSelectedOutputRowCount());
+	CVar v;
+	ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(1, 0, &v));
+	ASSERT_EQ(TT_DOUBLE, v.type);
+	ASSERT_NEAR(1e-3, v.dVal, 1e-6);
+}
+
+class DiscardOutput : public IPhreeqc
+{
+public:
+	virtual void output_msg(const char *str)
+	{
+		this->received += str;
+	}
+	virtual bool output_active(void)
+	{
+		return false;
+	}
+	std::string received;
+};
+
+TEST(TestIPhreeqc, TestDiscardedOutputNotFormatted)
+{
+	const char input[] =
+		"SELECTED_OUTPUT\n"
+		"  -reset false; -pH true; -si Calcite Dolomite\n"
+		"SOLUTION 1\n"
+		"  pH 7; Ca 1; Mg 0.5; C 2; Na 1; Cl 1\n"
+		"EQUILIBRIUM_PHASES 1\n"
+		"  Calcite 0 10\n"
+		"EXCHANGE 1\n"
+		"  X 0.01; -equilibrate 1\n"
+		"END\n";
+
+	IPhreeqc ref;
+	ASSERT_EQ(0, ref.LoadDatabase("phreeqc.dat"));
+	ref.SetOutputStringOn(true);
+	ASSERT_EQ(0, ref.RunString(input));
+	ASSERT_TRUE(::strstr(ref.GetOutputString(), "Saturation indices") != NULL);
+
+	// output is enabled for the run but the sink takes nothing
+	DiscardOutput obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	obj.SetOutputStringOn(true);
+	obj.received.clear();
+	ASSERT_EQ(0, obj.RunString(input));
+	ASSERT_TRUE(obj.received.find("Saturation indices") == std::string::npos);
+
+	ASSERT_EQ(ref.GetSelectedOutputRowCount(), obj.GetSelectedOutputRowCount());
+	ASSERT_EQ(ref.GetSelectedOutputColumnCount(), obj.GetSelectedOutputColumnCount());
+	for (int r = 1; r < ref.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < ref.GetSelectedOutputColumnCount(); ++c)
+		{
+			CVar v1, v2;
+			ASSERT_EQ(VR_OK, ref.GetSelectedOutputValue(r, c, &v1));
+			ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, c, &v2));
+			ASSERT_EQ(v1.type, v2.type);
+			ASSERT_EQ(v1.dVal, v2.dVal);
+		}
+	}
+}
+
+TEST(TestIPhreeqc, TestSelectedOutputBinaryFile)
+{
+	const char BIN_FILENAME[] = "TestSelectedOutputBinaryFile.bin";
+	const char TXT_FILENAME[] = "TestSelectedOutputBinaryFile.txt";
+	if (::FileExists(BIN_FILENAME))
+	{
+		::DeleteFile(BIN_FILENAME);
+	}
+	if (::FileExists(TXT_FILENAME))
+	{
+		::DeleteFile(TXT_FILENAME);
+	}
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+	ASSERT_STREQ("", obj.GetSelectedOutputBinaryFileName());
+	obj.SetSelectedOutputBinaryFileName(BIN_FILENAME);
+	ASSERT_STREQ(BIN_FILENAME, obj.GetSelectedOutputBinaryFileName());
+
+	// more rows than fit in a single row group
+	ASSERT_EQ(0, obj.RunString(
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -step true\n"
+		"  -distance true\n"
+		"  -totals Na Cl\n"
+		"USER_PUNCH\n"
+		"  -headings desc\n"
+		"  10 PUNCH DESCRIPTION\n"
+		"SOLUTION 0\n"
+		"  Na 1; Cl 1\n"
+		"SOLUTION 1-60\n"
+		"END\n"
+		"TRANSPORT\n"
+		"  -cells 60\n"
+		"  -shifts 80\n"
+		"END\n"));
+	ASSERT_EQ(true, ::FileExists(BIN_FILENAME));
+
+	int rows = obj.GetSelectedOutputRowCount();
+	int cols = obj.GetSelectedOutputColumnCount();
+	ASSERT_TRUE(rows > 4096);
+	ASSERT_EQ(5, cols);
+	std::vector<CVar> expected(rows * cols);
+	for (int r = 0; r < rows; ++r)
+	{
+		for (int c = 0; c < cols; ++c)
+		{
+			ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, c, &expected[r * cols + c]));
+		}
+	}
+
+	ASSERT_EQ(0, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	ASSERT_EQ(rows, obj.GetSelectedOutputRowCount());
+	ASSERT_EQ(cols, obj.GetSelectedOutputColumnCount());
+	CVar v;
+	for (int r = 0; r < rows; ++r)
+	{
+		for (int c = 0; c < cols; ++c)
+		{
+			const CVar &e = expected[r * cols + c];
+			ASSERT_EQ(VR_OK, obj.GetSelectedOutputValue(r, c, &v));
+			ASSERT_EQ(e.type, v.type);
+			switch (e.type)
+			{
+			case TT_DOUBLE: ASSERT_EQ(e.dVal, v.dVal); break;
+			case TT_LONG:   ASSERT_EQ(e.lVal, v.lVal); break;
+			case TT_STRING: ASSERT_STREQ(e.sVal, v.sVal); break;
+			default: break;
+			}
+		}
+	}
+
+	ASSERT_EQ(0, obj.ConvertSelectedOutputBinaryFile(BIN_FILENAME, TXT_FILENAME));
+	std::ifstream ifs(TXT_FILENAME);
+	std::string line;
+	int lines = 0;
+	while (std::getline(ifs, line))
+	{
+		++lines;
+	}
+	ASSERT_EQ(rows, lines);
+	ifs.close();
+
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile("missing.file"));
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(TXT_FILENAME));
+	ASSERT_EQ(1, obj.ConvertSelectedOutputBinaryFile("missing.file", TXT_FILENAME));
+
+	obj.SetSelectedOutputBinaryFileName(NULL);
+	ASSERT_STREQ("", obj.GetSelectedOutputBinaryFileName());
+
+	::DeleteFile(BIN_FILENAME);
+	::DeleteFile(TXT_FILENAME);
+}
+
+template <typename T>
+static void put_bin(std::ofstream &ofs, T value)
+{
+	ofs.write((const char *) &value, sizeof(T));
+}
+
+// one column "x", one plain row group of nrows rows with the given type byte; the footer claims footer_rows rows
+static void write_selected_output_bin(const char *filename, unsigned char type, unsigned char has_longs,
+	unsigned int nrows, unsigned long long footer_rows, unsigned char footer_type)
+{
+	std::ofstream ofs(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	ofs.write("PQSO", 4);
+	put_bin(ofs, (unsigned int) 1);
+	put_bin(ofs, (unsigned int) 0x01020304);
+
+	unsigned long long group = (unsigned long long) ofs.tellp();
+	ofs.write("PQRG", 4);
+	put_bin(ofs, nrows);
+	put_bin(ofs, (unsigned int) 1);
+	put_bin(ofs, (unsigned int) 0);
+	put_bin(ofs, (unsigned char) 0);
+	put_bin(ofs, (unsigned long long) (nrows + 8 * nrows + 1 + (has_longs ? 8 * nrows : 0)));
+	for (unsigned int i = 0; i < nrows; ++i) put_bin(ofs, type);
+	for (unsigned int i = 0; i < nrows; ++i) put_bin(ofs, (double) i);
+	put_bin(ofs, has_longs);
+	for (unsigned int i = 0; has_longs && i < nrows; ++i) put_bin(ofs, (long long) i);
+
+	unsigned long long footer = (unsigned long long) ofs.tellp();
+	ofs.write("PQFT", 4);
+	put_bin(ofs, (unsigned int) 1);
+	put_bin(ofs, (unsigned int) 1);
+	ofs.write("x", 1);
+	put_bin(ofs, footer_type);
+	put_bin(ofs, (unsigned int) 1);
+	put_bin(ofs, group);
+	put_bin(ofs, footer_rows);
+	put_bin(ofs, footer);
+	ofs.write("PQSO", 4);
+}
+
+TEST(TestIPhreeqc, TestSelectedOutputBinaryFileCorrupt)
+{
+	const char BIN_FILENAME[] = "TestSelectedOutputBinaryFileCorrupt.bin";
+	const char TXT_FILENAME[] = "TestSelectedOutputBinaryFileCorrupt.txt";
+	const unsigned char MIXED = 0xFF;
+	IPhreeqc obj;
+
+	write_selected_output_bin(BIN_FILENAME, TT_DOUBLE, 0, 2, 2, TT_DOUBLE);
+	ASSERT_EQ(0, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	ASSERT_EQ(3, obj.GetSelectedOutputRowCount());
+	write_selected_output_bin(BIN_FILENAME, TT_LONG, 1, 2, 2, MIXED);
+	ASSERT_EQ(0, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+
+	// longs without the longs flag
+	write_selected_output_bin(BIN_FILENAME, TT_LONG, 0, 2, 2, MIXED);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Corrupt column types.") != NULL);
+	write_selected_output_bin(BIN_FILENAME, TT_STRING, 0, 2, 2, MIXED);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+
+	// unknown type, bad longs flag and a type that is not the footer's
+	write_selected_output_bin(BIN_FILENAME, 9, 0, 2, 2, MIXED);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	write_selected_output_bin(BIN_FILENAME, TT_DOUBLE, 2, 2, 2, MIXED);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	write_selected_output_bin(BIN_FILENAME, TT_LONG, 1, 2, 2, TT_DOUBLE);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+
+	// row group larger than the footer row count
+	write_selected_output_bin(BIN_FILENAME, TT_DOUBLE, 0, 3, 2, TT_DOUBLE);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Corrupt row group.") != NULL);
+	write_selected_output_bin(BIN_FILENAME, TT_DOUBLE, 0, 1, 2, TT_DOUBLE);
+	ASSERT_EQ(1, obj.LoadSelectedOutputBinaryFile(BIN_FILENAME));
+
+	// the last good load is kept
+	ASSERT_EQ(3, obj.GetSelectedOutputRowCount());
+
+	// the converter reads the same way, one row group at a time
+	ASSERT_EQ(1, obj.ConvertSelectedOutputBinaryFile(BIN_FILENAME, TXT_FILENAME));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Row count does not match footer.") != NULL);
+	write_selected_output_bin(BIN_FILENAME, TT_LONG, 0, 2, 2, MIXED);
+	ASSERT_EQ(1, obj.ConvertSelectedOutputBinaryFile(BIN_FILENAME, TXT_FILENAME));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Corrupt column types.") != NULL);
+	write_selected_output_bin(BIN_FILENAME, TT_DOUBLE, 0, 2, 2, TT_DOUBLE);
+	ASSERT_EQ(0, obj.ConvertSelectedOutputBinaryFile(BIN_FILENAME, TXT_FILENAME));
+
+	::DeleteFile(BIN_FILENAME);
+	::DeleteFile(TXT_FILENAME);
+}
+
+TEST(TestIPhreeqc, TestSelectedOutputFileErrors)
+{
+	const char INPUT[] =
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -totals Na\n"
+		"SOLUTION 1\n"
+		"  Na 1\n"
+		"END\n";
+
+	IPhreeqc obj;
+	ASSERT_EQ(0, obj.LoadDatabase("phreeqc.dat"));
+
+	// binary file that cannot be opened
+	obj.SetSelectedOutputBinaryFileName("no_such_dir/TestSelectedOutputFileErrors.bin");
+	ASSERT_EQ(1, obj.RunString(INPUT));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Unable to open:") != NULL);
+	obj.SetSelectedOutputBinaryFileName("");
+	ASSERT_EQ(0, obj.RunString(INPUT));
+
+	// text file that cannot be opened
+	obj.SetSelectedOutputFileOn(true);
+	obj.SetSelectedOutputFileName("no_such_dir/TestSelectedOutputFileErrors.sel");
+	ASSERT_EQ(1, obj.RunString(INPUT));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Unable to open:") != NULL);
+	obj.SetSelectedOutputFileOn(false);
+
+#if defined(__linux__)
+	// files that open but cannot be written
+	obj.SetSelectedOutputBinaryFileName("/dev/full");
+	ASSERT_EQ(1, obj.RunString(INPUT));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Unable to write:") != NULL);
+	obj.SetSelectedOutputBinaryFileName("");
+
+	obj.SetSelectedOutputFileOn(true);
+	obj.SetSelectedOutputFileName("/dev/full");
+	ASSERT_EQ(1, obj.RunString(INPUT));
+	ASSERT_TRUE(::strstr(obj.GetErrorString(), "Unable to write:") != NULL);
+#endif
+}
+
+TEST(TestIPhreeqc, TestModelCache)
+{
+	const char input[] =
+		"SOLUTION 1\n"
+		"  pH 7.2; Na 2; Cl 2; Ca 1; C 3 charge\n"
+		"SOLUTION 2\n"
+		"  pH 6.8; Na 1; Cl 1; Ca 2; C 4 charge\n"
+		"SOLUTION 3\n"
+		"  pH 6.5; redox Fe(2)/Fe(3); Fe(2) 0.1; Fe(3) 0.01; Cl 1 charge\n"
+		"EQUILIBRIUM_PHASES 1-2\n"
+		"  Calcite 0 0\n"
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -pH true\n"
+		"  -pe true\n"
+		"  -totals Ca Fe\n"
+		"END\n";
+
+	IPhreeqc cached;
+	ASSERT_EQ(0, cached.LoadDatabase("phreeqc.dat"));
+	ASSERT_EQ(0, cached.RunString(input));
+	int hits = cached.GetModelCacheHits();
+	ASSERT_GT(cached.GetModelCacheMisses(), 0);
+
+	// same waters in a new run reuse the models built by the first run
+	ASSERT_EQ(0, cached.RunString(input));
+	ASSERT_GT(cached.GetModelCacheHits(), hits);
+
+	IPhreeqc uncached;
+	ASSERT_EQ(0, uncached.LoadDatabase("phreeqc.dat"));
+	hits = uncached.GetModelCacheHits();
+	int misses = uncached.GetModelCacheMisses();
+	std::string uncached_input("KNOBS\n  -model_cache_size 0\n");
+	uncached_input += input;
+	ASSERT_EQ(0, uncached.RunString(uncached_input.c_str()));
+	ASSERT_EQ(0, uncached.RunString(input));
+	ASSERT_EQ(hits, uncached.GetModelCacheHits());
+	ASSERT_EQ(misses, uncached.GetModelCacheMisses());
+
+	ASSERT_EQ(cached.GetSelectedOutputRowCount(), uncached.GetSelectedOutputRowCount());
+	for (int r = 1; r < cached.GetSelectedOutputRowCount(); ++r)
+	{
+		for (int c = 0; c < cached.GetSelectedOutputColumnCount(); ++c)
+		{
+			CVar vc, vu;
+			ASSERT_EQ(VR_OK, cached.GetSelectedOutputValue(r, c, &vc));
+			ASSERT_EQ(VR_OK, uncached.GetSelectedOutputValue(r, c, &vu));
+			ASSERT_EQ(vu.dVal, vc.dVal);
+		}
+	}
+}
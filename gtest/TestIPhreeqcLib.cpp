@@ -1229,6 +1229,40 @@ TEST(TestIPhreeqcLib, TestGetSelectedOutputColumnCount)
 	}
 }
 
+TEST(TestIPhreeqcLib, TestGetSelectedOutputColumn)
+{
+	int n = ::CreateIPhreeqc();
+	ASSERT_TRUE(n >= 0);
+
+	ASSERT_EQ(0, ::LoadDatabase(n, "phreeqc.dat"));
+	ASSERT_EQ(0, ::RunString(n,
+		"SELECTED_OUTPUT\n"
+		"  -reset false\n"
+		"  -pH true\n"
+		"SOLUTION 1\n"
+		"  pH 7\n"
+		"SOLUTION 2\n"
+		"  pH 8\n"
+		"END\n"));
+
+	double values[4] = { -1.0, -1.0, -1.0, -1.0 };
+	int rows = -1;
+	ASSERT_EQ(IPQ_OK, ::GetSelectedOutputColumn(n, 0, values, 4, &rows));
+	ASSERT_EQ(::GetSelectedOutputRowCount(n) - 1, rows);
+	ASSERT_EQ(2, rows);
+	ASSERT_EQ(7.0, values[0]);
+	ASSERT_EQ(8.0, values[1]);
+	ASSERT_EQ(-1.0, values[2]);
+	ASSERT_EQ(IPQ_OK, ::GetSelectedOutputColumn(n, 0, values, 1, NULL));
+	ASSERT_EQ(IPQ_INVALIDCOL, ::GetSelectedOutputColumn(n, 1, values, 4, &rows));
+	ASSERT_EQ(IPQ_BADINSTANCE, ::GetSelectedOutputColumn(-1, 0, values, 4, &rows));
+
+	if (n >= 0)
+	{
+		ASSERT_EQ(IPQ_OK, ::DestroyIPhreeqc(n));
+	}
+}
+
 TEST(TestIPhreeqcLib, TestAddError)
 {
 	int n = ::CreateIPhreeqc();
@@ -667,3 +667,53 @@ TEST(TestSelectedOutput, TestLongHeadings)
 	CVar v1 = co.Get(1, 0);
 	ASSERT_EQ(TT_EMPTY, v1.type);
 }
+
+TEST(TestSelectedOutput, TestColumnOrderChanges)
+{
+	CSelectedOutput co;
+
+	// first row defines the columns
+	ASSERT_EQ(0, co.PushBackLong("a", 1));
+	ASSERT_EQ(0, co.PushBackLong("b", 2));
+	ASSERT_EQ(0, co.PushBackLong("c", 3));
+	ASSERT_EQ(0, co.EndRow());
+
+	// same order
+	ASSERT_EQ(0, co.PushBackLong("a", 4));
+	ASSERT_EQ(0, co.PushBackLong("b", 5));
+	ASSERT_EQ(0, co.PushBackLong("c", 6));
+	ASSERT_EQ(0, co.EndRow());
+
+	// different order, a skipped column and a new column
+	ASSERT_EQ(0, co.PushBackLong("c", 9));
+	ASSERT_EQ(0, co.PushBackLong("a", 7));
+	ASSERT_EQ(0, co.PushBackLong("d", 10));
+	ASSERT_EQ(0, co.EndRow());
+
+	// a value punched twice replaces the first
+	ASSERT_EQ(0, co.PushBackLong("b", 11));
+	ASSERT_EQ(0, co.PushBackLong("b", 12));
+	ASSERT_EQ(0, co.EndRow());
+
+	ASSERT_EQ((size_t)4, co.GetColCount());
+	ASSERT_EQ((size_t)5, co.GetRowCount());
+
+	ASSERT_EQ(std::string("d"), std::string(co.Get(0, 3).sVal));
+
+	ASSERT_EQ(1L, co.Get(1, 0).lVal);
+	ASSERT_EQ(3L, co.Get(1, 2).lVal);
+	ASSERT_EQ(TT_EMPTY, co.Get(1, 3).type);
+
+	ASSERT_EQ(4L, co.Get(2, 0).lVal);
+	ASSERT_EQ(5L, co.Get(2, 1).lVal);
+	ASSERT_EQ(6L, co.Get(2, 2).lVal);
+
+	ASSERT_EQ(7L, co.Get(3, 0).lVal);
+	ASSERT_EQ(TT_EMPTY, co.Get(3, 1).type);
+	ASSERT_EQ(9L, co.Get(3, 2).lVal);
+	ASSERT_EQ(10L, co.Get(3, 3).lVal);
+
+	ASSERT_EQ(TT_EMPTY, co.Get(4, 0).type);
+	ASSERT_EQ(12L, co.Get(4, 1).lVal);
+	ASSERT_EQ(TT_EMPTY, co.Get(4, 2).type);
+}
@@ -0,0 +1,231 @@
+// CInputTemplate.cpp: implementation of the CInputTemplate class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+
+#include "CInputTemplate.hxx"      // CInputTemplate
+#include "Keywords.h"              // Keywords
+
+static bool is_definition(Keywords::KEYWORDS key)
+{
+	// keywords that only add to the thermodynamic model
+	switch (key)
+	{
+	case Keywords::KEY_SOLUTION_SPECIES:
+	case Keywords::KEY_SOLUTION_MASTER_SPECIES:
+	case Keywords::KEY_PHASES:
+	case Keywords::KEY_EXCHANGE_SPECIES:
+	case Keywords::KEY_EXCHANGE_MASTER_SPECIES:
+	case Keywords::KEY_SURFACE_SPECIES:
+	case Keywords::KEY_SURFACE_MASTER_SPECIES:
+	case Keywords::KEY_RATES:
+	case Keywords::KEY_LLNL_AQUEOUS_MODEL_PARAMETERS:
+	case Keywords::KEY_NAMED_EXPRESSIONS:
+	case Keywords::KEY_ISOTOPES:
+	case Keywords::KEY_CALCULATE_VALUES:
+	case Keywords::KEY_ISOTOPE_RATIOS:
+	case Keywords::KEY_ISOTOPE_ALPHAS:
+	case Keywords::KEY_PITZER:
+	case Keywords::KEY_SIT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static Keywords::KEYWORDS find_keyword(const char* begin, const char* end)
+{
+	// first token of a logical line, as PHRQ_io::get_line sees it
+	for (; begin < end && ::isspace((unsigned char)*begin); ++begin);
+	std::string token;
+	for (; begin < end && !::isspace((unsigned char)*begin); ++begin)
+	{
+		token += (char)::tolower((unsigned char)*begin);
+	}
+	if (token.empty())
+	{
+		return Keywords::KEY_NONE;
+	}
+	return Keywords::Keyword_search(token);
+}
+
+CInputTemplate::CInputTemplate(const char* input)
+: m_generation(0)
+{
+	const char* text = input ? input : "";
+
+	// split into keyword blocks at the start of each logical line
+	// (after a newline or ';') that begins with a keyword
+	std::vector<const char*> starts;
+	std::vector<Keywords::KEYWORDS> keys;
+	bool bDatabase = false;
+	bool bContinued = false;
+
+	starts.push_back(text);
+	keys.push_back(Keywords::KEY_NONE);
+	const char* line = text;
+	while (*line)
+	{
+		const char* eol = ::strchr(line, '\n');
+		if (!eol)
+		{
+			eol = line + ::strlen(line);
+		}
+		const char* comment = line;
+		for (; comment < eol && *comment != '#'; ++comment);
+
+		const char* seg = line;
+		for (bool bFirst = true; ; bFirst = false)
+		{
+			const char* semi = seg;
+			for (; semi < comment && *semi != ';'; ++semi);
+			if (!(bFirst && bContinued))
+			{
+				Keywords::KEYWORDS key = find_keyword(seg, semi);
+				if (key != Keywords::KEY_NONE)
+				{
+					starts.push_back(seg);
+					keys.push_back(key);
+					bDatabase = bDatabase || (key == Keywords::KEY_DATABASE);
+				}
+			}
+			if (semi == comment)
+			{
+				break;
+			}
+			seg = semi + 1;
+		}
+
+		// a '\' followed only by white space continues the logical line
+		const char* last = comment;
+		for (; last > line && ::isspace((unsigned char)last[-1]); --last);
+		bContinued = (last > line && last[-1] == '\\');
+
+		line = *eol ? eol + 1 : eol;
+	}
+	starts.push_back(line);
+
+	// a definition left out of a rerun is whatever the previous run left loaded,
+	// which is the last block of that keyword; so only a keyword defined by a
+	// single block can be left out, otherwise the simulations before the later
+	// block would see its definitions
+	std::map<Keywords::KEYWORDS, int> count;
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (is_definition(keys[i]))
+		{
+			++count[keys[i]];
+		}
+	}
+	for (size_t i = 0; i + 1 < starts.size(); ++i)
+	{
+		// DATABASE replaces the model, so nothing may be left out
+		bool bSkippable = !bDatabase && is_definition(keys[i]) && count[keys[i]] == 1;
+		this->AddBlock(starts[i], starts[i + 1], bSkippable);
+	}
+}
+
+CInputTemplate::~CInputTemplate(void)
+{
+}
+
+void CInputTemplate::AddBlock(const char* begin, const char* end, bool bSkippable)
+{
+	if (begin == end)
+	{
+		return;
+	}
+
+	size_t first = this->m_pieces.size();
+	bool bSlots = false;
+	Piece piece;
+	piece.slot = -1;
+	piece.skip = false;
+	const char* p = begin;
+	while (p < end)
+	{
+		if (*p == '{')
+		{
+			const char* q = p + 1;
+			if (q < end && (::isalpha((unsigned char)*q) || *q == '_'))
+			{
+				for (++q; q < end && (::isalnum((unsigned char)*q) || *q == '_'); ++q);
+				if (q < end && *q == '}')
+				{
+					std::string name(p + 1, q);
+					size_t slot = 0;
+					for (; slot < this->m_slots.size() && this->m_slots[slot] != name; ++slot);
+					if (slot == this->m_slots.size())
+					{
+						this->m_slots.push_back(name);
+					}
+					piece.slot = (int)slot;
+					this->m_pieces.push_back(piece);
+					piece.text.clear();
+					piece.slot = -1;
+					bSlots = true;
+					p = q + 1;
+					continue;
+				}
+			}
+		}
+		piece.text += *p++;
+	}
+	if (!piece.text.empty())
+	{
+		this->m_pieces.push_back(piece);
+	}
+
+	for (size_t i = first; i < this->m_pieces.size(); ++i)
+	{
+		this->m_pieces[i].skip = bSkippable && !bSlots;
+	}
+}
+
+size_t CInputTemplate::GetSlotCount(void)const
+{
+	return this->m_slots.size();
+}
+
+const char* CInputTemplate::GetSlotName(size_t slot)const
+{
+	if (slot < this->m_slots.size())
+	{
+		return this->m_slots[slot].c_str();
+	}
+	return 0;
+}
+
+void CInputTemplate::Expand(const double* values, bool bAll, std::string& input)const
+{
+	char buffer[40];
+	input.clear();
+	std::vector<Piece>::const_iterator it = this->m_pieces.begin();
+	for (; it != this->m_pieces.end(); ++it)
+	{
+		if ((*it).skip && !bAll)
+		{
+			continue;
+		}
+		input.append((*it).text);
+		if ((*it).slot >= 0)
+		{
+			::sprintf(buffer, "%.17g", values[(*it).slot]);
+			input.append(buffer);
+		}
+	}
+}
+
+size_t CInputTemplate::GetGeneration(void)const
+{
+	return this->m_generation;
+}
+
+void CInputTemplate::SetGeneration(size_t generation)
+{
+	this->m_generation = generation;
+}
@@ -0,0 +1,56 @@
+// CInputTemplate.hxx: interface for the CInputTemplate class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined _INC_INPUTTEMPLATE_H
+#define _INC_INPUTTEMPLATE_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+//
+// An input deck with named numeric slots, written {name}, that is
+// split into keyword blocks once and expanded for each run.
+//
+// Model definitions (SOLUTION_SPECIES, PHASES, RATES, ...) that contain
+// no slots stay defined in the instance after a successful run, so later
+// expansions can leave them out and the model is not re-read and re-tidied.
+// This is only done for definitions whose keyword is not used by any other
+// block of the template; a definition that a later block replaces must be
+// re-read for each run.
+//
+class CInputTemplate
+{
+public:
+	CInputTemplate(const char* input);
+	~CInputTemplate(void);
+
+	size_t GetSlotCount(void)const;
+	const char* GetSlotName(size_t slot)const;
+
+	// builds the input for one run; bAll includes the unchanged model definitions
+	void Expand(const double* values, bool bAll, std::string& input)const;
+
+	// run generation of the instance after the last successful full run (0 if none)
+	size_t GetGeneration(void)const;
+	void SetGeneration(size_t generation);
+
+protected:
+	void AddBlock(const char* begin, const char* end, bool bSkippable);
+
+	struct Piece
+	{
+		std::string text;   // literal text preceding the slot
+		int slot;           // slot index, -1 for trailing text
+		bool skip;          // part of a model definition without slots
+	};
+	std::vector<Piece> m_pieces;
+	std::vector<std::string> m_slots;
+	size_t m_generation;
+};
+
+#endif // !defined(_INC_INPUTTEMPLATE_H)
@@ -0,0 +1,87 @@
+// CLineIndex.cpp: implementation of the CLineIndex class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "CLineIndex.hxx"          // CLineIndex
+
+CLineIndex::CLineIndex(void)
+: m_open(false)
+{
+}
+
+CLineIndex::~CLineIndex(void)
+{
+}
+
+void CLineIndex::Append(const char* str)
+{
+	if (str)
+	{
+		this->Append(str, ::strlen(str));
+	}
+}
+
+void CLineIndex::Append(const char* str, size_t len)
+{
+	const char* end = str + len;
+	while (str < end)
+	{
+		if (!this->m_open)
+		{
+			this->m_offsets.push_back(this->m_text.size());
+			this->m_open = true;
+		}
+		const char* eol = (const char*)::memchr(str, '\n', end - str);
+		if (!eol)
+		{
+			this->m_text.append(str, end);
+			break;
+		}
+		this->m_text.append(str, eol);
+		this->m_text += '\0';
+		this->m_open = false;
+		str = eol + 1;
+	}
+}
+
+void CLineIndex::Clear(void)
+{
+	this->m_text.clear();
+	this->m_offsets.clear();
+	this->m_open = false;
+}
+
+int CLineIndex::GetCount(void)const
+{
+	return (int)this->m_offsets.size();
+}
+
+const char* CLineIndex::GetLine(int n)const
+{
+	static const char empty[] = "";
+	if (n < 0 || n >= this->GetCount())
+	{
+		return empty;
+	}
+	return this->m_text.c_str() + this->m_offsets[n];
+}
+
+int CLineIndex::GetLines(int start, int count, const char** lines)const
+{
+	if (start < 0 || count <= 0 || !lines || start >= this->GetCount())
+	{
+		return 0;
+	}
+	if (count > this->GetCount() - start)
+	{
+		count = this->GetCount() - start;
+	}
+	const char* text = this->m_text.c_str();
+	for (int i = 0; i < count; ++i)
+	{
+		lines[i] = text + this->m_offsets[start + i];
+	}
+	return count;
+}
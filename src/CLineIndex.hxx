@@ -0,0 +1,46 @@
+// CLineIndex.hxx: interface for the CLineIndex class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined _INC_LINEINDEX_H
+#define _INC_LINEINDEX_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+//
+// Lines of an accumulated string buffer, split as std::getline would
+// split them ('\n' removed, no empty line after a trailing '\n').
+//
+// Text is indexed as it is appended: the lines are kept in one buffer,
+// each terminated by '\0', with the offset of each line, so any line
+// is found in constant time.  Pointers returned by GetLine are valid
+// until the next Append or Clear.
+//
+class CLineIndex
+{
+public:
+	CLineIndex(void);
+	~CLineIndex(void);
+
+	void Append(const char* str);
+	void Append(const char* str, size_t len);
+	void Clear(void);
+
+	int GetCount(void)const;
+	const char* GetLine(int n)const;
+
+	// copies pointers to lines start..start+count-1; returns the number copied
+	int GetLines(int start, int count, const char** lines)const;
+
+protected:
+	std::string m_text;
+	std::vector<size_t> m_offsets;
+	bool m_open;                     // last line not yet ended by '\n'
+};
+
+#endif // !defined(_INC_LINEINDEX_H)
@@ -27,8 +27,9 @@ const size_t RESERVE_COLS = 80;
 
 CSelectedOutput::CSelectedOutput()
 : m_nRowCount(0)
+, m_nNextCol(0)
 {
-	this->m_arrayVar.reserve(RESERVE_COLS);
+	this->m_columns.reserve(RESERVE_COLS);
 }
 
 CSelectedOutput::~CSelectedOutput()
@@ -38,9 +39,41 @@ CSelectedOutput::~CSelectedOutput()
 void CSelectedOutput::Clear(void)
 {
 	this->m_nRowCount = 0;
+	this->m_nNextCol = 0;
 	this->m_vecVarHeadings.clear();
-	this->m_arrayVar.clear();
+	this->m_columns.clear();
 	this->m_mapHeadingToCol.clear();
+	this->m_strings.clear();
+	this->m_mapStringToIndex.clear();
+}
+
+void CSelectedOutput::ClearRows(void)
+{
+	// keep headings and column storage
+	this->m_nRowCount = 0;
+	this->m_nNextCol = 0;
+	for (size_t col = 0; col < this->m_columns.size(); ++col)
+	{
+		this->m_columns[col].types.clear();
+		this->m_columns[col].doubles.clear();
+		this->m_columns[col].longs.clear();
+	}
+	this->m_strings.clear();
+	this->m_mapStringToIndex.clear();
+}
+
+void CSelectedOutput::GetLastRow(std::vector<const char*> &headings, std::vector<VAR> &values)const
+{
+	// shallow copies; valid until the next PushBack/ClearRows
+	size_t ncols = this->GetColCount();
+	headings.resize(ncols);
+	values.resize(ncols);
+	for (size_t col = 0; col < ncols; ++col)
+	{
+		headings[col] = this->m_vecVarHeadings[col].sVal;
+		ASSERT(this->m_columns[col].types.size() == this->m_nRowCount);
+		this->GetCell(col, this->m_nRowCount - 1, values[col]);
+	}
 }
 
 size_t CSelectedOutput::GetRowCount(void)const
@@ -87,8 +120,10 @@ VRESULT CSelectedOutput::Get(int nRow, int nCol, VAR* pVAR)const
 	}
 	if (nRow)
 	{
-		ASSERT((size_t)nRow <= this->m_arrayVar[nCol].size());
-		return ::VarCopy(pVAR, &(this->m_arrayVar[nCol])[nRow - 1]);
+		ASSERT((size_t)nRow <= this->m_columns[nCol].types.size());
+		VAR v;
+		this->GetCell(nCol, nRow - 1, v);
+		return ::VarCopy(pVAR, &v);
 	}
 	else
 	{
@@ -99,34 +134,59 @@ VRESULT CSelectedOutput::Get(int nRow, int nCol, VAR* pVAR)const
 
 int CSelectedOutput::EndRow(void)
 {
-	if (size_t ncols = this->GetColCount())
+	this->m_nNextCol = 0;
+	if (this->GetColCount())
 	{
 		++this->m_nRowCount;
+		this->FillRows();
+	}
+	return 0;
+}
 
-		// make sure array is full
-		for (size_t col = 0; col < ncols; ++col)
+void CSelectedOutput::FillRows(void)
+{
+	// make sure array is full
+	size_t ncols = this->GetColCount();
+	for (size_t col = 0; col < ncols; ++col)
+	{
+		Column &c = this->m_columns[col];
+		size_t nrows = c.types.size();
+		if (nrows < this->m_nRowCount)
 		{
-			size_t nrows = this->m_arrayVar[col].size();
-			if (nrows < this->m_nRowCount)
-			{
-				// fill w/ empty
-				this->m_arrayVar[col].resize(this->m_nRowCount);
-			}
+			// fill w/ empty
+			c.types.resize(this->m_nRowCount, TT_EMPTY);
+			c.doubles.resize(this->m_nRowCount, (double) INACTIVE_CELL_VALUE);
+			if (!c.longs.empty())
+				c.longs.resize(this->m_nRowCount, 0);
+		}
 #if defined(_DEBUG)
-			else if (nrows > this->m_nRowCount)
-			{
-				ASSERT(false);
-			}
-#endif
+		else if (nrows > this->m_nRowCount)
+		{
+			ASSERT(false);
 		}
+#endif
 	}
-	return 0;
 }
 
 int CSelectedOutput::PushBack(const char* key, const CVar& var)
+{
+	return this->PushBackVar(key, var);
+}
+
+int CSelectedOutput::PushBackVar(const char* key, const VAR& var)
 {
 	try
 	{
+		// rows are punched in the same column order, so once the headings
+		// are known the expected slot usually matches without a map lookup
+		size_t col = this->m_nNextCol;
+		if (col < this->m_vecVarHeadings.size() && ::strcmp(this->m_vecVarHeadings[col].sVal, key) == 0)
+		{
+			this->SetCell(col, var);
+			this->m_nNextCol = col + 1;
+			return 0;
+		}
+
 		// check if key is new
 		std::map< std::string, size_t >::iterator find;
 		find = this->m_mapHeadingToCol.find(std::string(key));
@@ -134,34 +194,14 @@ int CSelectedOutput::PushBack(const char* key, const CVar& var)
 		{
 			// new key(column)
 			//
-			this->m_mapHeadingToCol.insert(std::map< std::string, size_t >::value_type(std::string(key),
-				this->m_mapHeadingToCol.size()) );
-
-			// add heading
-			//
-			this->m_vecVarHeadings.push_back(CVar(key));
-
-
-			// add new vector(col)
-			//
-			this->m_arrayVar.resize(this->m_arrayVar.size() + 1);
-			this->m_arrayVar.back().reserve(RESERVE_ROWS);
-
-			// add empty rows if nec
-			if (this->m_nRowCount)
-				this->m_arrayVar.back().resize(this->m_nRowCount);
-
-			this->m_arrayVar.back().push_back(var);
+			col = this->AddColumn(key);
+			this->SetCell(col, var);
+			this->m_nNextCol = col + 1;
 		}
 		else
 		{
-			if (this->m_arrayVar[find->second].size() == this->m_nRowCount) {
-				this->m_arrayVar[find->second].push_back(var);
-			}
-			else {
-				ASSERT(this->m_arrayVar[find->second].size() == this->m_nRowCount + 1);
-				this->m_arrayVar[find->second].at(this->m_nRowCount) = var;
-			}
+			this->SetCell(find->second, var);
+			this->m_nNextCol = find->second + 1;
 		}
 		return 0;
 	}
@@ -174,28 +214,163 @@ int CSelectedOutput::PushBack(const char* key, const CVar& var)
 }
 
 
+size_t CSelectedOutput::AddColumn(const char* key)
+{
+	size_t col = this->m_columns.size();
+	this->m_mapHeadingToCol.insert(std::map< std::string, size_t >::value_type(std::string(key), col));
+
+	// add heading
+	//
+	this->m_vecVarHeadings.push_back(CVar(key));
+
+	// add new vector(col)
+	//
+	this->m_columns.resize(col + 1);
+	Column &c = this->m_columns.back();
+	c.types.reserve(RESERVE_ROWS);
+	c.doubles.reserve(RESERVE_ROWS);
+
+	// add empty rows if nec
+	if (this->m_nRowCount)
+	{
+		c.types.resize(this->m_nRowCount, TT_EMPTY);
+		c.doubles.resize(this->m_nRowCount, (double) INACTIVE_CELL_VALUE);
+	}
+	return col;
+}
+
+void CSelectedOutput::SetCell(size_t col, const VAR& var)
+{
+	// sets the value of the current row
+	Column &c = this->m_columns[col];
+	size_t row = this->m_nRowCount;
+	if (c.types.size() == row)
+	{
+		c.types.push_back(TT_EMPTY);
+		c.doubles.push_back((double) INACTIVE_CELL_VALUE);
+		if (!c.longs.empty())
+			c.longs.push_back(0);
+	}
+	ASSERT(c.types.size() == row + 1);
+
+	long l = 0;
+	c.types[row] = (unsigned char) var.type;
+	c.doubles[row] = (double) INACTIVE_CELL_VALUE;
+	switch (var.type)
+	{
+	case TT_DOUBLE:
+		c.doubles[row] = var.dVal;
+		break;
+	case TT_LONG:
+		c.doubles[row] = (double) var.lVal;
+		l = var.lVal;
+		break;
+	case TT_ERROR:
+		l = var.vresult;
+		break;
+	case TT_STRING:
+		l = this->StringIndex(var.sVal);
+		break;
+	default:
+		break;
+	}
+	if (c.longs.empty())
+	{
+		if (var.type == TT_DOUBLE || var.type == TT_EMPTY)
+			return;
+		c.longs.resize(c.types.size(), 0);
+	}
+	c.longs[row] = l;
+}
+
+void CSelectedOutput::GetCell(size_t col, size_t row, VAR& var)const
+{
+	// shallow; strings are owned by m_strings
+	const Column &c = this->m_columns[col];
+	var.type = (VAR_TYPE) c.types[row];
+	switch (var.type)
+	{
+	case TT_DOUBLE:
+		var.dVal = c.doubles[row];
+		break;
+	case TT_LONG:
+		var.lVal = c.longs[row];
+		break;
+	case TT_ERROR:
+		var.vresult = (VRESULT) c.longs[row];
+		break;
+	case TT_STRING:
+		var.sVal = const_cast<char*>(this->m_strings[c.longs[row]].c_str());
+		break;
+	default:
+		var.type = TT_EMPTY;
+		break;
+	}
+}
+
+long CSelectedOutput::StringIndex(const char* str)
+{
+	std::map< std::string, long >::iterator it = this->m_mapStringToIndex.lower_bound(str);
+	if (it == this->m_mapStringToIndex.end() || it->first != str)
+	{
+		it = this->m_mapStringToIndex.insert(it, std::map< std::string, long >::value_type(str, (long) this->m_strings.size()));
+		this->m_strings.push_back(str);
+	}
+	return it->second;
+}
+
+VRESULT CSelectedOutput::GetColumn(int nCol, double* values, int n, int* rows)const
+{
+	// values of rows 1..n; INACTIVE_CELL_VALUE where a row is not numeric (see Doublize)
+	if ((size_t)nCol >= this->GetColCount() || nCol < 0)
+	{
+		return VR_INVALIDCOL;
+	}
+	if (n < 0 || (n > 0 && values == NULL))
+	{
+		return VR_INVALIDARG;
+	}
+	size_t count = (size_t) n < this->m_nRowCount ? (size_t) n : this->m_nRowCount;
+	if (count)
+	{
+		::memcpy(values, &this->m_columns[nCol].doubles[0], count * sizeof(double));
+	}
+	if (rows)
+	{
+		*rows = (int)count;
+	}
+	return VR_OK;
+}
+
 int CSelectedOutput::PushBackDouble(const char* key, double value)
 {
-	CVar v(value);
-	return this->PushBack(key, v);
+	VAR v;
+	v.type = TT_DOUBLE;
+	v.dVal = value;
+	return this->PushBackVar(key, v);
 }
 
 int CSelectedOutput::PushBackLong(const char* key, long value)
 {
-	CVar v(value);
-	return this->PushBack(key, v);
+	VAR v;
+	v.type = TT_LONG;
+	v.lVal = value;
+	return this->PushBackVar(key, v);
 }
 
 int CSelectedOutput::PushBackString(const char* key, const char* value)
 {
-	CVar v(value);
-	return this->PushBack(key, v);
+	VAR v;
+	v.type = TT_STRING;
+	v.sVal = const_cast<char*>(value);
+	return this->PushBackVar(key, v);
 }
 
 int CSelectedOutput::PushBackEmpty(const char* key)
 {
-	CVar v;
-	return this->PushBack(key, v);
+	VAR v;
+	v.type = TT_EMPTY;
+	return this->PushBackVar(key, v);
 }
 
 #if defined(_DEBUG)
@@ -217,10 +392,12 @@ void CSelectedOutput::AssertValid(void)const
 {
 	if (size_t cols = this->GetColCount())
 	{
-		size_t rows = this->m_arrayVar[0].size();
+		size_t rows = this->m_columns[0].types.size();
 		for (size_t col = 0; col < cols; ++col)
 		{
-			ASSERT(rows == this->m_arrayVar[col].size());
+			ASSERT(rows == this->m_columns[col].types.size());
+			ASSERT(rows == this->m_columns[col].doubles.size());
+			ASSERT(this->m_columns[col].longs.empty() || rows == this->m_columns[col].longs.size());
 		}
 	}
 }
@@ -275,23 +452,25 @@ void CSelectedOutput::Serialize(
 	{
 		for (size_t i = row_number; i < (size_t)(row_number + 1); i++)
 		{
-			types.push_back(m_arrayVar[j][i].type);
-			switch(m_arrayVar[j][i].type)
+			VAR v;
+			this->GetCell(j, i, v);
+			types.push_back(v.type);
+			switch(v.type)
 			{
 			case TT_EMPTY:
 				break;
 			case TT_ERROR:
-				longs.push_back(m_arrayVar[j][i].vresult);
+				longs.push_back(v.vresult);
 				break;
 			case TT_LONG:
-				longs.push_back(m_arrayVar[j][i].lVal);
+				longs.push_back(v.lVal);
 				break;
 			case TT_DOUBLE:
-				doubles.push_back(m_arrayVar[j][i].dVal);
+				doubles.push_back(v.dVal);
 				break;
 			case TT_STRING:
-				longs.push_back((long) strlen(m_arrayVar[j][i].sVal));
-				strings.append(m_arrayVar[j][i].sVal);
+				longs.push_back((long) strlen(v.sVal));
+				strings.append(v.sVal);
 				break;
 
 			}
@@ -369,33 +548,12 @@ void CSelectedOutput::Doublize(
 	ncol = (int) this->m_vecVarHeadings.size();
 
 	doubles.clear();
-	// go through column dominant order (Fortran)
+	doubles.reserve((size_t)nrow * (size_t)ncol);
+	// go through column dominant order (Fortran); non-numeric rows are
+	// already stored as INACTIVE_CELL_VALUE
 	for (size_t j = 0; j < (size_t)ncol; j++)
 	{
-		for (size_t i = 0; i < (size_t)nrow; i++)
-		{
-			switch(m_arrayVar[j][i].type)
-			{
-			case TT_EMPTY:
-				doubles.push_back((double) INACTIVE_CELL_VALUE);
-				break;
-			case TT_ERROR:
-				doubles.push_back((double) INACTIVE_CELL_VALUE);
-				break;
-			case TT_LONG:
-				doubles.push_back((double) m_arrayVar[j][i].lVal);
-				break;
-			case TT_DOUBLE:
-				doubles.push_back(m_arrayVar[j][i].dVal);
-				break;
-			case TT_STRING:
-				doubles.push_back((double) INACTIVE_CELL_VALUE);
-				break;
-			default:
-				doubles.push_back((double) INACTIVE_CELL_VALUE);
-				break;
-
-			}
-		}
+		const std::vector<double> &col = this->m_columns[j].doubles;
+		doubles.insert(doubles.end(), col.begin(), col.begin() + nrow);
 	}
 }
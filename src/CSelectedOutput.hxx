@@ -25,12 +25,14 @@ public:
 
 	int EndRow(void);
 	void Clear(void);
+	void ClearRows(void);
 
 	size_t GetRowCount(void)const;
 	size_t GetColCount(void)const;
 
 	CVar Get(int nRow, int nCol)const;
 	VRESULT Get(int nRow, int nCol, VAR* pVAR)const;
+	VRESULT GetColumn(int nCol, double* values, int n, int* rows)const;
 
 	int PushBack(const char* key, const CVar& var);
 
@@ -39,6 +41,9 @@ public:
 	int PushBackString(const char* key, const char* sVal);
 	int PushBackEmpty(const char* key);
 
+	// streaming
+	void GetLastRow(std::vector<const char*> &headings, std::vector<VAR> &values)const;
+
 	// Serialize
 	void Serialize(
 		int row,
@@ -62,11 +67,32 @@ public:
 #endif
 
 protected:
+	int PushBackVar(const char* key, const VAR& var);
+	size_t AddColumn(const char* key);
+	void FillRows(void);
+	void SetCell(size_t col, const VAR& var);
+	void GetCell(size_t col, size_t row, VAR& var)const;
+	long StringIndex(const char* str);
+
 	friend std::ostream& operator<< (std::ostream &os, const CSelectedOutput &a);
+	friend class CSelectedOutputFile;
+	friend class CSelectedOutputFileReader;
 
 	size_t m_nRowCount;
-
-	std::vector< std::vector<CVar> > m_arrayVar;
+	size_t m_nNextCol;                   // column expected for the next PushBack of the row
+
+	// typed column store; the numeric value of each row is contiguous so a
+	// column can be exported with a single copy
+	class Column
+	{
+	public:
+		std::vector<unsigned char> types;  // VAR_TYPE of each row
+		std::vector<double> doubles;       // TT_DOUBLE and TT_LONG values, INACTIVE_CELL_VALUE otherwise
+		std::vector<long> longs;           // TT_LONG values, TT_ERROR vresults and TT_STRING indices (empty until needed)
+	};
+	std::vector<Column> m_columns;
+	std::vector<std::string> m_strings;  // string values, shared by all columns
+	std::map< std::string, long > m_mapStringToIndex;
 	std::vector<CVar> m_vecVarHeadings;
 	std::map< std::string, size_t > m_mapHeadingToCol;
 
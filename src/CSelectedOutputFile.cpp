@@ -0,0 +1,632 @@
+// CSelectedOutputFile.cpp: implementation of the CSelectedOutputFile class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>                 // memcpy
+
+#include "Debug.h"                  // ASSERT
+#include "CSelectedOutputFile.hxx"  // CSelectedOutputFile
+
+static const char MAGIC[4]       = { 'P', 'Q', 'S', 'O' };
+static const char ROW_GROUP[4]   = { 'P', 'Q', 'R', 'G' };
+static const char FOOTER[4]      = { 'P', 'Q', 'F', 'T' };
+static const unsigned int FILE_VERSION = 1;
+static const unsigned int ORDER_MARK = 0x01020304;
+
+enum { ENCODING_PLAIN = 0, ENCODING_PACKED = 1 };
+
+template <typename T>
+static void put(std::vector<unsigned char> &buf, const T &value)
+{
+	const unsigned char *p = (const unsigned char *) &value;
+	buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+static void put_string(std::vector<unsigned char> &buf, const char *str)
+{
+	unsigned int l = (unsigned int) strlen(str);
+	put(buf, l);
+	buf.insert(buf.end(), str, str + l);
+}
+
+template <typename T>
+static bool get(std::istream &is, T &value)
+{
+	return (bool) is.read((char *) &value, sizeof(T));
+}
+
+static bool get_string(std::istream &is, std::string &str, unsigned long long limit)
+{
+	unsigned int l;
+	if (!get(is, l) || l > limit)
+		return false;
+	str.resize(l);
+	return l == 0 || (bool) is.read(&str[0], l);
+}
+
+static bool get_magic(std::istream &is, const char *magic)
+{
+	char m[4];
+	return is.read(m, 4) && memcmp(m, magic, 4) == 0;
+}
+
+static bool valid_type(unsigned char type, bool has_longs)
+{
+	switch (type)
+	{
+	case TT_EMPTY:
+	case TT_DOUBLE:
+		return true;
+	case TT_LONG:
+	case TT_ERROR:
+	case TT_STRING:
+		// kept in the longs
+		return has_longs;
+	default:
+		return false;
+	}
+}
+
+/* ---------------------------------------------------------------------- */
+/*   packing: 8-byte words xor'ed with the previous word and byte shuffled, */
+/*   so slowly varying columns give long runs for PackBits                 */
+/* ---------------------------------------------------------------------- */
+static void shuffle(const unsigned char *src, size_t n, unsigned char *dst)
+{
+	unsigned long long prev = 0, w, x;
+	for (size_t i = 0; i < n; ++i)
+	{
+		memcpy(&w, src + 8 * i, 8);
+		x = w ^ prev;
+		prev = w;
+		const unsigned char *b = (const unsigned char *) &x;
+		for (size_t k = 0; k < 8; ++k)
+		{
+			dst[k * n + i] = b[k];
+		}
+	}
+}
+
+static void unshuffle(const unsigned char *src, size_t n, unsigned char *dst)
+{
+	unsigned long long prev = 0, w, x;
+	unsigned char *b = (unsigned char *) &x;
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t k = 0; k < 8; ++k)
+		{
+			b[k] = src[k * n + i];
+		}
+		w = x ^ prev;
+		prev = w;
+		memcpy(dst + 8 * i, &w, 8);
+	}
+}
+
+static void pack_bits(const unsigned char *src, size_t len, std::vector<unsigned char> &out)
+{
+	size_t i = 0;
+	while (i < len)
+	{
+		size_t j = i + 1;
+		while (j < len && j - i < 128 && src[j] == src[i])
+			++j;
+		if (j - i >= 3)
+		{
+			out.push_back((unsigned char) (257 - (j - i)));
+			out.push_back(src[i]);
+			i = j;
+			continue;
+		}
+		size_t start = i;
+		while (i < len && i - start < 128)
+		{
+			if (i + 2 < len && src[i] == src[i + 1] && src[i] == src[i + 2])
+				break;
+			++i;
+		}
+		out.push_back((unsigned char) (i - start - 1));
+		out.insert(out.end(), src + start, src + i);
+	}
+}
+
+static bool unpack_bits(const unsigned char *src, size_t len, unsigned char *dst, size_t dst_len, size_t &written)
+{
+	size_t i = 0, o = 0;
+	while (i < len)
+	{
+		unsigned char h = src[i++];
+		if (h < 128)
+		{
+			size_t n = (size_t) h + 1;
+			if (i + n > len || o + n > dst_len)
+				return false;
+			memcpy(dst + o, src + i, n);
+			i += n;
+			o += n;
+		}
+		else if (h > 128)
+		{
+			size_t n = 257 - (size_t) h;
+			if (i >= len || o + n > dst_len)
+				return false;
+			memset(dst + o, src[i++], n);
+			o += n;
+		}
+	}
+	written = o;
+	return true;
+}
+
+CSelectedOutputFile::CSelectedOutputFile(void)
+: m_nRows(0)
+{
+}
+
+CSelectedOutputFile::~CSelectedOutputFile(void)
+{
+	this->Close();
+}
+
+bool CSelectedOutputFile::IsOpen(void)const
+{
+	return this->m_ofs.is_open();
+}
+
+bool CSelectedOutputFile::Open(const char* filename)
+{
+	this->Close();
+	this->m_rows.Clear();
+	this->m_types.clear();
+	this->m_offsets.clear();
+	this->m_nRows = 0;
+
+	this->m_ofs.open(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!this->m_ofs.is_open())
+		return false;
+
+	this->m_buffer.assign(MAGIC, MAGIC + 4);
+	put(this->m_buffer, FILE_VERSION);
+	put(this->m_buffer, ORDER_MARK);
+	this->m_ofs.write((const char *) &this->m_buffer[0], this->m_buffer.size());
+	return this->m_ofs.good();
+}
+
+bool CSelectedOutputFile::AddRow(const std::vector<const char*> &headings, const std::vector<VAR> &values)
+{
+	ASSERT(headings.size() == values.size());
+	if (this->m_types.size() < values.size())
+	{
+		this->m_types.resize(values.size(), TT_EMPTY);
+	}
+	for (size_t col = 0; col < values.size(); ++col)
+	{
+		this->m_rows.PushBackVar(headings[col], values[col]);
+
+		unsigned char t = (unsigned char) values[col].type;
+		if (t != TT_EMPTY && t != this->m_types[col])
+		{
+			this->m_types[col] = (this->m_types[col] == TT_EMPTY) ? t : TYPE_MIXED;
+		}
+	}
+	this->m_rows.EndRow();
+	if (this->m_rows.m_nRowCount >= ROW_GROUP_SIZE)
+	{
+		return this->WriteRowGroup();
+	}
+	return this->m_ofs.good();
+}
+
+bool CSelectedOutputFile::WriteRowGroup(void)
+{
+	size_t nrows = this->m_rows.m_nRowCount;
+	size_t ncols = this->m_rows.GetColCount();
+	if (nrows == 0)
+		return true;
+
+	this->m_offsets.push_back((unsigned long long) this->m_ofs.tellp());
+	this->m_nRows += nrows;
+
+	std::vector<unsigned char> &buf = this->m_buffer;
+	buf.assign(ROW_GROUP, ROW_GROUP + 4);
+	put(buf, (unsigned int) nrows);
+	put(buf, (unsigned int) ncols);
+	put(buf, (unsigned int) this->m_rows.m_strings.size());
+	for (size_t i = 0; i < this->m_rows.m_strings.size(); ++i)
+	{
+		put_string(buf, this->m_rows.m_strings[i].c_str());
+	}
+
+	std::vector<unsigned char> plain, shuffled;
+	for (size_t col = 0; col < ncols; ++col)
+	{
+		const CSelectedOutput::Column &c = this->m_rows.m_columns[col];
+		ASSERT(c.types.size() == nrows);
+
+		// plain payload
+		plain.clear();
+		plain.insert(plain.end(), c.types.begin(), c.types.end());
+		const unsigned char *d = (const unsigned char *) &c.doubles[0];
+		plain.insert(plain.end(), d, d + nrows * sizeof(double));
+		unsigned char has_longs = c.longs.empty() ? 0 : 1;
+		plain.push_back(has_longs);
+		if (has_longs)
+		{
+			for (size_t i = 0; i < nrows; ++i)
+			{
+				put(plain, (long long) c.longs[i]);
+			}
+		}
+
+		// packed payload
+		shuffled.resize(plain.size());
+		memcpy(&shuffled[0], &plain[0], nrows);
+		shuffle(&plain[nrows], nrows, &shuffled[nrows]);
+		size_t pos = nrows + 8 * nrows;
+		shuffled[pos] = has_longs;
+		if (has_longs)
+		{
+			shuffle(&plain[pos + 1], nrows, &shuffled[pos + 1]);
+		}
+		this->m_packed.clear();
+		pack_bits(&shuffled[0], shuffled.size(), this->m_packed);
+
+		if (this->m_packed.size() < plain.size())
+		{
+			buf.push_back((unsigned char) ENCODING_PACKED);
+			put(buf, (unsigned long long) this->m_packed.size());
+			buf.insert(buf.end(), this->m_packed.begin(), this->m_packed.end());
+		}
+		else
+		{
+			buf.push_back((unsigned char) ENCODING_PLAIN);
+			put(buf, (unsigned long long) plain.size());
+			buf.insert(buf.end(), plain.begin(), plain.end());
+		}
+	}
+	this->m_ofs.write((const char *) &buf[0], buf.size());
+	this->m_rows.ClearRows();
+	return this->m_ofs.good();
+}
+
+bool CSelectedOutputFile::Close(void)
+{
+	if (!this->m_ofs.is_open())
+		return true;
+
+	this->WriteRowGroup();
+
+	std::vector<unsigned char> &buf = this->m_buffer;
+	unsigned long long footer = (unsigned long long) this->m_ofs.tellp();
+	buf.assign(FOOTER, FOOTER + 4);
+	size_t ncols = this->m_rows.GetColCount();
+	put(buf, (unsigned int) ncols);
+	for (size_t col = 0; col < ncols; ++col)
+	{
+		put_string(buf, this->m_rows.m_vecVarHeadings[col].sVal);
+		buf.push_back(this->m_types[col]);
+	}
+	put(buf, (unsigned int) this->m_offsets.size());
+	for (size_t i = 0; i < this->m_offsets.size(); ++i)
+	{
+		put(buf, this->m_offsets[i]);
+	}
+	put(buf, this->m_nRows);
+	put(buf, footer);
+	buf.insert(buf.end(), MAGIC, MAGIC + 4);
+	this->m_ofs.write((const char *) &buf[0], buf.size());
+
+	// close flushes the buffered tail; a failure there sets failbit
+	this->m_ofs.close();
+	bool ok = !this->m_ofs.fail();
+	this->m_rows.Clear();
+	return ok;
+}
+
+bool CSelectedOutputFile::Read(const char* filename, CSelectedOutput &so, std::string &error)
+{
+	CSelectedOutputFileReader reader;
+	if (!reader.Open(filename, so, error))
+		return false;
+	while (!reader.IsDone())
+	{
+		if (!reader.ReadRowGroup(so, error))
+			return false;
+	}
+	return reader.Close(error);
+}
+
+bool CSelectedOutputFile::WriteTextHeadings(FILE *fp, const CSelectedOutput &so)
+{
+	// tab separated, same number formats as the Fortran interface
+	size_t ncols = so.GetColCount();
+	for (size_t col = 0; col < ncols; ++col)
+	{
+		::fprintf(fp, "%s%s", col ? "\t" : "", so.m_vecVarHeadings[col].sVal);
+	}
+	::fprintf(fp, "\n");
+	return !::ferror(fp);
+}
+
+bool CSelectedOutputFile::WriteTextRows(FILE *fp, const CSelectedOutput &so)
+{
+	size_t ncols = so.GetColCount();
+	for (size_t row = 0; row < so.m_nRowCount; ++row)
+	{
+		for (size_t col = 0; col < ncols; ++col)
+		{
+			VAR v;
+			so.GetCell(col, row, v);
+			if (col)
+				::fputc('\t', fp);
+			switch (v.type)
+			{
+			case TT_LONG:
+				::fprintf(fp, "%ld", v.lVal);
+				break;
+			case TT_DOUBLE:
+				::fprintf(fp, "%23.15e", v.dVal);
+				break;
+			case TT_STRING:
+				::fprintf(fp, "%s", v.sVal);
+				break;
+			default:
+				break;
+			}
+		}
+		::fprintf(fp, "\n");
+	}
+	return !::ferror(fp);
+}
+
+CSelectedOutputFileReader::CSelectedOutputFileReader(void)
+: m_fileSize(0)
+, m_nRowsTotal(0)
+, m_nRowsRead(0)
+, m_nGroup(0)
+{
+}
+
+bool CSelectedOutputFileReader::Open(const char* filename, CSelectedOutput &so, std::string &error)
+{
+	so.Clear();
+	this->m_types.clear();
+	this->m_offsets.clear();
+	this->m_nRowsTotal = this->m_nRowsRead = 0;
+	this->m_nGroup = 0;
+
+	std::ifstream &ifs = this->m_ifs;
+	if (ifs.is_open())
+		ifs.close();
+	ifs.clear();
+	ifs.open(filename, std::ios_base::in | std::ios_base::binary);
+	if (!ifs.is_open())
+	{
+		error = "Unable to open file.";
+		return false;
+	}
+
+	unsigned int version, byte_order;
+	if (!get_magic(ifs, MAGIC) || !get(ifs, version) || !get(ifs, byte_order))
+	{
+		error = "Not a binary selected-output file.";
+		return false;
+	}
+	if (byte_order != ORDER_MARK)
+	{
+		error = "File was written with a different byte order.";
+		return false;
+	}
+	if (version != FILE_VERSION)
+	{
+		error = "Unsupported file version.";
+		return false;
+	}
+
+	// footer; counts and lengths are checked against the file size before anything is allocated
+	unsigned long long footer, &file_size = this->m_fileSize;
+	ifs.seekg(0, std::ios_base::end);
+	file_size = (unsigned long long) ifs.tellg();
+	ifs.seekg(-(std::streamoff) (sizeof(footer) + 4), std::ios_base::end);
+	if (!get(ifs, footer) || !get_magic(ifs, MAGIC) || footer >= file_size ||
+		!ifs.seekg((std::streamoff) footer) || !get_magic(ifs, FOOTER))
+	{
+		error = "Missing footer; the file was not closed.";
+		return false;
+	}
+	unsigned int ncols, ngroups;
+	if (!get(ifs, ncols) || ncols > file_size)
+	{
+		error = "Corrupt footer.";
+		return false;
+	}
+	std::string heading;
+	std::vector<unsigned char> &types = this->m_types;
+	types.resize(ncols);
+	for (unsigned int col = 0; col < ncols; ++col)
+	{
+		if (!get_string(ifs, heading, file_size) || !get(ifs, types[col]) ||
+			(types[col] != CSelectedOutputFile::TYPE_MIXED && !valid_type(types[col], true)))
+		{
+			error = "Corrupt footer.";
+			return false;
+		}
+		so.AddColumn(heading.c_str());
+	}
+	std::vector<unsigned long long> &offsets = this->m_offsets;
+	if (!get(ifs, ngroups) || ngroups > file_size / sizeof(unsigned long long))
+	{
+		error = "Corrupt footer.";
+		return false;
+	}
+	offsets.resize(ngroups);
+	for (unsigned int i = 0; i < ngroups; ++i)
+	{
+		if (!get(ifs, offsets[i]) || offsets[i] >= footer)
+		{
+			error = "Corrupt footer.";
+			return false;
+		}
+	}
+	if (!get(ifs, this->m_nRowsTotal) || this->m_nRowsTotal > file_size)
+	{
+		error = "Corrupt footer.";
+		return false;
+	}
+	return true;
+}
+
+bool CSelectedOutputFileReader::IsDone(void)const
+{
+	return this->m_nGroup == this->m_offsets.size();
+}
+
+bool CSelectedOutputFileReader::ReadRowGroup(CSelectedOutput &so, std::string &error)
+{
+	// appends the next row group to so
+	ASSERT(!this->IsDone());
+	ASSERT(so.GetColCount() == this->m_types.size());
+
+	std::ifstream &ifs = this->m_ifs;
+	unsigned long long file_size = this->m_fileSize;
+	size_t ncols = this->m_types.size();
+	std::vector<std::string> &strings = this->m_strings;
+	std::vector<long> &string_index = this->m_stringIndex;
+	std::vector<unsigned char> &payload = this->m_payload, &plain = this->m_plain;
+
+	unsigned int nrows, gcols, nstrings;
+	if (!ifs.seekg((std::streamoff) this->m_offsets[this->m_nGroup]) || !get_magic(ifs, ROW_GROUP) ||
+		!get(ifs, nrows) || !get(ifs, gcols) || !get(ifs, nstrings) || gcols > ncols ||
+		nrows > this->m_nRowsTotal - this->m_nRowsRead || nstrings > file_size)
+	{
+		error = "Corrupt row group.";
+		return false;
+	}
+	strings.resize(nstrings);
+	string_index.resize(nstrings);
+	for (unsigned int i = 0; i < nstrings; ++i)
+	{
+		if (!get_string(ifs, strings[i], file_size))
+		{
+			error = "Corrupt row group.";
+			return false;
+		}
+		string_index[i] = so.StringIndex(strings[i].c_str());
+	}
+
+	size_t first = so.m_nRowCount;
+	for (unsigned int col = 0; col < gcols; ++col)
+	{
+		unsigned char encoding;
+		unsigned long long size;
+		if (!get(ifs, encoding) || !get(ifs, size) || size > file_size)
+		{
+			error = "Corrupt column.";
+			return false;
+		}
+		payload.resize((size_t) size);
+		if (size && !ifs.read((char *) &payload[0], (std::streamsize) size))
+		{
+			error = "Corrupt column.";
+			return false;
+		}
+
+		const unsigned char *p = payload.empty() ? NULL : &payload[0];
+		size_t plain_size = (size_t) nrows + 8 * (size_t) nrows + 1;
+		if (encoding == ENCODING_PACKED)
+		{
+			// undo PackBits, then the shuffle
+			std::vector<unsigned char> shuffled(plain_size + 8 * (size_t) nrows);
+			size_t pos = nrows + 8 * (size_t) nrows, written = 0;
+			if (!unpack_bits(p, payload.size(), &shuffled[0], shuffled.size(), written) ||
+				written != (shuffled[pos] ? shuffled.size() : plain_size))
+			{
+				error = "Corrupt packed column.";
+				return false;
+			}
+			plain_size = written;
+			plain.resize(plain_size);
+			memcpy(&plain[0], &shuffled[0], nrows);
+			unshuffle(&shuffled[nrows], nrows, &plain[nrows]);
+			plain[pos] = shuffled[pos];
+			if (shuffled[pos])
+				unshuffle(&shuffled[pos + 1], nrows, &plain[pos + 1]);
+			p = &plain[0];
+		}
+		else if (encoding != ENCODING_PLAIN || payload.size() < plain_size ||
+			payload.size() != plain_size + (p[plain_size - 1] ? 8 * (size_t) nrows : 0))
+		{
+			error = "Corrupt column.";
+			return false;
+		}
+
+		// the longs flag must be 0 or 1, and every type must be consistent with it and the footer
+		unsigned char has_longs = p[nrows + 8 * (size_t) nrows];
+		if (has_longs > 1)
+		{
+			error = "Corrupt column.";
+			return false;
+		}
+		unsigned char type = this->m_types[col];
+		for (size_t i = 0; i < nrows; ++i)
+		{
+			if (!valid_type(p[i], has_longs != 0) ||
+				(p[i] != TT_EMPTY && type != CSelectedOutputFile::TYPE_MIXED && p[i] != type))
+			{
+				error = "Corrupt column types.";
+				return false;
+			}
+		}
+
+		CSelectedOutput::Column &c = so.m_columns[col];
+		c.types.insert(c.types.end(), p, p + nrows);
+		// the doubles follow nrows type bytes, so they need not be aligned
+		c.doubles.resize(first + nrows);
+		if (nrows)
+		{
+			memcpy(&c.doubles[first], p + nrows, 8 * (size_t) nrows);
+		}
+		if (has_longs)
+		{
+			const unsigned char *l = p + nrows + 8 * (size_t) nrows + 1;
+			if (c.longs.empty())
+				c.longs.resize(first, 0);
+			for (size_t i = 0; i < nrows; ++i)
+			{
+				long long v;
+				memcpy(&v, l + 8 * i, 8);
+				if (c.types[first + i] == TT_STRING)
+				{
+					if ((size_t) v >= string_index.size())
+					{
+						error = "Corrupt string column.";
+						return false;
+					}
+					v = string_index[(size_t) v];
+				}
+				c.longs.push_back((long) v);
+			}
+		}
+		else if (!c.longs.empty())
+		{
+			c.longs.resize(first + nrows, 0);
+		}
+	}
+	so.m_nRowCount += nrows;
+	so.FillRows();
+	this->m_nRowsRead += nrows;
+	++this->m_nGroup;
+	return true;
+}
+
+bool CSelectedOutputFileReader::Close(std::string &error)
+{
+	bool ok = this->IsDone() && this->m_nRowsRead == this->m_nRowsTotal;
+	if (!ok)
+	{
+		error = "Row count does not match footer.";
+	}
+	this->m_ifs.close();
+	return ok;
+}
@@ -0,0 +1,99 @@
+// CSelectedOutputFile.hxx: interface for the CSelectedOutputFile class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined _INC_SELECTEDOUTPUTFILE_H
+#define _INC_SELECTEDOUTPUTFILE_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdio.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "CSelectedOutput.hxx"
+
+//
+// Binary columnar selected-output file (native byte order)
+//
+//   header     "PQSO", uint32 version, uint32 0x01020304 (byte order)
+//   row groups "PQRG", uint32 nrows, uint32 ncols, uint32 nstrings,
+//              nstrings x (uint32 length, chars),
+//              ncols x (uint8 encoding, uint64 size, payload)
+//   footer     "PQFT", uint32 ncols, ncols x (uint32 length, chars, uint8 type),
+//              uint32 ngroups, ngroups x uint64 offset, uint64 nrows
+//   trailer    uint64 footer offset, "PQSO"
+//
+// A plain (encoding 0) column payload is uint8 types[nrows], double values[nrows],
+// uint8 has_longs and, if has_longs, int64 longs[nrows] (see CSelectedOutput::Column).
+// A packed (encoding 1) payload has the doubles and longs xor'ed with the previous
+// row and byte shuffled, and is then run-length encoded (PackBits).
+// Column names and types are kept in the footer because USER_PUNCH headings can
+// be added after the first rows; a row group may have fewer columns than the footer.
+// The column type is the VAR_TYPE of every non-empty value, TYPE_MIXED otherwise.
+//
+class CSelectedOutputFile
+{
+public:
+	CSelectedOutputFile(void);
+	~CSelectedOutputFile(void);
+
+	bool Open(const char* filename);
+	bool Close(void);
+	bool IsOpen(void)const;
+	bool AddRow(const std::vector<const char*> &headings, const std::vector<VAR> &values);
+
+	// loads every row group; see CSelectedOutputFileReader to read one group at a time
+	static bool Read(const char* filename, CSelectedOutput &so, std::string &error);
+	static bool WriteTextHeadings(FILE *fp, const CSelectedOutput &so);
+	static bool WriteTextRows(FILE *fp, const CSelectedOutput &so);
+
+	static const unsigned char TYPE_MIXED = 0xFF;
+	static const size_t ROW_GROUP_SIZE = 4096;
+
+protected:
+	bool WriteRowGroup(void);
+
+	std::ofstream m_ofs;
+	CSelectedOutput m_rows;              // current row group
+	std::vector<unsigned char> m_types;  // column types
+	std::vector<unsigned long long> m_offsets;
+	unsigned long long m_nRows;
+	std::vector<unsigned char> m_buffer;
+	std::vector<unsigned char> m_packed;
+};
+
+//
+// Reads a binary selected-output file one row group at a time
+//
+//   Open          checks the header, reads the footer and adds the columns to so
+//   ReadRowGroup  appends the next row group to so (call so.ClearRows() to drop the previous one)
+//   Close         checks that every row listed in the footer was read
+//
+class CSelectedOutputFileReader
+{
+public:
+	CSelectedOutputFileReader(void);
+
+	bool Open(const char* filename, CSelectedOutput &so, std::string &error);
+	bool IsDone(void)const;
+	bool ReadRowGroup(CSelectedOutput &so, std::string &error);
+	bool Close(std::string &error);
+
+protected:
+	std::ifstream m_ifs;
+	unsigned long long m_fileSize;
+	unsigned long long m_nRowsTotal;
+	unsigned long long m_nRowsRead;
+	std::vector<unsigned char> m_types;  // column types from the footer
+	std::vector<unsigned long long> m_offsets;
+	size_t m_nGroup;                     // next row group
+	std::vector<std::string> m_strings;
+	std::vector<long> m_stringIndex;
+	std::vector<unsigned char> m_payload;
+	std::vector<unsigned char> m_plain;
+};
+
+#endif // !defined(_INC_SELECTEDOUTPUTFILE_H)
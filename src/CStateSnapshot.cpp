@@ -0,0 +1,222 @@
+// CStateSnapshot.cpp: implementation of the CStateSnapshot class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <string.h>                 // memcpy
+
+#include "CStateSnapshot.hxx"       // CStateSnapshot
+
+static const char MAGIC[4]       = { 'P', 'Q', 'S', 'T' };
+static const unsigned int FILE_VERSION = 3;
+static const unsigned int FLAG_DELTA = 0x1;
+static const unsigned int ORDER_MARK = 0x01020304;
+
+template <typename T>
+static void put(std::vector<unsigned char> &buf, const T &value)
+{
+	const unsigned char *p = (const unsigned char *) &value;
+	buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+static unsigned long long fnv1a(const unsigned char *data, size_t size)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	for (size_t i = 0; i < size; ++i)
+	{
+		h ^= data[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+//
+// bounds-checked reader over the snapshot bytes
+//
+class SnapshotReader
+{
+public:
+	SnapshotReader(const unsigned char *data, size_t size)
+		: p(data), end(data + size) {}
+
+	template <typename T>
+	bool get(T &value)
+	{
+		if ((size_t)(this->end - this->p) < sizeof(T))
+			return false;
+		memcpy(&value, this->p, sizeof(T));
+		this->p += sizeof(T);
+		return true;
+	}
+
+	template <typename T>
+	bool get_array(std::vector<T> &values)
+	{
+		unsigned long long n;
+		if (!this->get(n) || n > (unsigned long long)(this->end - this->p) / sizeof(T))
+			return false;
+		values.resize((size_t) n);
+		if (n)
+		{
+			memcpy(&values[0], this->p, (size_t) n * sizeof(T));
+			this->p += (size_t) n * sizeof(T);
+		}
+		return true;
+	}
+
+	bool get_string(std::string &str)
+	{
+		unsigned int l;
+		if (!this->get(l) || l > (size_t)(this->end - this->p))
+			return false;
+		str.assign((const char *) this->p, l);
+		this->p += l;
+		return true;
+	}
+
+	const unsigned char *p;
+	const unsigned char *end;
+};
+
+CStateSnapshot::CStateSnapshot(void)
+: m_delta(false)
+, m_model(0)
+{
+}
+
+CStateSnapshot::~CStateSnapshot(void)
+{
+}
+
+unsigned long long CStateSnapshot::Hash(const void *data, size_t size)
+{
+	return fnv1a((const unsigned char *) data, size);
+}
+
+void CStateSnapshot::Write(std::vector<unsigned char> &buffer)const
+{
+	buffer.clear();
+	buffer.reserve(64 + (this->m_ints.size() + this->m_cells.size()) * sizeof(int) + this->m_doubles.size() * sizeof(double));
+	buffer.assign(MAGIC, MAGIC + 4);
+	put(buffer, FILE_VERSION);
+	put(buffer, ORDER_MARK);
+	put(buffer, this->m_model);
+
+	put(buffer, (unsigned int) this->m_words.size());
+	for (size_t i = 0; i < this->m_words.size(); ++i)
+	{
+		put(buffer, (unsigned int) this->m_words[i].size());
+		buffer.insert(buffer.end(), this->m_words[i].begin(), this->m_words[i].end());
+	}
+
+	put(buffer, (unsigned long long) this->m_ints.size());
+	if (this->m_ints.size())
+	{
+		const unsigned char *p = (const unsigned char *) &this->m_ints[0];
+		buffer.insert(buffer.end(), p, p + this->m_ints.size() * sizeof(int));
+	}
+	put(buffer, (unsigned long long) this->m_doubles.size());
+	if (this->m_doubles.size())
+	{
+		const unsigned char *p = (const unsigned char *) &this->m_doubles[0];
+		buffer.insert(buffer.end(), p, p + this->m_doubles.size() * sizeof(double));
+	}
+
+	put(buffer, this->m_delta ? FLAG_DELTA : 0u);
+	put(buffer, (unsigned long long) this->m_cells.size());
+	if (this->m_cells.size())
+	{
+		const unsigned char *p = (const unsigned char *) &this->m_cells[0];
+		buffer.insert(buffer.end(), p, p + this->m_cells.size() * sizeof(int));
+	}
+
+	put(buffer, fnv1a(&buffer[0], buffer.size()));
+}
+
+bool CStateSnapshot::Read(const unsigned char *data, size_t size, std::string &error)
+{
+	unsigned long long hash;
+	if (!data || size < 4 + sizeof(hash) || memcmp(data, MAGIC, 4) != 0)
+	{
+		error = "Not a state snapshot";
+		return false;
+	}
+	memcpy(&hash, data + size - sizeof(hash), sizeof(hash));
+	if (hash != fnv1a(data, size - sizeof(hash)))
+	{
+		error = "State snapshot is truncated or corrupt";
+		return false;
+	}
+
+	SnapshotReader reader(data + 4, size - 4 - sizeof(hash));
+	unsigned int version, order;
+	if (!reader.get(version) || !reader.get(order))
+	{
+		error = "State snapshot is truncated or corrupt";
+		return false;
+	}
+	if (order != ORDER_MARK)
+	{
+		error = "State snapshot was written with a different byte order";
+		return false;
+	}
+	if (version != FILE_VERSION)
+	{
+		error = "Unknown state snapshot version";
+		return false;
+	}
+
+	unsigned int nwords;
+	bool ok = reader.get(this->m_model) && reader.get(nwords);
+	this->m_words.clear();
+	for (unsigned int i = 0; ok && i < nwords; ++i)
+	{
+		std::string word;
+		ok = reader.get_string(word);
+		this->m_words.push_back(word);
+	}
+	ok = ok && reader.get_array(this->m_ints) && reader.get_array(this->m_doubles);
+	unsigned int flags = 0;
+	this->m_cells.clear();
+	ok = ok && reader.get(flags) && reader.get_array(this->m_cells);
+	this->m_delta = (flags & FLAG_DELTA) != 0;
+	if (!ok || reader.p != reader.end)
+	{
+		error = "State snapshot is truncated or corrupt";
+		return false;
+	}
+	return true;
+}
+
+bool CStateSnapshot::WriteFile(const std::vector<unsigned char> &buffer, const char *filename)
+{
+	std::ofstream ofs(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!ofs.is_open())
+	{
+		return false;
+	}
+	if (buffer.size())
+	{
+		ofs.write((const char *) &buffer[0], buffer.size());
+	}
+	ofs.close();
+	return !ofs.fail();
+}
+
+bool CStateSnapshot::ReadFile(const char *filename, std::vector<unsigned char> &buffer)
+{
+	std::ifstream ifs(filename, std::ios_base::in | std::ios_base::binary);
+	if (!ifs.is_open())
+	{
+		return false;
+	}
+	ifs.seekg(0, std::ios_base::end);
+	std::streamoff size = ifs.tellg();
+	ifs.seekg(0, std::ios_base::beg);
+	if (size < 0)
+	{
+		return false;
+	}
+	buffer.resize((size_t) size);
+	return size == 0 || (bool) ifs.read((char *) &buffer[0], size);
+}
@@ -0,0 +1,68 @@
+// CStateSnapshot.hxx: interface for the CStateSnapshot class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined _INC_STATESNAPSHOT_H
+#define _INC_STATESNAPSHOT_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+//
+// Binary snapshot of reaction entities packed by Serializer (native byte order)
+//
+//   header     "PQST", uint32 version, uint32 0x01020304 (byte order),
+//              uint64 model hash
+//   dictionary uint32 nwords, nwords x (uint32 length, chars)
+//   ints       uint64 nints, nints x int32
+//   doubles    uint64 ndoubles, ndoubles x double
+//   cells      uint32 flags, uint64 ncells, ncells x int32
+//   trailer    uint64 FNV-1a hash of all preceding bytes
+//
+// Packed solutions refer to aqueous species by their index in the model,
+// so a hash of the species and master species names, in model order, is
+// kept and checked before the snapshot is unpacked.
+//
+// A delta snapshot (flags bit 0) lists the user numbers that changed since
+// the previous export; entities at those numbers that are not in the
+// snapshot were deleted.
+//
+class CStateSnapshot
+{
+public:
+	CStateSnapshot(void);
+	~CStateSnapshot(void);
+
+	void Write(std::vector<unsigned char> &buffer)const;
+	bool Read(const unsigned char *data, size_t size, std::string &error);
+
+	static bool WriteFile(const std::vector<unsigned char> &buffer, const char *filename);
+	static bool ReadFile(const char *filename, std::vector<unsigned char> &buffer);
+
+	std::vector<std::string> &GetWords(void) {return this->m_words;}
+	std::vector<int> &GetInts(void) {return this->m_ints;}
+	std::vector<double> &GetDoubles(void) {return this->m_doubles;}
+	std::vector<int> &GetCells(void) {return this->m_cells;}
+
+	void SetDelta(bool bDelta) {this->m_delta = bDelta;}
+	bool IsDelta(void)const {return this->m_delta;}
+
+	void SetModel(unsigned long long model) {this->m_model = model;}
+	bool IsModel(unsigned long long model)const {return this->m_model == model;}
+
+	static unsigned long long Hash(const void *data, size_t size);
+
+protected:
+	std::vector<std::string> m_words;
+	std::vector<int> m_ints;
+	std::vector<double> m_doubles;
+	std::vector<int> m_cells;
+	bool m_delta;
+	unsigned long long m_model;
+};
+
+#endif // !defined(_INC_STATESNAPSHOT_H)
@@ -8,10 +8,41 @@
 
 #include "Debug.h"                      // ASSERT
 #include "ErrorReporter.hxx"            // CErrorReporter
+#include "CInputTemplate.hxx"           // CInputTemplate
 #include "CSelectedOutput.hxx"          // CSelectedOutput
+#include "CSelectedOutputFile.hxx"      // CSelectedOutputFile
+#include "CStateSnapshot.hxx"           // CStateSnapshot
+#include "Serializer.h"                 // Serializer
 #include "SelectedOutput.h"             // SelectedOutput
 #include "dumper.h"                     // dumper
 
+//
+// read-only stream over a copy of a registered virtual file, so the file
+// may be registered again while the stream is open
+//
+class VirtualFileBuf : public std::streambuf
+{
+public:
+	VirtualFileBuf(const std::string& data)
+	: m_data(data)
+	{
+		char* p = this->m_data.empty() ? 0 : &this->m_data[0];
+		this->setg(p, p, p + this->m_data.size());
+	}
+protected:
+	std::string m_data;
+};
+
+class VirtualFileStream : private VirtualFileBuf, public std::istream
+{
+public:
+	VirtualFileStream(const std::string& data)
+	: VirtualFileBuf(data)
+	, std::istream(static_cast<VirtualFileBuf*>(this))
+	{
+	}
+};
+
 // statics
 std::map<size_t, IPhreeqc*> IPhreeqc::Instances;
 size_t IPhreeqc::InstancesIndex = 0;
@@ -30,6 +61,7 @@ IPhreeqc::IPhreeqc(void)
 , ErrorFileOn(false)
 , DumpOn(false)
 , DumpStringOn(false)
+, DeltaExportOn(false)
 , OutputStringOn(false)
 , LogStringOn(false)
 , ErrorStringOn(true)
@@ -37,6 +69,9 @@ IPhreeqc::IPhreeqc(void)
 , WarningStringOn(true)
 , WarningReporter(0)
 , CurrentSelectedOutputUserNumber(1)
+, SelectedOutputCallback(0)
+, SelectedOutputCookie(0)
+, RunGeneration(0)
 , PhreeqcPtr(0)
 , input_file(0)
 , database_file(0)
@@ -72,6 +107,7 @@ IPhreeqc::~IPhreeqc(void)
 #if !defined(NDEBUG)
 	this->OutputFileOn = false;
 #endif
+	this->close_binary_files();
 	delete this->PhreeqcPtr;
 	delete this->WarningReporter;
 	delete this->ErrorReporter;
@@ -83,6 +119,13 @@ IPhreeqc::~IPhreeqc(void)
 	}
 	this->SelectedOutputMap.clear();
 
+	std::vector< CInputTemplate* >::iterator tit = this->Templates.begin();
+	for (; tit != this->Templates.end(); ++tit)
+	{
+		delete (*tit);
+	}
+	this->Templates.clear();
+
 	mutex_lock(&map_lock);
 	std::map<size_t, IPhreeqc*>::iterator it = IPhreeqc::Instances.find(this->Index);
 	if (it != IPhreeqc::Instances.end())
@@ -163,6 +206,11 @@ int IPhreeqc::GetCurrentSelectedOutputUserNumber(void)const
 	return this->CurrentSelectedOutputUserNumber;
 }
 
+bool IPhreeqc::GetDeltaExportOn(void)const
+{
+	return this->DeltaExportOn;
+}
+
 const char* IPhreeqc::GetDumpFileName(void)const
 {
 	return this->DumpFileName.c_str();
@@ -185,17 +233,12 @@ const char* IPhreeqc::GetDumpString(void)const
 
 const char* IPhreeqc::GetDumpStringLine(int n)
 {
-	static const char empty[] = "";
-	if (n < 0 || n >= this->GetDumpStringLineCount())
-	{
-		return empty;
-	}
-	return this->DumpLines[n].c_str();
+	return this->DumpLines.GetLine(n);
 }
 
 int IPhreeqc::GetDumpStringLineCount(void)const
 {
-	return (int)this->DumpLines.size();
+	return this->DumpLines.GetCount();
 }
 
 bool IPhreeqc::GetDumpStringOn(void)const
@@ -236,17 +279,12 @@ const char* IPhreeqc::GetErrorString(void)
 
 const char* IPhreeqc::GetErrorStringLine(int n)
 {
-	static const char empty[] = "";
-	if (n < 0 || n >= this->GetErrorStringLineCount())
-	{
-		return empty;
-	}
-	return this->ErrorLines[n].c_str();
+	return this->ErrorLines.GetLine(n);
 }
 
 int IPhreeqc::GetErrorStringLineCount(void)const
 {
-	return (int)this->ErrorLines.size();
+	return this->ErrorLines.GetCount();
 }
 
 bool IPhreeqc::GetErrorStringOn(void)const
@@ -281,17 +319,12 @@ const char* IPhreeqc::GetLogString(void)const
 
 const char* IPhreeqc::GetLogStringLine(int n)const
 {
-	static const char empty[] = "";
-	if (n < 0 || n >= this->GetLogStringLineCount())
-	{
-		return empty;
-	}
-	return this->LogLines[n].c_str();
+	return this->LogLines.GetLine(n);
 }
 
 int IPhreeqc::GetLogStringLineCount(void)const
 {
-	return (int)this->LogLines.size();
+	return this->LogLines.GetCount();
 }
 
 bool IPhreeqc::GetLogStringOn(void)const
@@ -336,17 +369,17 @@ const char* IPhreeqc::GetOutputString(void)const
 
 const char* IPhreeqc::GetOutputStringLine(int n)const
 {
-	static const char empty[] = "";
-	if (n < 0 || n >= this->GetOutputStringLineCount())
-	{
-		return empty;
-	}
-	return this->OutputLines[n].c_str();
+	return this->OutputLines.GetLine(n);
 }
 
 int IPhreeqc::GetOutputStringLineCount(void)const
 {
-	return (int)this->OutputLines.size();
+	return this->OutputLines.GetCount();
+}
+
+int IPhreeqc::GetOutputLines(int start, int count, const char** lines)const
+{
+	return this->OutputLines.GetLines(start, count, lines);
 }
 
 bool IPhreeqc::GetOutputStringOn(void)const
@@ -364,6 +397,132 @@ int IPhreeqc::GetSelectedOutputColumnCount(void)const
 	return 0;
 }
 
+VRESULT IPhreeqc::GetSelectedOutputColumn(int col, double* values, int n, int* rows)
+{
+	VRESULT v;
+	this->ErrorReporter->Clear();
+
+	std::map< int, CSelectedOutput* >::const_iterator ci = this->SelectedOutputMap.find(this->CurrentSelectedOutputUserNumber);
+	if (ci != this->SelectedOutputMap.end())
+	{
+		v = (*ci).second->GetColumn(col, values, n, rows);
+		switch (v)
+		{
+		case VR_OK:
+			break;
+		case VR_INVALIDCOL:
+			this->AddError("GetSelectedOutputColumn: VR_INVALIDCOL Column index out of range.\n");
+			this->update_errors();
+			break;
+		case VR_INVALIDARG:
+			this->AddError("GetSelectedOutputColumn: VR_INVALIDARG values is NULL or n is negative.\n");
+			this->update_errors();
+			break;
+		default:
+			assert(0);
+		}
+	}
+	else
+	{
+		char buffer[120];
+		v = VR_INVALIDARG;
+		::sprintf(buffer, "GetSelectedOutputColumn: VR_INVALIDARG Invalid selected-output user number %d.\n", this->CurrentSelectedOutputUserNumber);
+		this->AddError(buffer);
+		this->update_errors();
+	}
+	return v;
+}
+
+const char* IPhreeqc::GetSelectedOutputBinaryFileName(void)const
+{
+	static const char empty[] = "";
+	std::map< int, std::string >::const_iterator ci = this->SelectedOutputBinaryFileNameMap.find(this->CurrentSelectedOutputUserNumber);
+	if (ci != this->SelectedOutputBinaryFileNameMap.end())
+	{
+		return (*ci).second.c_str();
+	}
+	return empty;
+}
+
+int IPhreeqc::LoadSelectedOutputBinaryFile(const char *filename)
+{
+	this->ErrorReporter->Clear();
+
+	CSelectedOutput* so = new CSelectedOutput();
+	std::string error;
+	if (!CSelectedOutputFile::Read(filename, *so, error))
+	{
+		delete so;
+		std::ostringstream oss;
+		oss << "LoadSelectedOutputBinaryFile: " << error << " \"" << filename << "\".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+
+	std::map< int, CSelectedOutput* >::iterator it = this->SelectedOutputMap.find(this->CurrentSelectedOutputUserNumber);
+	if (it != this->SelectedOutputMap.end())
+	{
+		delete (*it).second;
+		(*it).second = so;
+	}
+	else
+	{
+		this->SelectedOutputMap[this->CurrentSelectedOutputUserNumber] = so;
+	}
+	return 0;
+}
+
+int IPhreeqc::ConvertSelectedOutputBinaryFile(const char *binary_filename, const char *text_filename)
+{
+	this->ErrorReporter->Clear();
+
+	// one row group in memory at a time
+	CSelectedOutputFileReader reader;
+	CSelectedOutput so;
+	std::string error;
+	bool read_ok = reader.Open(binary_filename, so, error);
+	bool write_ok = true;
+	FILE *fp = NULL;
+	if (read_ok)
+	{
+		fp = ::fopen(text_filename, "w");
+		write_ok = fp && CSelectedOutputFile::WriteTextHeadings(fp, so);
+	}
+	while (read_ok && write_ok && !reader.IsDone())
+	{
+		so.ClearRows();
+		read_ok = reader.ReadRowGroup(so, error);
+		write_ok = !read_ok || CSelectedOutputFile::WriteTextRows(fp, so);
+	}
+	if (read_ok && write_ok)
+	{
+		read_ok = reader.Close(error);
+	}
+	if (fp && ::fclose(fp) != 0)
+	{
+		write_ok = false;
+	}
+
+	if (!read_ok)
+	{
+		std::ostringstream oss;
+		oss << "ConvertSelectedOutputBinaryFile: " << error << " \"" << binary_filename << "\".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	if (!write_ok)
+	{
+		std::ostringstream oss;
+		oss << "ConvertSelectedOutputBinaryFile: Unable to write \"" << text_filename << "\".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	return 0;
+}
+
 int IPhreeqc::GetSelectedOutputCount(void)const
 {
 	ASSERT(this->PhreeqcPtr->SelectedOutput_map.size() == this->SelectedOutputMap.size());
@@ -415,21 +574,20 @@ const char* IPhreeqc::GetSelectedOutputString(void)const
 const char* IPhreeqc::GetSelectedOutputStringLine(int n)
 {
 	static const char empty[] = "";
-	if (n < 0 || n >= this->GetSelectedOutputStringLineCount())
+	std::map< int, CLineIndex >::const_iterator cit = this->SelectedOutputLinesMap.find(this->CurrentSelectedOutputUserNumber);
+	if (cit != this->SelectedOutputLinesMap.end())
 	{
-		return empty;
+		return (*cit).second.GetLine(n);
 	}
-	// don't need to check CurrentSelectedOutputUserNumber since
-	// GetSelectedOutputStringLineCount will catch
-	return this->SelectedOutputLinesMap[this->CurrentSelectedOutputUserNumber][n].c_str();
+	return empty;
 }
 
 int IPhreeqc::GetSelectedOutputStringLineCount(void)const
 {
-	std::map< int, std::vector < std::string > >::const_iterator cit = this->SelectedOutputLinesMap.find(this->CurrentSelectedOutputUserNumber);
+	std::map< int, CLineIndex >::const_iterator cit = this->SelectedOutputLinesMap.find(this->CurrentSelectedOutputUserNumber);
 	if (cit != this->SelectedOutputLinesMap.end())
 	{
-		return (int) (*cit).second.size();
+		return (*cit).second.GetCount();
 	}
 	return 0;
 }
@@ -545,17 +703,12 @@ const char* IPhreeqc::GetWarningString(void)
 
 const char* IPhreeqc::GetWarningStringLine(int n)
 {
-	static const char empty[] = "";
-	if (n < 0 || n >= this->GetWarningStringLineCount())
-	{
-		return empty;
-	}
-	return this->WarningLines[n].c_str();
+	return this->WarningLines.GetLine(n);
 }
 
 int IPhreeqc::GetWarningStringLineCount(void)const
 {
-	return (int)this->WarningLines.size();
+	return this->WarningLines.GetCount();
 }
 
 std::list< std::string > IPhreeqc::ListComponents(void)
@@ -585,10 +738,13 @@ int IPhreeqc::load_db(const char* filename)
 
 		// open file
 		//
-		std::ifstream ifs;
-		ifs.open(filename);
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1600)
+		std::unique_ptr<std::istream> is(this->open_include(filename));
+#else
+		std::auto_ptr<std::istream> is(this->open_include(filename));
+#endif
 
-		if (!ifs.is_open())
+		if (!is.get())
 		{
 			std::ostringstream oss;
 			oss << "LoadDatabase: Unable to open:" << "\"" << filename << "\".";
@@ -598,7 +754,7 @@ int IPhreeqc::load_db(const char* filename)
 		// read input
 		//
 		ASSERT(this->PhreeqcPtr->phrq_io->get_istream() == NULL);
-		this->PhreeqcPtr->phrq_io->push_istream(&ifs, false);
+		this->PhreeqcPtr->phrq_io->push_istream(is.get(), false);
 		this->PhreeqcPtr->read_database();
 	}
 	catch (const IPhreeqcStop&)
@@ -732,6 +888,22 @@ void IPhreeqc::OutputWarningString(void)
 #endif
 }
 
+VRESULT IPhreeqc::RegisterVirtualFile(const char* name, const char* data, int len)
+{
+	if (!name || !::strlen(name))
+	{
+		return VR_INVALIDARG;
+	}
+	if (!data)
+	{
+		this->VirtualFiles.erase(name);
+		return VR_OK;
+	}
+	size_t n = (len < 0) ? ::strlen(data) : (size_t)len;
+	this->VirtualFiles[name].assign(data, n);
+	return VR_OK;
+}
+
 int IPhreeqc::RunAccumulated(void)
 {
 	static const char *sz_routine = "RunAccumulated";
@@ -863,6 +1035,186 @@ int IPhreeqc::RunFile(const char* filename)
 	return this->PhreeqcPtr->get_input_errors();
 }
 
+int IPhreeqc::CreateTemplate(const char* input)
+{
+	if (!input)
+	{
+		return -1;
+	}
+	this->Templates.push_back(new CInputTemplate(input));
+	return (int)this->Templates.size() - 1;
+}
+
+int IPhreeqc::GetTemplateSlotCount(int t)const
+{
+	if (t < 0 || t >= (int)this->Templates.size())
+	{
+		return -1;
+	}
+	return (int)this->Templates[t]->GetSlotCount();
+}
+
+const char* IPhreeqc::GetTemplateSlotName(int t, int slot)const
+{
+	static const char empty[] = "";
+	if (t < 0 || t >= (int)this->Templates.size() || slot < 0)
+	{
+		return empty;
+	}
+	const char* name = this->Templates[t]->GetSlotName((size_t)slot);
+	return name ? name : empty;
+}
+
+int IPhreeqc::RunTemplate(int t, const double* values)
+{
+	if (t < 0 || t >= (int)this->Templates.size() || (!values && this->Templates[t]->GetSlotCount()))
+	{
+		this->ErrorReporter->Clear();
+		this->AddError("RunTemplate: Invalid template or values.\n");
+		this->update_errors();
+		return 1;
+	}
+
+	CInputTemplate* pt = this->Templates[t];
+	bool bAll = (pt->GetGeneration() == 0 || pt->GetGeneration() != this->RunGeneration);
+	pt->Expand(values, bAll, this->TemplateInput);
+
+	int n = this->RunString(this->TemplateInput.c_str());
+
+	// the definitions are known to be in place only after a clean run
+	pt->SetGeneration((n == 0) ? this->RunGeneration : 0);
+	return n;
+}
+
+int IPhreeqc::SaveState(int start, int end, const char* filename)
+{
+	std::vector< unsigned char > buffer;
+	if (this->save_state("SaveState", start, end, buffer))
+	{
+		return 1;
+	}
+	if (!filename || !CStateSnapshot::WriteFile(buffer, filename))
+	{
+		std::ostringstream oss;
+		oss << "SaveState: Unable to write \"" << (filename ? filename : "") << "\".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	this->clear_exported(start, end);
+	return 0;
+}
+
+int IPhreeqc::LoadState(const char* filename)
+{
+	std::vector< unsigned char > buffer;
+	if (!filename || !CStateSnapshot::ReadFile(filename, buffer))
+	{
+		this->ErrorReporter->Clear();
+		std::ostringstream oss;
+		oss << "LoadState: Unable to open \"" << (filename ? filename : "") << "\".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	return this->load_state("LoadState", buffer.size() ? &buffer[0] : NULL, buffer.size());
+}
+
+int IPhreeqc::SaveStateBuffer(int start, int end)
+{
+	if (this->save_state("SaveStateBuffer", start, end, this->StateBuffer))
+	{
+		return 1;
+	}
+	this->clear_exported(start, end);
+	return 0;
+}
+
+const void* IPhreeqc::GetStateBuffer(void)const
+{
+	return this->StateBuffer.size() ? &this->StateBuffer[0] : NULL;
+}
+
+int IPhreeqc::GetStateBufferSize(void)const
+{
+	return (int)this->StateBuffer.size();
+}
+
+int IPhreeqc::LoadStateBuffer(const void* buffer, int size)
+{
+	return this->load_state("LoadStateBuffer", (const unsigned char*)buffer, (size > 0) ? (size_t)size : 0);
+}
+
+const void* IPhreeqc::GetSolutionBlob(int n_user, int* size)
+{
+	return this->get_blob("GetSolutionBlob", Serializer::PT_SOLUTION, n_user, size);
+}
+
+int IPhreeqc::SetSolutionBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetSolutionBlob", Serializer::PT_SOLUTION, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetExchangeBlob(int n_user, int* size)
+{
+	return this->get_blob("GetExchangeBlob", Serializer::PT_EXCHANGE, n_user, size);
+}
+
+int IPhreeqc::SetExchangeBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetExchangeBlob", Serializer::PT_EXCHANGE, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetSurfaceBlob(int n_user, int* size)
+{
+	return this->get_blob("GetSurfaceBlob", Serializer::PT_SURFACES, n_user, size);
+}
+
+int IPhreeqc::SetSurfaceBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetSurfaceBlob", Serializer::PT_SURFACES, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetGasPhaseBlob(int n_user, int* size)
+{
+	return this->get_blob("GetGasPhaseBlob", Serializer::PT_GASPHASE, n_user, size);
+}
+
+int IPhreeqc::SetGasPhaseBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetGasPhaseBlob", Serializer::PT_GASPHASE, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetEquilibriumPhasesBlob(int n_user, int* size)
+{
+	return this->get_blob("GetEquilibriumPhasesBlob", Serializer::PT_PPASSEMBLAGE, n_user, size);
+}
+
+int IPhreeqc::SetEquilibriumPhasesBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetEquilibriumPhasesBlob", Serializer::PT_PPASSEMBLAGE, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetSolidSolutionsBlob(int n_user, int* size)
+{
+	return this->get_blob("GetSolidSolutionsBlob", Serializer::PT_SSASSEMBLAGE, n_user, size);
+}
+
+int IPhreeqc::SetSolidSolutionsBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetSolidSolutionsBlob", Serializer::PT_SSASSEMBLAGE, n_user, blob, size);
+}
+
+const void* IPhreeqc::GetKineticsBlob(int n_user, int* size)
+{
+	return this->get_blob("GetKineticsBlob", Serializer::PT_KINETICS, n_user, size);
+}
+
+int IPhreeqc::SetKineticsBlob(int n_user, const void* blob, int size)
+{
+	return this->set_blob("SetKineticsBlob", Serializer::PT_KINETICS, n_user, blob, size);
+}
+
 int IPhreeqc::RunString(const char* input)
 {
 	static const char *sz_routine = "RunString";
@@ -930,6 +1282,12 @@ void IPhreeqc::SetBasicCallback(double (*fcn)(double x1, double x2, const char *
 {
 	this->PhreeqcPtr->register_basic_callback(fcn, cookie1);
 }
+void IPhreeqc::SetSelectedOutputCallback(PFN_SELECTED_OUTPUT_CALLBACK fcn, void *cookie)
+{
+	this->SelectedOutputCallback = fcn;
+	this->SelectedOutputCookie = cookie;
+}
+
 #ifdef IPHREEQC_NO_FORTRAN_MODULE
 void IPhreeqc::SetBasicFortranCallback(double (*fcn)(double *x1, double *x2, char *str, size_t l))
 {
@@ -951,6 +1309,12 @@ VRESULT IPhreeqc::SetCurrentSelectedOutputUserNumber(int n)
 	return VR_INVALIDARG;
 }
 
+void IPhreeqc::SetDeltaExportOn(bool bValue)
+{
+	this->DeltaExportOn = bValue;
+	this->PhreeqcPtr->Set_delta_export(bValue);
+}
+
 void IPhreeqc::SetDumpFileName(const char *filename)
 {
 	if (filename && ::strlen(filename))
@@ -1039,6 +1403,18 @@ void IPhreeqc::SetSelectedOutputFileName(const char *filename)
 	}
 }
 
+void IPhreeqc::SetSelectedOutputBinaryFileName(const char *filename)
+{
+	if (filename && ::strlen(filename))
+	{
+		this->SelectedOutputBinaryFileNameMap[this->CurrentSelectedOutputUserNumber] = std::string(filename);
+	}
+	else
+	{
+		this->SelectedOutputBinaryFileNameMap.erase(this->CurrentSelectedOutputUserNumber);
+	}
+}
+
 void IPhreeqc::SetSelectedOutputFileOn(bool bValue)
 {
 	if (0 <= this->CurrentSelectedOutputUserNumber)
@@ -1071,6 +1447,7 @@ void IPhreeqc::UnLoadDatabase(void)
 	this->DatabaseLoaded   = false;
 	this->UpdateComponents = true;
 	this->Components.clear();
+	++this->RunGeneration;
 
 	// clear accumulated
 	//
@@ -1109,22 +1486,23 @@ void IPhreeqc::UnLoadDatabase(void)
 	{
 		(*mit).second.clear();
 	}
-	std::map< int, std::vector< std::string > >::iterator it = this->SelectedOutputLinesMap.begin();
-	for (; it != this->SelectedOutputLinesMap.begin(); ++it)
+	std::map< int, CLineIndex >::iterator it = this->SelectedOutputLinesMap.begin();
+	for (; it != this->SelectedOutputLinesMap.end(); ++it)
 	{
-		(*it).second.clear();
+		(*it).second.Clear();
 	}
 
 
 	// clear dump string
 	//
 	this->DumpString.clear();
-	this->DumpLines.clear();
+	this->DumpLines.Clear();
 
 	// initialize phreeqc
 	//
 	this->PhreeqcPtr->clean_up();
 	this->PhreeqcPtr->init();
+	this->PhreeqcPtr->Set_delta_export(this->DeltaExportOn);
 	this->PhreeqcPtr->do_initialize();
 	this->PhreeqcPtr->input_error = 0;
 	this->io_error_count = 0;
@@ -1148,7 +1526,50 @@ int IPhreeqc::EndRow(void)
 					(*it).second->PushBackEmpty(this->PhreeqcPtr->current_user_punch->Get_headings()[i].c_str());
 				}
 			}
-			return (*it).second->EndRow();
+			int ret = (*it).second->EndRow();
+			std::map< int, std::string >::const_iterator bi = this->SelectedOutputBinaryFileNameMap.find((*it).first);
+			if (this->SelectedOutputCallback || bi != this->SelectedOutputBinaryFileNameMap.end())
+			{
+				(*it).second->GetLastRow(this->SelectedOutputRowHeadings, this->SelectedOutputRowValues);
+			}
+			if (bi != this->SelectedOutputBinaryFileNameMap.end())
+			{
+				std::map< int, CSelectedOutputFile* >::iterator fi = this->SelectedOutputBinaryMap.find((*it).first);
+				if (fi == this->SelectedOutputBinaryMap.end())
+				{
+					// opened by the first row of a run, closed in close_output_files
+					CSelectedOutputFile* file = new CSelectedOutputFile;
+					fi = this->SelectedOutputBinaryMap.insert(std::map< int, CSelectedOutputFile* >::value_type((*it).first, file)).first;
+					if (!file->Open(bi->second.c_str()))
+					{
+						std::ostringstream oss;
+						oss << "Unable to open:" << "\"" << bi->second << "\".";
+						this->PhreeqcPtr->error_msg(oss.str().c_str(), STOP); // throws IPhreeqcStop
+					}
+				}
+				if (!(*fi).second->AddRow(this->SelectedOutputRowHeadings, this->SelectedOutputRowValues))
+				{
+					std::ostringstream oss;
+					oss << "Unable to write:" << "\"" << bi->second << "\".";
+					this->PhreeqcPtr->error_msg(oss.str().c_str(), STOP); // throws IPhreeqcStop
+				}
+			}
+			if (this->SelectedOutputCallback)
+			{
+				// stream the row and discard it
+				int stop = this->SelectedOutputCallback((*it).first, (int)this->SelectedOutputRowValues.size(),
+					this->SelectedOutputRowHeadings.empty() ? 0 : &this->SelectedOutputRowHeadings[0],
+					this->SelectedOutputRowValues.empty() ? 0 : &this->SelectedOutputRowValues[0],
+					this->SelectedOutputCookie);
+				(*it).second->ClearRows();
+				if (stop)
+				{
+					std::ostringstream oss;
+					oss << "Selected output callback returned " << stop << " for SELECTED_OUTPUT " << (*it).first << ".";
+					this->PhreeqcPtr->error_msg(oss.str().c_str(), STOP); // throws IPhreeqcStop
+				}
+			}
+			return ret;
 		}
 	}
 	return 0;
@@ -1168,19 +1589,19 @@ void IPhreeqc::check_database(const char* sz_routine)
 
 	// release
 	this->LogString.clear();
-	this->LogLines.clear();
+	this->LogLines.Clear();
 	this->OutputString.clear();
-	this->OutputLines.clear();
+	this->OutputLines.Clear();
 
 	std::map< int, std::string >::iterator mit = SelectedOutputStringMap.begin();
 	for (; mit != SelectedOutputStringMap.begin(); ++mit)
 	{
 		(*mit).second.clear();
 	}
-	std::map< int, std::vector< std::string > >::iterator lit = this->SelectedOutputLinesMap.begin();
-	for (; lit != this->SelectedOutputLinesMap.begin(); ++lit)
+	std::map< int, CLineIndex >::iterator lit = this->SelectedOutputLinesMap.begin();
+	for (; lit != this->SelectedOutputLinesMap.end(); ++lit)
 	{
-		(*lit).second.clear();
+		(*lit).second.Clear();
 	}
 
 	if (!this->DatabaseLoaded)
@@ -1196,6 +1617,9 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 {
 	char token[MAX_LENGTH];
 
+	// invalidates model definitions assumed by templates
+	++this->RunGeneration;
+
 /*
  *   Maybe should be in read_input
  */
@@ -1333,8 +1757,8 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 						if (!punch_open(filename.c_str(), std::ios_base::out, (*it).first))
 						{
 							std::ostringstream oss;
-							oss << sz_routine << ": Unable to open:" << "\"" << filename << "\".\n";
-							this->PhreeqcPtr->warning_msg(oss.str().c_str());
+							oss << sz_routine << ": Unable to open:" << "\"" << filename << "\".";
+							this->PhreeqcPtr->error_msg(oss.str().c_str(), STOP); // throws IPhreeqcStop
 						}
 						else
 						{
@@ -1450,9 +1874,16 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 /*
  *   dump
  */
+		dumper dump_info_orig(this->PhreeqcPtr->dump_info);
+		if (this->DeltaExportOn)
+		{
+			this->PhreeqcPtr->dump_select_dirty();
+		}
 		dumper dump_info_save(this->PhreeqcPtr->dump_info);
+		bool dumped = false;
 		if (this->DumpOn)
 		{
+			dumped = dump_info_save.Get_on() && this->PhreeqcPtr->pr.dump && dump_info_save.Get_bool_any();
 			this->PhreeqcPtr->dump_entities();
 			this->DumpFileName = this->PhreeqcPtr->dump_info.Get_file_name();
 		}
@@ -1461,6 +1892,7 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 			this->PhreeqcPtr->dump_info = dump_info_save;
 			if (this->PhreeqcPtr->dump_info.Get_bool_any())
 			{
+				dumped = true;
 				std::ostringstream oss;
 				this->PhreeqcPtr->dump_ostream(oss);
 				if (this->PhreeqcPtr->dump_info.Get_append())
@@ -1470,16 +1902,20 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 				else
 				{
 					this->DumpString = oss.str();
+					this->DumpLines.Clear();
 				}
-
-				/* Fill dump lines */
-				this->DumpLines.clear();
-				std::istringstream iss(this->DumpString);
-				std::string line;
-				while (std::getline(iss, line))
-				{
-					this->DumpLines.push_back(line);
-				}
+				this->DumpLines.Append(oss.str().c_str());
+			}
+		}
+		if (this->DeltaExportOn)
+		{
+			if (dumped)
+			{
+				this->PhreeqcPtr->dump_clear_dirty(dump_info_save);
+			}
+			else
+			{
+				this->PhreeqcPtr->dump_info = dump_info_orig;
 			}
 		}
 /*
@@ -1512,77 +1948,231 @@ void IPhreeqc::do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALL
 	this->UpdateComponents = true;
 	this->update_errors();
 
-	// update lines
-	//
+}
 
-	if (this->LogStringOn)
+int IPhreeqc::save_state(const char* sz_routine, int start, int end, std::vector< unsigned char >& buffer)
+{
+	this->ErrorReporter->Clear();
+	buffer.clear();
+	try
 	{
-		// output lines
-		std::istringstream iss(this->LogString);
-		std::string line;
-		while (std::getline(iss, line))
+		Serializer serializer(this);
+		CStateSnapshot snapshot;
+		if (this->DeltaExportOn)
 		{
-			this->LogLines.push_back(line);
+			std::set<int> cells;
+			for (int type = Serializer::PT_SOLUTION; type <= Serializer::PT_PRESSURE; ++type)
+			{
+				this->PhreeqcPtr->get_dirty(type, start, end, cells);
+			}
+			std::set<int>::const_iterator it = cells.begin();
+			for (; it != cells.end(); ++it)
+			{
+				serializer.Serialize(*this->PhreeqcPtr, *it, *it, true, true);
+			}
+			snapshot.GetCells().assign(cells.begin(), cells.end());
+			snapshot.SetDelta(true);
 		}
+		else
+		{
+			serializer.Serialize(*this->PhreeqcPtr, start, end, true, true);
+		}
+
+		snapshot.GetWords() = serializer.GetDictionary().GetWords();
+		snapshot.GetInts().swap(serializer.GetInts());
+		snapshot.GetDoubles().swap(serializer.GetDoubles());
+		snapshot.SetModel(this->model_hash());
+		snapshot.Write(buffer);
 	}
+	catch (const std::bad_alloc&)
+	{
+		buffer.clear();
+		std::ostringstream oss;
+		oss << sz_routine << ": Out of memory.\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	return 0;
+}
 
-	if (this->OutputStringOn)
+void IPhreeqc::clear_exported(int start, int end)
+{
+	if (this->DeltaExportOn)
 	{
-		// output lines
-		std::istringstream iss(this->OutputString);
-		std::string line;
-		while (std::getline(iss, line))
+		for (int type = Serializer::PT_SOLUTION; type <= Serializer::PT_PRESSURE; ++type)
 		{
-			this->OutputLines.push_back(line);
+			this->PhreeqcPtr->clear_dirty(type, start, end);
 		}
 	}
+}
+
+const void* IPhreeqc::get_blob(const char* sz_routine, int type, int n_user, int* size)
+{
+	this->ErrorReporter->Clear();
+	this->BlobBuffer.clear();
+
+	Serializer serializer(this);
+	if (!serializer.SerializeEntity(*this->PhreeqcPtr, (Serializer::PACK_TYPE)type, n_user))
+	{
+		std::ostringstream oss;
+		oss << sz_routine << ": Entity " << n_user << " not found.\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		if (size) *size = 0;
+		return NULL;
+	}
+
+	CStateSnapshot snapshot;
+	snapshot.GetWords() = serializer.GetDictionary().GetWords();
+	snapshot.GetInts().swap(serializer.GetInts());
+	snapshot.GetDoubles().swap(serializer.GetDoubles());
+	snapshot.SetModel(this->model_hash());
+	snapshot.Write(this->BlobBuffer);
+
+	if (size) *size = (int)this->BlobBuffer.size();
+	return &this->BlobBuffer[0];
+}
+
+int IPhreeqc::set_blob(const char* sz_routine, int type, int n_user, const void* blob, int size)
+{
+	this->ErrorReporter->Clear();
 
-	for (int i = 0; i < this->GetSelectedOutputCount(); ++i)
+	std::string error;
+	CStateSnapshot snapshot;
+	if (!this->DatabaseLoaded)
+	{
+		error = "No database is loaded";
+	}
+	else if (n_user < 0)
 	{
-		int n = this->GetNthSelectedOutputUserNumber(i);
-		if (this->get_sel_out_string_on(n))
+		error = "Invalid user number";
+	}
+	else if (snapshot.Read((const unsigned char*)blob, (size > 0) ? (size_t)size : 0, error))
+	{
+		if (!snapshot.IsModel(this->model_hash()))
+		{
+			error = "Blob was saved with a different database";
+		}
+		else if (snapshot.IsDelta() || !snapshot.GetCells().empty())
+		{
+			error = "Blob is a state snapshot, not a single entity";
+		}
+		else
 		{
-			std::map< int, std::string >::iterator mit = this->SelectedOutputStringMap.find(n);
-			ASSERT(mit != this->SelectedOutputStringMap.end());
-			if (mit != this->SelectedOutputStringMap.end())
+			Dictionary dictionary;
+			for (size_t i = 0; i < snapshot.GetWords().size(); ++i)
 			{
-				// output lines
-				std::istringstream iss((*mit).second);
-				std::string line;
-				while (std::getline(iss, line))
+				dictionary.Find(snapshot.GetWords()[i]);
+			}
+			Serializer serializer(this);
+			try
+			{
+				if (!serializer.DeserializeEntity(*this->PhreeqcPtr, dictionary, snapshot.GetInts(), snapshot.GetDoubles(), (Serializer::PACK_TYPE)type, n_user))
 				{
-					this->SelectedOutputLinesMap[(*mit).first].push_back(line);
+					error = "Blob holds a different kind of entity or more than one entity";
 				}
 			}
+			catch (const IPhreeqcStop&)
+			{
+				error = "Blob could not be unpacked";
+			}
 		}
 	}
+	if (error.size())
+	{
+		std::ostringstream oss;
+		oss << sz_routine << ": " << error << ".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
+	}
+	return 0;
 }
 
-void IPhreeqc::update_errors(void)
+int IPhreeqc::load_state(const char* sz_routine, const unsigned char* data, size_t size)
 {
-	this->ErrorLines.clear();
-	this->ErrorString = ((CErrorReporter<std::ostringstream>*)this->ErrorReporter)->GetOS()->str();
-	if (this->ErrorString.size())
+	this->ErrorReporter->Clear();
+
+	std::string error;
+	CStateSnapshot snapshot;
+	if (!this->DatabaseLoaded)
 	{
-		std::istringstream iss(this->ErrorString);
-		std::string line;
-		while (std::getline(iss, line))
-		{
-			this->ErrorLines.push_back(line);
-		}
+		error = "No database is loaded";
+	}
+	else if (snapshot.Read(data, size, error) &&
+		!snapshot.IsModel(this->model_hash()))
+	{
+		error = "State snapshot was saved with a different database";
+	}
+	if (error.size())
+	{
+		std::ostringstream oss;
+		oss << sz_routine << ": " << error << ".\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
 	}
 
-	this->WarningLines.clear();
-	this->WarningString = ((CErrorReporter<std::ostringstream>*)this->WarningReporter)->GetOS()->str();
-	if (this->WarningString.size())
+	Dictionary dictionary;
+	for (size_t i = 0; i < snapshot.GetWords().size(); ++i)
 	{
-		std::istringstream iss(this->WarningString);
-		std::string line;
-		while (std::getline(iss, line))
+		dictionary.Find(snapshot.GetWords()[i]);
+	}
+	try
+	{
+		if (snapshot.IsDelta())
 		{
-			this->WarningLines.push_back(line);
+			// entities listed as changed but not packed were deleted
+			std::vector<int>::const_iterator it = snapshot.GetCells().begin();
+			for (; it != snapshot.GetCells().end(); ++it)
+			{
+				this->PhreeqcPtr->delete_cell(*it);
+			}
 		}
+		Serializer serializer(this);
+		serializer.Deserialize(*this->PhreeqcPtr, dictionary, snapshot.GetInts(), snapshot.GetDoubles());
+	}
+	catch (const IPhreeqcStop&)
+	{
+		// entities unpacked before the error are kept
+		std::ostringstream oss;
+		oss << sz_routine << ": State snapshot could not be unpacked.\n";
+		this->AddError(oss.str().c_str());
+		this->update_errors();
+		return 1;
 	}
+	return 0;
+}
+
+unsigned long long IPhreeqc::model_hash(void)const
+{
+	// packed entities refer to species and master species by index
+	std::string names;
+	for (size_t i = 0; i < this->PhreeqcPtr->s.size(); ++i)
+	{
+		names += this->PhreeqcPtr->s[i]->name;
+		names += '\n';
+	}
+	names += '\n';
+	for (size_t i = 0; i < this->PhreeqcPtr->master.size(); ++i)
+	{
+		const class master* master_ptr = this->PhreeqcPtr->master[i];
+		names += (master_ptr->elt && master_ptr->elt->name) ? master_ptr->elt->name : "";
+		names += '\n';
+	}
+	return CStateSnapshot::Hash(names.data(), names.size());
+}
+
+void IPhreeqc::update_errors(void)
+{
+	this->ErrorLines.Clear();
+	this->ErrorString = ((CErrorReporter<std::ostringstream>*)this->ErrorReporter)->GetOS()->str();
+	this->ErrorLines.Append(this->ErrorString.c_str(), this->ErrorString.size());
+
+	this->WarningLines.Clear();
+	this->WarningString = ((CErrorReporter<std::ostringstream>*)this->WarningReporter)->GetOS()->str();
+	this->WarningLines.Append(this->WarningString.c_str(), this->WarningString.size());
 }
 
 void IPhreeqc::log_msg(const char * str)
@@ -1590,6 +2180,7 @@ void IPhreeqc::log_msg(const char * str)
 	if (this->LogStringOn && this->log_on)
 	{
 		this->LogString += str;
+		this->LogLines.Append(str);
 	}
 	ASSERT(!(this->LogFileOn != (this->log_ostream != 0)));
 	this->PHRQ_io::log_msg(str);
@@ -1649,11 +2240,23 @@ void IPhreeqc::output_msg(const char * str)
 	if (this->OutputStringOn && this->output_on)
 	{
 		this->OutputString += str;
+		this->OutputLines.Append(str);
 	}
 	ASSERT(!(this->OutputFileOn != (this->output_ostream != 0)));
 	this->PHRQ_io::output_msg(str);
 }
 
+bool IPhreeqc::output_active(void)
+{
+	// output goes nowhere unless the output file or string is on
+	return this->PHRQ_io::output_active() && (this->OutputStringOn || this->output_ostream != NULL);
+}
+
+bool IPhreeqc::log_active(void)
+{
+	return this->PHRQ_io::log_active() && (this->LogStringOn || this->log_ostream != NULL);
+}
+
 void IPhreeqc::screen_msg(const char *err_str)
 {
 	// no-op
@@ -1667,6 +2270,7 @@ void IPhreeqc::punch_msg(const char *str)
 		if (this->PhreeqcPtr->current_selected_output)
 		{
 			this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()] += str;
+			this->SelectedOutputLinesMap[this->PhreeqcPtr->current_selected_output->Get_n_user()].Append(str);
 		}
 	}
 	ASSERT(!(this->SelectedOutputFileOnMap[this->PhreeqcPtr->current_selected_output->Get_n_user()] != (this->PhreeqcPtr->current_selected_output->Get_punch_ostream() != 0)));
@@ -1744,24 +2348,57 @@ int IPhreeqc::close_output_files(void)
 {
 	int ret = 0;
 
-	safe_close(&this->output_ostream);
-	safe_close(&this->log_ostream);
-	safe_close(&this->dump_ostream);
-	safe_close(&this->error_ostream);
-
+	// selected output files are closed first so that write errors still
+	// reach the error file; they count as errors of the run
 	std::map< int, SelectedOutput >::iterator it = this->PhreeqcPtr->SelectedOutput_map.begin();
 	for (; it != this->PhreeqcPtr->SelectedOutput_map.end(); ++it)
 	{
 		std::ostream *ptr = (*it).second.Get_punch_ostream();
+		if (ptr && ptr->flush().fail())
+		{
+			std::ostringstream oss;
+			oss << "Unable to write:" << "\"" << (*it).second.Get_file_name() << "\".";
+			this->PhreeqcPtr->error_msg(oss.str().c_str(), CONTINUE);
+			++ret;
+		}
 		safe_close(&ptr);
 		(*it).second.Set_punch_ostream(NULL);
 	}
 
 	this->punch_ostream = 0;
 
+	std::map< int, CSelectedOutputFile* >::iterator bit = this->SelectedOutputBinaryMap.begin();
+	for (; bit != this->SelectedOutputBinaryMap.end(); ++bit)
+	{
+		if (!(*bit).second->Close())
+		{
+			std::ostringstream oss;
+			oss << "Unable to write:" << "\"" << this->SelectedOutputBinaryFileNameMap[(*bit).first] << "\".";
+			this->PhreeqcPtr->error_msg(oss.str().c_str(), CONTINUE);
+			++ret;
+		}
+	}
+	this->close_binary_files();
+
+	safe_close(&this->output_ostream);
+	safe_close(&this->log_ostream);
+	safe_close(&this->dump_ostream);
+	safe_close(&this->error_ostream);
+
 	return ret;
 }
 
+void IPhreeqc::close_binary_files(void)
+{
+	// files still open here (destructor) are closed without reporting
+	std::map< int, CSelectedOutputFile* >::iterator it = this->SelectedOutputBinaryMap.begin();
+	for (; it != this->SelectedOutputBinaryMap.end(); ++it)
+	{
+		delete (*it).second;
+	}
+	this->SelectedOutputBinaryMap.clear();
+}
+
 void IPhreeqc::fpunchf(const char *name, const char *format, double d)
 {
 	try
@@ -1770,7 +2407,10 @@ void IPhreeqc::fpunchf(const char *name, const char *format, double d)
 		if (this->get_sel_out_string_on(this->PhreeqcPtr->current_selected_output->Get_n_user()) && this->punch_on)
 		{
 			ASSERT(this->SelectedOutputStringMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputStringMap.end());
-			PHRQ_io::fpunchf_helper(&(this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]), format, d);
+			std::string& str = this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()];
+			size_t len = str.size();
+			PHRQ_io::fpunchf_helper(&str, format, d);
+			this->SelectedOutputLinesMap[this->PhreeqcPtr->current_selected_output->Get_n_user()].Append(str.c_str() + len, str.size() - len);
 		}
 		ASSERT(this->SelectedOutputMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputMap.end());
 		this->SelectedOutputMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]->PushBackDouble(name, d);
@@ -1789,7 +2429,10 @@ void IPhreeqc::fpunchf(const char *name, const char *format, char *s)
 		if (this->get_sel_out_string_on(this->PhreeqcPtr->current_selected_output->Get_n_user()) && this->punch_on)
 		{
 			ASSERT(this->SelectedOutputStringMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputStringMap.end());
-			PHRQ_io::fpunchf_helper(&(this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]), format, s);
+			std::string& str = this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()];
+			size_t len = str.size();
+			PHRQ_io::fpunchf_helper(&str, format, s);
+			this->SelectedOutputLinesMap[this->PhreeqcPtr->current_selected_output->Get_n_user()].Append(str.c_str() + len, str.size() - len);
 		}
 		ASSERT(this->SelectedOutputMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputMap.end());
 		this->SelectedOutputMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]->PushBackString(name, s);
@@ -1808,7 +2451,10 @@ void IPhreeqc::fpunchf(const char *name, const char *format, int i)
 		if (this->get_sel_out_string_on(this->PhreeqcPtr->current_selected_output->Get_n_user()) && this->punch_on)
 		{
 			ASSERT(this->SelectedOutputStringMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputStringMap.end());
-			PHRQ_io::fpunchf_helper(&(this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]), format, i);
+			std::string& str = this->SelectedOutputStringMap[this->PhreeqcPtr->current_selected_output->Get_n_user()];
+			size_t len = str.size();
+			PHRQ_io::fpunchf_helper(&str, format, i);
+			this->SelectedOutputLinesMap[this->PhreeqcPtr->current_selected_output->Get_n_user()].Append(str.c_str() + len, str.size() - len);
 		}
 		ASSERT(this->SelectedOutputMap.find(this->PhreeqcPtr->current_selected_output->Get_n_user()) != this->SelectedOutputMap.end());
 		this->SelectedOutputMap[this->PhreeqcPtr->current_selected_output->Get_n_user()]->PushBackLong(name, (long)i);
@@ -1846,6 +2492,16 @@ bool IPhreeqc::get_sel_out_string_on(int n)const
 	return false;
 }
 
+std::istream * IPhreeqc::open_include(const char *file_name)
+{
+	std::map< std::string, std::string >::const_iterator it = this->VirtualFiles.find(file_name ? file_name : "");
+	if (it != this->VirtualFiles.end())
+	{
+		return new VirtualFileStream((*it).second);
+	}
+	return this->PHRQ_io::open_include(file_name);
+}
+
 bool IPhreeqc::punch_open(const char *file_name, std::ios_base::openmode mode, int n_user)
 {
 	if (this->PhreeqcPtr->SelectedOutput_map[n_user].Get_have_punch_name() &&
@@ -2010,3 +2666,41 @@ std::string IPhreeqc::GetSolutionList2(int id)
   return this->PhreeqcPtr->get_solution_list(id);
 }
 
+// log K cache
+int IPhreeqc::GetLogkCacheHits(void)
+{
+  return this->PhreeqcPtr->get_logk_cache_hits();
+}
+int IPhreeqc::GetLogkCacheMisses(void)
+{
+  return this->PhreeqcPtr->get_logk_cache_misses();
+}
+
+// model cache
+int IPhreeqc::GetModelCacheHits(void)
+{
+  return this->PhreeqcPtr->get_model_cache_hits();
+}
+int IPhreeqc::GetModelCacheMisses(void)
+{
+  return this->PhreeqcPtr->get_model_cache_misses();
+}
+
+// allocation statistics
+double IPhreeqc::GetAllocatedBytes(void)
+{
+  return (double) this->PhreeqcPtr->get_alloc_bytes();
+}
+double IPhreeqc::GetPeakAllocatedBytes(void)
+{
+  return (double) this->PhreeqcPtr->get_alloc_peak();
+}
+double IPhreeqc::GetTotalAllocatedBytes(void)
+{
+  return this->PhreeqcPtr->get_alloc_total();
+}
+double IPhreeqc::GetAllocationCount(void)
+{
+  return this->PhreeqcPtr->get_alloc_count();
+}
+
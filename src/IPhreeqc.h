@@ -5,6 +5,7 @@
 #define INC_IPHREEQC_H
 
 #include "Var.h"
+#include "IPhreeqcCallbacks.h"
 
 /**
  * @mainpage IPhreeqc Library Documentation (3.7.3-15968)
@@ -264,6 +265,15 @@ extern "C" {
  */
 	IPQ_DLL_EXPORT int         GetCurrentSelectedOutputUserNumber(int id);
 
+/**
+ *  Retrieves the current value of the delta export switch.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @return                 Non-zero if <B>DUMP</B> output and state snapshots contain only changed entities, 0 (zero) otherwise.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    SetDeltaExportOn
+ */
+	IPQ_DLL_EXPORT int         GetDeltaExportOn(int id);
+
 /**
  *  Retrieves the name of the dump file.  This file name is used if not specified within <B>DUMP</B> input.
  *  The default value is <B><I>dump.id.out</I></B>.
@@ -794,6 +804,22 @@ extern "C" {
  */
 	IPQ_DLL_EXPORT int         GetOutputStringLineCount(int id);
 
+/**
+ *  Retrieves a range of output lines.  Lines are indexed as output is produced,
+ *  so reading every line this way takes time proportional to the size of the output.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param start            The zero-based index of the first line to retrieve.
+ *  @param count            The maximum number of lines to retrieve.
+ *  @param lines            Array of at least count pointers that receives the lines;
+ *                          they remain valid until the next run.
+ *  @return                 The number of lines retrieved (0 if start is out of range), or a negative value on error.
+ *  @retval IPQ_INVALIDARG  start or count is negative, or lines is NULL.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @pre                    @ref SetOutputStringOn must have been set to true (non-zero).
+ *  @see                    GetOutputStringLine, GetOutputStringLineCount, SetOutputStringOn
+ */
+	IPQ_DLL_EXPORT int         GetOutputLines(int id, int start, int count, const char** lines);
+
 /**
  *  Retrieves the current value of the output string switch.
  *  @param id            The instance id returned from @ref CreateIPhreeqc.
@@ -833,6 +859,76 @@ extern "C" {
  */
 	IPQ_DLL_EXPORT int         GetSelectedOutputColumnCount(int id);
 
+
+/**
+ *  Copies the values of one column of the selected-output buffer.  Rows 1 through n are copied;
+ *  empty, error and string values are returned as 1.0e30.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param col              The column index (0 based; 1 based in Fortran).
+ *  @param values           Array to receive the values; must hold at least n values.
+ *  @param n                The number of rows to copy; rows beyond @ref GetSelectedOutputRowCount - 1 are not written.
+ *  @param rows             If not NULL, receives the number of rows copied.
+ *  @retval IPQ_OK          Success.
+ *  @retval IPQ_INVALIDCOL  The given column is out of range.
+ *  @retval IPQ_INVALIDARG  values is NULL, n is negative or the current user number is not defined.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetSelectedOutputColumnCount, GetSelectedOutputRowCount, GetSelectedOutputValue
+ *  @par Fortran90 Interface:
+ *  @htmlonly
+ *  <CODE>
+ *  <PRE>
+ *  FUNCTION GetSelectedOutputColumn(ID,COL,VALUES,N,ROWS)
+ *    INTEGER(KIND=4),  INTENT(IN)  :: ID
+ *    INTEGER(KIND=4),  INTENT(IN)  :: COL
+ *    REAL(KIND=8),     INTENT(OUT) :: VALUES(*)
+ *    INTEGER(KIND=4),  INTENT(IN)  :: N
+ *    INTEGER(KIND=4),  INTENT(OUT) :: ROWS
+ *    INTEGER(KIND=4)               :: GetSelectedOutputColumn
+ *  END FUNCTION GetSelectedOutputColumn
+ *  </PRE>
+ *  </CODE>
+ *  @endhtmlonly
+ */
+	IPQ_DLL_EXPORT IPQ_RESULT  GetSelectedOutputColumn(int id, int col, double* values, int n, int* rows);
+
+/**
+ *  Retrieves the name of the binary selected-output file of the current <B>SELECTED_OUTPUT</B>.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @return                 The name of the file, or an empty string if no binary file is written or the id is invalid.
+ *  @see                    SetSelectedOutputBinaryFileName
+ */
+	IPQ_DLL_EXPORT const char* GetSelectedOutputBinaryFileName(int id);
+
+/**
+ *  Sets the name of a binary columnar file that receives the rows of the current <B>SELECTED_OUTPUT</B>.
+ *  The file is written during each run and finished when the run ends.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param filename         Name of the file, or NULL/empty to stop writing a binary file.
+ *  @retval IPQ_OK          Success.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetSelectedOutputBinaryFileName, LoadSelectedOutputBinaryFile, ConvertSelectedOutputBinaryFile
+ */
+	IPQ_DLL_EXPORT IPQ_RESULT  SetSelectedOutputBinaryFileName(int id, const char* filename);
+
+/**
+ *  Loads a binary selected-output file into the current selected-output buffer, replacing its contents.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param filename         Name of the binary file.
+ *  @return                 The number of errors encountered.
+ *  @see                    SetSelectedOutputBinaryFileName, GetSelectedOutputValue, GetSelectedOutputColumn
+ */
+	IPQ_DLL_EXPORT int         LoadSelectedOutputBinaryFile(int id, const char* filename);
+
+/**
+ *  Converts a binary selected-output file to a tab-separated text file.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param binary_filename  Name of the binary file.
+ *  @param text_filename    Name of the text file to write.
+ *  @return                 The number of errors encountered.
+ *  @see                    SetSelectedOutputBinaryFileName
+ */
+	IPQ_DLL_EXPORT int         ConvertSelectedOutputBinaryFile(int id, const char* binary_filename, const char* text_filename);
+
 /**
  *  Retrieves the count of <B>SELECTED_OUTPUT</B> blocks that are currently defined.
  *  @param id            The instance id returned from @ref CreateIPhreeqc.
@@ -1553,6 +1649,20 @@ Headings
  */
 	IPQ_DLL_EXPORT void        OutputWarningString(int id);
 
+/**
+ *  Registers an in-memory file.  <B>INCLUDE$</B> lines and @ref LoadDatabase look up a file name among the
+ *  registered files before the file system.  The data is copied; registering a name again replaces its contents.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param name             The file name, exactly as it appears in <B>INCLUDE$</B> input or is passed to @ref LoadDatabase.
+ *  @param data             The contents of the file, or NULL to remove the registration.
+ *  @param len              The length of data in bytes, or -1 if data is NUL-terminated.
+ *  @retval IPQ_OK          Success.
+ *  @retval IPQ_INVALIDARG  name is NULL or empty.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    LoadDatabase
+ */
+	IPQ_DLL_EXPORT IPQ_RESULT  RegisterVirtualFile(int id, const char* name, const char* data, int len);
+
 
 /**
  *  Runs the input buffer as defined by calls to @ref AccumulateLine.
@@ -1635,6 +1745,275 @@ Headings
  */
 	IPQ_DLL_EXPORT int         RunString(int id, const char* input);
 
+/**
+ *  Creates an input template from phreeqc input containing named numeric slots written <CODE>{name}</CODE>.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param input            String containing phreeqc input with slots.
+ *  @return                 The template number (0 based) used by @ref RunTemplate, or a negative value on error.
+ *  @retval IPQ_INVALIDARG  input is NULL.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetTemplateSlotCount, GetTemplateSlotName, RunTemplate
+ */
+	IPQ_DLL_EXPORT int         CreateTemplate(int id, const char* input);
+
+/**
+ *  Retrieves the number of distinct slots in a template.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param t                The template number returned by @ref CreateTemplate.
+ *  @return                 The number of slots, or a negative value on error.
+ *  @retval IPQ_INVALIDARG  t is invalid.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    CreateTemplate, GetTemplateSlotName
+ */
+	IPQ_DLL_EXPORT int         GetTemplateSlotCount(int id, int t);
+
+/**
+ *  Retrieves the name of a template slot; slots are numbered in order of first appearance.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param t                The template number returned by @ref CreateTemplate.
+ *  @param slot             The slot index (0 based).
+ *  @return                 The name of the slot, or an empty string if id, t or slot is invalid.
+ *  @see                    CreateTemplate, GetTemplateSlotCount
+ */
+	IPQ_DLL_EXPORT const char* GetTemplateSlotName(int id, int t, int slot);
+
+/**
+ *  Runs a template with the given slot values.  Model definitions without slots are sent only
+ *  until a run succeeds; see IPhreeqc::RunTemplate.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param t                The template number returned by @ref CreateTemplate.
+ *  @param values           Array of @ref GetTemplateSlotCount values, in slot order.
+ *  @return                 The number of errors encountered during the run.
+ *  @see                    CreateTemplate, RunString
+ *  @pre
+ *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+ */
+	IPQ_DLL_EXPORT int         RunTemplate(int id, int t, const double* values);
+
+/**
+ *  Saves solutions, exchangers, gas phases, kinetics, equilibrium-phase and solid-solution assemblages,
+ *  surfaces, temperatures and pressures numbered start through end to a binary file.
+ *  The file can be loaded only into an instance that has loaded the same database.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param start            The first user number.
+ *  @param end              The last user number.
+ *  @param filename         Name of the file to write.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    LoadState, SaveStateBuffer
+ */
+	IPQ_DLL_EXPORT int         SaveState(int id, int start, int end, const char* filename);
+
+/**
+ *  Loads a file written by @ref SaveState.  Entities in the file replace entities with the same user numbers.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param filename         Name of the file to read.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    LoadStateBuffer, SaveState
+ *  @pre
+ *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+ */
+	IPQ_DLL_EXPORT int         LoadState(int id, const char* filename);
+
+/**
+ *  Saves the same snapshot as @ref SaveState to a buffer held by the instance,
+ *  retrieved with @ref GetStateBuffer and @ref GetStateBufferSize.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param start            The first user number.
+ *  @param end              The last user number.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    LoadStateBuffer, SaveState
+ */
+	IPQ_DLL_EXPORT int         SaveStateBuffer(int id, int start, int end);
+
+/**
+ *  Retrieves the buffer filled by @ref SaveStateBuffer; it is valid until the next call to @ref SaveStateBuffer.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @return                 The snapshot, or NULL if there is none or the id is invalid.
+ *  @see                    GetStateBufferSize, SaveStateBuffer
+ */
+	IPQ_DLL_EXPORT const void* GetStateBuffer(int id);
+
+/**
+ *  Retrieves the size in bytes of the buffer filled by @ref SaveStateBuffer.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @return                 The size of the snapshot.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetStateBuffer, SaveStateBuffer
+ */
+	IPQ_DLL_EXPORT int         GetStateBufferSize(int id);
+
+/**
+ *  Loads a snapshot created by @ref SaveStateBuffer or read from a file written by @ref SaveState.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param buffer           The snapshot.
+ *  @param size             The size of the snapshot in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    LoadState, SaveStateBuffer
+ *  @pre
+ *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+ */
+	IPQ_DLL_EXPORT int         LoadStateBuffer(int id, const void* buffer, int size);
+
+/**
+ *  Packs the solution numbered n_user into a binary blob (a one-entity @ref SaveState snapshot) held by the instance;
+ *  it is valid until the next Get...Blob call and can be passed to @ref SetSolutionBlob of any instance
+ *  that has loaded the same database.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the solution.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such solution or the id is invalid.
+ *  @see                    SetSolutionBlob
+ */
+	IPQ_DLL_EXPORT const void* GetSolutionBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the solution packed by @ref GetSolutionBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the solution under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetSolutionBlob
+ */
+	IPQ_DLL_EXPORT int         SetSolutionBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the exchanger numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the exchanger.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such exchanger or the id is invalid.
+ *  @see                    SetExchangeBlob
+ */
+	IPQ_DLL_EXPORT const void* GetExchangeBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the exchanger packed by @ref GetExchangeBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the exchanger under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetExchangeBlob
+ */
+	IPQ_DLL_EXPORT int         SetExchangeBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the surface numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the surface.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such surface or the id is invalid.
+ *  @see                    SetSurfaceBlob
+ */
+	IPQ_DLL_EXPORT const void* GetSurfaceBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the surface packed by @ref GetSurfaceBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the surface under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetSurfaceBlob
+ */
+	IPQ_DLL_EXPORT int         SetSurfaceBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the gas phase numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the gas phase.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such gas phase or the id is invalid.
+ *  @see                    SetGasPhaseBlob
+ */
+	IPQ_DLL_EXPORT const void* GetGasPhaseBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the gas phase packed by @ref GetGasPhaseBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the gas phase under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetGasPhaseBlob
+ */
+	IPQ_DLL_EXPORT int         SetGasPhaseBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the equilibrium-phase assemblage numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the equilibrium-phase assemblage.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such equilibrium-phase assemblage or the id is invalid.
+ *  @see                    SetEquilibriumPhasesBlob
+ */
+	IPQ_DLL_EXPORT const void* GetEquilibriumPhasesBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the equilibrium-phase assemblage packed by @ref GetEquilibriumPhasesBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the equilibrium-phase assemblage under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetEquilibriumPhasesBlob
+ */
+	IPQ_DLL_EXPORT int         SetEquilibriumPhasesBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the solid-solution assemblage numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the solid-solution assemblage.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such solid-solution assemblage or the id is invalid.
+ *  @see                    SetSolidSolutionsBlob
+ */
+	IPQ_DLL_EXPORT const void* GetSolidSolutionsBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the solid-solution assemblage packed by @ref GetSolidSolutionsBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the solid-solution assemblage under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetSolidSolutionsBlob
+ */
+	IPQ_DLL_EXPORT int         SetSolidSolutionsBlob(int id, int n_user, const void* blob, int size);
+
+/**
+ *  Packs the kinetic reactant set numbered n_user into a binary blob; see @ref GetSolutionBlob.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number of the kinetic reactant set.
+ *  @param size             Receives the size of the blob in bytes.
+ *  @return                 The blob, or NULL if there is no such kinetic reactant set or the id is invalid.
+ *  @see                    SetKineticsBlob
+ */
+	IPQ_DLL_EXPORT const void* GetKineticsBlob(int id, int n_user, int* size);
+
+/**
+ *  Stores the kinetic reactant set packed by @ref GetKineticsBlob under user number n_user.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param n_user           The user number to store the kinetic reactant set under.
+ *  @param blob             The blob.
+ *  @param size             The size of the blob in bytes.
+ *  @return                 The number of errors encountered.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetKineticsBlob
+ */
+	IPQ_DLL_EXPORT int         SetKineticsBlob(int id, int n_user, const void* blob, int size);
+
 /**
  *  Sets a C callback function for Basic programs. The syntax for the Basic command is
  *  10 result = CALLBACK(x1, x2, string$)
@@ -1652,6 +2031,21 @@ Headings
  */
 	IPQ_DLL_EXPORT IPQ_RESULT  SetBasicCallback(int id, double (*fcn)(double x1, double x2, const char *str, void *cookie), void *cookie1);
 
+/**
+ *  Sets a C callback function that receives each completed <B>SELECTED_OUTPUT</B> row.  While a callback is set,
+ *  rows are passed to the callback and then discarded, so that memory use does not grow with the length of the run;
+ *  only the headings remain available through @ref GetSelectedOutputValue.  The syntax for the C function is
+ *  int my_callback(int n_user, int ncols, const char* const* headings, const VAR* values, void *cookie)
+ *  where n_user is the <B>SELECTED_OUTPUT</B> user number.  The headings and values are only valid during the call.
+ *  Return 0 to continue; a nonzero return adds an error and stops the run.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param fcn              The name of a user-defined function, or NULL to keep rows in memory (the default).
+ *  @param cookie           A user defined value to be passed to the callback function.
+ *  @retval IPQ_OK          Success.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ */
+	IPQ_DLL_EXPORT IPQ_RESULT  SetSelectedOutputCallback(int id, PFN_SELECTED_OUTPUT_CALLBACK fcn, void *cookie);
+
 /**
  *  Sets a Fortran callback function for Basic programs. The syntax for the Basic command is
  *  10 result = CALLBACK(x1, x2, string$)
@@ -1745,6 +2139,19 @@ Headings
  */
 	IPQ_DLL_EXPORT IPQ_RESULT  SetCurrentSelectedOutputUserNumber(int id, int n);
 
+/**
+ *  Sets the delta export switch.  While on, <B>DUMP</B> output and @ref SaveState/@ref SaveStateBuffer
+ *  contain only the entities saved, copied, deleted or loaded since they were last exported.
+ *  Keywords that can change entities in ways that are not tracked (definitions, <B>*_MODIFY</B>,
+ *  <B>TRANSPORT</B>, <B>ADVECTION</B>, <B>COPY</B>, ...) mark all entities changed.  The initial setting is false.
+ *  @param id               The instance id returned from @ref CreateIPhreeqc.
+ *  @param value            If non-zero, turns on delta exports; if zero, exports contain all selected entities.
+ *  @retval IPQ_OK          Success.
+ *  @retval IPQ_BADINSTANCE The given id is invalid.
+ *  @see                    GetDeltaExportOn, SaveState, SetDumpFileOn, SetDumpStringOn
+ */
+	IPQ_DLL_EXPORT IPQ_RESULT  SetDeltaExportOn(int id, int value);
+
 /**
  *  Sets the name of the dump file.  This file name is used if not specified within <B>DUMP</B> input.
  *  The default value is <B><I>dump.id.out</I></B>.
@@ -2207,6 +2614,20 @@ Headings
   IPQ_DLL_EXPORT const char* GetElements(int id, int solution);
   IPQ_DLL_EXPORT const char* GetSolutionList(int id);
 
+  // log K cache
+  IPQ_DLL_EXPORT int GetLogkCacheHits(int id);
+  IPQ_DLL_EXPORT int GetLogkCacheMisses(int id);
+
+  // model cache
+  IPQ_DLL_EXPORT int GetModelCacheHits(int id);
+  IPQ_DLL_EXPORT int GetModelCacheMisses(int id);
+
+  // allocation statistics
+  IPQ_DLL_EXPORT double GetAllocatedBytes(int id);
+  IPQ_DLL_EXPORT double GetPeakAllocatedBytes(int id);
+  IPQ_DLL_EXPORT double GetTotalAllocatedBytes(int id);
+  IPQ_DLL_EXPORT double GetAllocationCount(int id);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -13,12 +13,15 @@
 #include "IPhreeqcCallbacks.h"      /* PFN_PRERUN_CALLBACK, PFN_POSTRUN_CALLBACK, PFN_CATCH_CALLBACK */
 #include "Var.h"                    /* VRESULT */
 #include "PHRQ_io.h"
+#include "CLineIndex.hxx"
 
 #include "PHRQ_exports.h"
 
 class Phreeqc;
 class IErrorReporter;
+class CInputTemplate;
 class CSelectedOutput;
+class CSelectedOutputFile;
 class SelectedOutput;
 
 /**
@@ -123,6 +126,14 @@ public:
 	 */
 	int                      GetCurrentSelectedOutputUserNumber(void)const;
 
+	/**
+	 *  Retrieves the current value of the delta export switch.
+	 *  @retval true            <B>DUMP</B> output and state snapshots contain only entities changed since the last export.
+	 *  @retval false           <B>DUMP</B> output and state snapshots contain all selected entities.
+	 *  @see                    SetDeltaExportOn
+	 */
+	bool                     GetDeltaExportOn(void)const;
+
 	/**
 	 *  Retrieves the name of the dump file.  This file name is used if not specified within <B>DUMP</B> input.
 	 *  The default value is <B><I>dump.id.out</I></B>, where id is obtained from @ref GetId.
@@ -336,6 +347,19 @@ public:
 	 */
 	int                      GetOutputStringLineCount(void)const;
 
+	/**
+	 *  Retrieves a range of output lines.  Lines are indexed as output is produced,
+	 *  so reading every line this way takes time proportional to the size of the output.
+	 *  @param start            The zero-based index of the first line to retrieve.
+	 *  @param count            The maximum number of lines to retrieve.
+	 *  @param lines            Array of at least count pointers that receives the lines;
+	 *                          they remain valid until the next run.
+	 *  @return                 The number of lines retrieved (0 if start is out of range).
+	 *  @pre                    @ref SetOutputStringOn must have been set to true.
+	 *  @see                    GetOutputStringLine, GetOutputStringLineCount, SetOutputStringOn
+	 */
+	int                      GetOutputLines(int start, int count, const char** lines)const;
+
 	/**
 	 *  Retrieves the current value of the output string switch.
 	 *  @retval true            Phreeqc output is stored.
@@ -351,6 +375,57 @@ public:
 	 */
 	int                      GetSelectedOutputColumnCount(void)const;
 
+	/**
+	 *  Copies the values of one column of the current selected-output buffer (see @ref SetCurrentSelectedOutputUserNumber).
+	 *  Rows 1 through n are copied; empty, error and string values are returned as 1.0e30, as in the selected-output
+	 *  array for Fortran/PHAST.
+	 *  @param col              The column index.
+	 *  @param values           Array to receive the values; must hold at least n values.
+	 *  @param n                The number of rows to copy; rows beyond @ref GetSelectedOutputRowCount - 1 are not written.
+	 *  @param rows             If not NULL, receives the number of rows copied.
+	 *  @retval VR_OK           Success.
+	 *  @retval VR_INVALIDCOL   The given column is out of range.
+	 *  @retval VR_INVALIDARG   values is NULL, n is negative or the current user number is not defined.
+	 *  @see                    GetSelectedOutputColumnCount, GetSelectedOutputRowCount, GetSelectedOutputValue
+	 */
+	VRESULT                  GetSelectedOutputColumn(int col, double* values, int n, int* rows);
+
+	/**
+	 *  Retrieves the name of the binary selected-output file of the current <B>SELECTED_OUTPUT</B> (see @ref SetCurrentSelectedOutputUserNumber).
+	 *  @return                 The name of the file, or an empty string if no binary file is written.
+	 *  @see                    SetSelectedOutputBinaryFileName, LoadSelectedOutputBinaryFile
+	 */
+	const char*              GetSelectedOutputBinaryFileName(void)const;
+
+	/**
+	 *  Sets the name of a binary columnar file that receives the rows of the current <B>SELECTED_OUTPUT</B>
+	 *  (see @ref SetCurrentSelectedOutputUserNumber) in addition to the text file and the selected-output buffer.
+	 *  The file holds typed columns in row groups, with the column names and types in a footer that is written
+	 *  when the run finishes (see CSelectedOutputFile.hxx for the layout).
+	 *  @param filename         Name of the file, or NULL/empty to stop writing a binary file.
+	 *  @see                    GetSelectedOutputBinaryFileName, LoadSelectedOutputBinaryFile, ConvertSelectedOutputBinaryFile
+	 */
+	void                     SetSelectedOutputBinaryFileName(const char *filename);
+
+	/**
+	 *  Loads a binary selected-output file into the current selected-output buffer (see @ref SetCurrentSelectedOutputUserNumber),
+	 *  replacing its contents, so it can be read with @ref GetSelectedOutputValue and @ref GetSelectedOutputColumn.
+	 *  The buffer is cleared again by the next run.
+	 *  @param filename         Name of the binary file.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    SetSelectedOutputBinaryFileName, ConvertSelectedOutputBinaryFile
+	 */
+	int                      LoadSelectedOutputBinaryFile(const char *filename);
+
+	/**
+	 *  Converts a binary selected-output file to a tab-separated text file.
+	 *  @param binary_filename  Name of the binary file.
+	 *  @param text_filename    Name of the text file to write.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    SetSelectedOutputBinaryFileName, LoadSelectedOutputBinaryFile
+	 */
+	int                      ConvertSelectedOutputBinaryFile(const char *binary_filename, const char *text_filename);
+
 	/**
 	 *  Retrieves the count of <B>SELECTED_OUTPUT</B> blocks that are currently defined.
 	 *  @return                 The number of <B>SELECTED_OUTPUT</B> blocks.
@@ -667,6 +742,19 @@ public:
 	 */
 	void                     OutputWarningString(void);
 
+	/**
+	 *  Registers an in-memory file.  <B>INCLUDE$</B> lines and @ref LoadDatabase look up a file name among the
+	 *  registered files before the file system, so registered files are never read from disk.  The data is copied;
+	 *  registering a name again replaces its contents.  Registered files are kept when a database is (re)loaded.
+	 *  @param name             The file name, exactly as it appears in <B>INCLUDE$</B> input or is passed to @ref LoadDatabase.
+	 *  @param data             The contents of the file, or NULL to remove the registration.
+	 *  @param len              The length of data in bytes, or -1 if data is NUL-terminated.
+	 *  @retval VR_OK           Success.
+	 *  @retval VR_INVALIDARG   name is NULL or empty.
+	 *  @see                    LoadDatabase
+	 */
+	VRESULT                  RegisterVirtualFile(const char* name, const char* data, int len);
+
 	/**
 	 *  Runs the input buffer as defined by calls to @ref AccumulateLine.
 	 *  @return                 The number of errors encountered.
@@ -698,6 +786,245 @@ public:
 	 */
 	int                      RunString(const char* input);
 
+	/**
+	 *  Creates an input template from phreeqc input containing named numeric slots written <CODE>{name}</CODE>,
+	 *  for example <CODE>pH {ph}</CODE>.  The input is split into keyword blocks once; @ref RunTemplate fills in the slots.
+	 *  @param input            String containing phreeqc input with slots.
+	 *  @return                 The template number (0 based) used by @ref RunTemplate, or -1 if input is NULL.
+	 *  @see                    GetTemplateSlotCount, GetTemplateSlotName, RunTemplate
+	 */
+	int                      CreateTemplate(const char* input);
+
+	/**
+	 *  Retrieves the number of distinct slots in a template.
+	 *  @param t                The template number returned by @ref CreateTemplate.
+	 *  @return                 The number of slots, or -1 if t is invalid.
+	 *  @see                    CreateTemplate, GetTemplateSlotName
+	 */
+	int                      GetTemplateSlotCount(int t)const;
+
+	/**
+	 *  Retrieves the name of a template slot; slots are numbered in order of first appearance.
+	 *  @param t                The template number returned by @ref CreateTemplate.
+	 *  @param slot             The slot index (0 based).
+	 *  @return                 The name of the slot, or an empty string if t or slot is invalid.
+	 *  @see                    CreateTemplate, GetTemplateSlotCount
+	 */
+	const char*              GetTemplateSlotName(int t, int slot)const;
+
+	/**
+	 *  Runs a template with the given slot values, as @ref RunString would run the filled-in input.
+	 *  After a run without errors, model definitions in the template that contain no slots
+	 *  (SOLUTION_SPECIES, PHASES, RATES, ...) remain defined in this instance and are left out of
+	 *  later runs of the same template, so they are not read and tidied again.  Any other run or
+	 *  database load on this instance in between causes the next run to send the full input.
+	 *  @param t                The template number returned by @ref CreateTemplate.
+	 *  @param values           Array of @ref GetTemplateSlotCount values, in slot order.
+	 *  @return                 The number of errors encountered during the run.
+	 *  @see                    CreateTemplate, RunString
+	 *  @pre
+	 *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+	 */
+	int                      RunTemplate(int t, const double* values);
+
+	/**
+	 *  Saves solutions, exchangers, gas phases, kinetics, equilibrium-phase and solid-solution assemblages,
+	 *  surfaces, temperatures and pressures numbered start through end to a binary file
+	 *  (see CStateSnapshot.hxx for the layout).  The file can be loaded only into an instance
+	 *  that has loaded the same database.
+	 *  @param start            The first user number.
+	 *  @param end              The last user number.
+	 *  @param filename         Name of the file to write.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    LoadState, SaveStateBuffer
+	 */
+	int                      SaveState(int start, int end, const char* filename);
+
+	/**
+	 *  Loads a file written by @ref SaveState.  Entities in the file replace entities with the same user numbers.
+	 *  @param filename         Name of the file to read.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    LoadStateBuffer, SaveState
+	 *  @pre
+	 *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+	 */
+	int                      LoadState(const char* filename);
+
+	/**
+	 *  Saves the same snapshot as @ref SaveState to a buffer held by this instance,
+	 *  retrieved with @ref GetStateBuffer and @ref GetStateBufferSize.
+	 *  @param start            The first user number.
+	 *  @param end              The last user number.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    LoadStateBuffer, SaveState
+	 */
+	int                      SaveStateBuffer(int start, int end);
+
+	/**
+	 *  Retrieves the buffer filled by @ref SaveStateBuffer; it is valid until the next call to @ref SaveStateBuffer.
+	 *  @return                 The snapshot, or NULL if there is none.
+	 *  @see                    GetStateBufferSize, SaveStateBuffer
+	 */
+	const void*              GetStateBuffer(void)const;
+
+	/**
+	 *  Retrieves the size in bytes of the buffer filled by @ref SaveStateBuffer.
+	 *  @return                 The size of the snapshot.
+	 *  @see                    GetStateBuffer, SaveStateBuffer
+	 */
+	int                      GetStateBufferSize(void)const;
+
+	/**
+	 *  Loads a snapshot created by @ref SaveStateBuffer or read from a file written by @ref SaveState.
+	 *  @param buffer           The snapshot.
+	 *  @param size             The size of the snapshot in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    LoadState, SaveStateBuffer
+	 *  @pre
+	 *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+	 */
+	int                      LoadStateBuffer(const void* buffer, int size);
+
+	/**
+	 *  Packs the solution numbered n_user into a binary blob (a one-entity @ref SaveState snapshot)
+	 *  held by this instance, without formatting it as <B>SOLUTION_RAW</B> text.  The blob is valid
+	 *  until the next Get...Blob call on this instance and can be passed to @ref SetSolutionBlob of any
+	 *  instance that has loaded the same database.
+	 *  @param n_user           The user number of the solution.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such solution.
+	 *  @see                    SetSolutionBlob, SaveStateBuffer
+	 */
+	const void*              GetSolutionBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the solution packed by @ref GetSolutionBlob under user number n_user,
+	 *  replacing any solution with that number.  Snapshots written by @ref SaveStateBuffer
+	 *  are rejected, even if they hold a single solution.
+	 *  @param n_user           The user number to store the solution under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetSolutionBlob, LoadStateBuffer
+	 *  @pre
+	 *      @ref LoadDatabase/@ref LoadDatabaseString must have been called and returned 0 (zero) errors.
+	 */
+	int                      SetSolutionBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the exchanger numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the exchanger.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such exchanger.
+	 *  @see                    SetExchangeBlob
+	 */
+	const void*              GetExchangeBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the exchanger packed by @ref GetExchangeBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the exchanger under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetExchangeBlob
+	 */
+	int                      SetExchangeBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the surface numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the surface.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such surface.
+	 *  @see                    SetSurfaceBlob
+	 */
+	const void*              GetSurfaceBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the surface packed by @ref GetSurfaceBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the surface under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetSurfaceBlob
+	 */
+	int                      SetSurfaceBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the gas phase numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the gas phase.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such gas phase.
+	 *  @see                    SetGasPhaseBlob
+	 */
+	const void*              GetGasPhaseBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the gas phase packed by @ref GetGasPhaseBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the gas phase under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetGasPhaseBlob
+	 */
+	int                      SetGasPhaseBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the equilibrium-phase assemblage numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the equilibrium-phase assemblage.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such equilibrium-phase assemblage.
+	 *  @see                    SetEquilibriumPhasesBlob
+	 */
+	const void*              GetEquilibriumPhasesBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the equilibrium-phase assemblage packed by @ref GetEquilibriumPhasesBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the equilibrium-phase assemblage under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetEquilibriumPhasesBlob
+	 */
+	int                      SetEquilibriumPhasesBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the solid-solution assemblage numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the solid-solution assemblage.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such solid-solution assemblage.
+	 *  @see                    SetSolidSolutionsBlob
+	 */
+	const void*              GetSolidSolutionsBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the solid-solution assemblage packed by @ref GetSolidSolutionsBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the solid-solution assemblage under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetSolidSolutionsBlob
+	 */
+	int                      SetSolidSolutionsBlob(int n_user, const void* blob, int size);
+
+	/**
+	 *  Packs the kinetic reactant set numbered n_user into a binary blob; see @ref GetSolutionBlob.
+	 *  @param n_user           The user number of the kinetic reactant set.
+	 *  @param size             Receives the size of the blob in bytes.
+	 *  @return                 The blob, or NULL if there is no such kinetic reactant set.
+	 *  @see                    SetKineticsBlob
+	 */
+	const void*              GetKineticsBlob(int n_user, int* size);
+
+	/**
+	 *  Stores the kinetic reactant set packed by @ref GetKineticsBlob under user number n_user; see @ref SetSolutionBlob.
+	 *  @param n_user           The user number to store the kinetic reactant set under.
+	 *  @param blob             The blob.
+	 *  @param size             The size of the blob in bytes.
+	 *  @return                 The number of errors encountered.
+	 *  @see                    GetKineticsBlob
+	 */
+	int                      SetKineticsBlob(int n_user, const void* blob, int size);
+
 	/**
 	 *  Sets a C callback function for Basic programs. The syntax for the Basic command is
 	 *  10 result = CALLBACK(x1, x2, string$)
@@ -735,6 +1062,32 @@ public:
 	 */
 	VRESULT                  SetCurrentSelectedOutputUserNumber(int n);
 
+	/**
+	 *  Sets a callback function that receives each completed <B>SELECTED_OUTPUT</B> row.  While a callback is set,
+	 *  rows are passed to the callback and then discarded, so that memory use does not grow with the length of the run;
+	 *  only the headings remain available through @ref GetSelectedOutputValue.  The syntax for the C function is
+	 *  int my_callback(int n_user, int ncols, const char* const* headings, const VAR* values, void *cookie)
+	 *  where n_user is the <B>SELECTED_OUTPUT</B> user number.  The headings and values are only valid during the call.
+	 *  Return 0 to continue; a nonzero return adds an error and stops the run.
+	 *  @param fcn              The name of a user-defined function, or NULL to keep rows in memory (the default).
+	 *  @param cookie           A user defined value to be passed to the callback function.
+	 *  @see                    GetSelectedOutputRowCount, GetSelectedOutputValue
+	 */
+	void                     SetSelectedOutputCallback(PFN_SELECTED_OUTPUT_CALLBACK fcn, void *cookie);
+
+	/**
+	 *  Sets the delta export switch.  While on, <B>DUMP</B> output and @ref SaveState/@ref SaveStateBuffer
+	 *  contain only the entities saved, copied, deleted or loaded since they were last exported, so the cost
+	 *  of an export follows the number of changed cells rather than the size of the grid.  Keywords that
+	 *  can change entities in ways that are not tracked (definitions, <B>*_MODIFY</B>, <B>TRANSPORT</B>,
+	 *  <B>ADVECTION</B>, <B>COPY</B>, ...) mark all entities changed.  A delta snapshot also lists deleted
+	 *  user numbers, which @ref LoadState removes.  Changes are only tracked while the switch is on, so
+	 *  turning it on makes the next export contain all entities.  The initial setting is false.
+	 *  @param bValue           If true, turns on delta exports; if false, exports contain all selected entities.
+	 *  @see                    GetDeltaExportOn, SaveState, SetDumpFileOn, SetDumpStringOn
+	 */
+	void                     SetDeltaExportOn(bool bValue);
+
 	/**
 	 *  Sets the name of the dump file.  This file name is used if not specified within <B>DUMP</B> input.
 	 *  The default value is <B><I>dump.id.out</I></B>, where id is obtained from @ref GetId.
@@ -999,11 +1352,52 @@ public:
    */
   std::string             GetSolutionList2(int id);
 
+  // log K cache functions
+  /**
+   * Returns the number of times cached log K values were reused
+   */
+  int                     GetLogkCacheHits(void);
+  /**
+   * Returns the number of times log K values were calculated and cached
+   */
+  int                     GetLogkCacheMisses(void);
+
+  // model cache functions
+  /**
+   * Returns the number of times species, phases and mass-action equations
+   * of a cached model were reused
+   */
+  int                     GetModelCacheHits(void);
+  /**
+   * Returns the number of times a model was built without a cached match
+   */
+  int                     GetModelCacheMisses(void);
+
+  // allocation statistics
+  /**
+   * Returns the number of bytes currently allocated by the PHREEQC kernel (PHRQ_malloc)
+   */
+  double                  GetAllocatedBytes(void);
+  /**
+   * Returns the largest number of bytes allocated at one time by the PHREEQC kernel
+   */
+  double                  GetPeakAllocatedBytes(void);
+  /**
+   * Returns the cumulative number of bytes allocated by the PHREEQC kernel; a reallocation adds only its growth
+   */
+  double                  GetTotalAllocatedBytes(void);
+  /**
+   * Returns the cumulative number of allocations made by the PHREEQC kernel, not counting reallocations
+   */
+  double                  GetAllocationCount(void);
+
 public:
 	// overrides
 	virtual void error_msg(const char *str, bool stop=false);
 	virtual void log_msg(const char * str);
 	virtual void output_msg(const char *str);
+	virtual bool log_active(void);
+	virtual bool output_active(void);
 	virtual void punch_msg(const char *str);
 	virtual void screen_msg(const char *str);
 	virtual void warning_msg(const char *str);
@@ -1015,6 +1409,7 @@ public:
 
 	virtual bool output_open(const char *file_name, std::ios_base::openmode mode = std::ios_base::out);
 	virtual bool punch_open(const char *file_name, std::ios_base::openmode mode = std::ios_base::out, int n_user = 1);
+	virtual std::istream * open_include(const char *file_name);
 
 protected:
 	int EndRow(void);
@@ -1024,12 +1419,20 @@ protected:
 	void check_database(const char* sz_routine);
 	int close_input_files(void);
 	int close_output_files(void);
+	void close_binary_files(void);
 	void open_output_files(const char* sz_routine);
 
 	void do_run(const char* sz_routine, std::istream* pis, PFN_PRERUN_CALLBACK pfn_pre, PFN_POSTRUN_CALLBACK pfn_post, void *cookie);
 
 	void update_errors(void);
 
+	int save_state(const char* sz_routine, int start, int end, std::vector< unsigned char >& buffer);
+	int load_state(const char* sz_routine, const unsigned char* data, size_t size);
+	unsigned long long model_hash(void)const;
+	void clear_exported(int start, int end);
+	const void* get_blob(const char* sz_routine, int type, int n_user, int* size);
+	int set_blob(const char* sz_routine, int type, int n_user, const void* blob, int size);
+
 	int load_db(const char* filename);
 	int load_db_str(const char* filename);
 	int test_db(void);
@@ -1059,31 +1462,44 @@ protected:
 	bool                       DumpOn;
 
 	bool                       DumpStringOn;
+	bool                       DeltaExportOn;
 
 	bool                       OutputStringOn;
 	std::string                OutputString;
-	std::vector< std::string > OutputLines;
+	CLineIndex                 OutputLines;
 
 	bool                       LogStringOn;
 	std::string                LogString;
-	std::vector< std::string > LogLines;
+	CLineIndex                 LogLines;
 
 	bool                       ErrorStringOn;
 	IErrorReporter            *ErrorReporter;
 	std::string                ErrorString;
-	std::vector< std::string > ErrorLines;
+	CLineIndex                 ErrorLines;
 
 	bool                       WarningStringOn;
 	IErrorReporter            *WarningReporter;
 	std::string                WarningString;
-	std::vector< std::string > WarningLines;
+	CLineIndex                 WarningLines;
 
 	int                                           CurrentSelectedOutputUserNumber;
 	std::map< int, CSelectedOutput* >             SelectedOutputMap;
+	PFN_SELECTED_OUTPUT_CALLBACK                  SelectedOutputCallback;
+	void                                         *SelectedOutputCookie;
+	std::vector< const char* >                    SelectedOutputRowHeadings;
+	std::vector< VAR >                            SelectedOutputRowValues;
 	std::string                                   StringInput;
 
+	std::vector< CInputTemplate* >                Templates;
+	std::string                                   TemplateInput;
+	size_t                                        RunGeneration;
+
+	std::vector< unsigned char >                  StateBuffer;
+	std::vector< unsigned char >                  BlobBuffer;
+	std::map< std::string, std::string >          VirtualFiles;
+
 	std::string                DumpString;
-	std::vector< std::string > DumpLines;
+	CLineIndex                 DumpLines;
 
 	std::list< std::string >   Components;
 	std::list< std::string >   EquilibriumPhasesList;
@@ -1108,6 +1524,8 @@ protected:
 	const std::list<std::string> &GetExchangeNamesList() { return this->ExchangeNamesList; };
 
 	std::map< int, std::string > SelectedOutputFileNameMap;
+	std::map< int, std::string > SelectedOutputBinaryFileNameMap;
+	std::map< int, CSelectedOutputFile* > SelectedOutputBinaryMap;
 
 	std::string                OutputFileName;
 	std::string                ErrorFileName;
@@ -1116,7 +1534,7 @@ protected:
 
 	std::map< int, bool >                         SelectedOutputStringOn;
 	std::map< int, std::string >                  SelectedOutputStringMap;
-	std::map< int, std::vector< std::string > >   SelectedOutputLinesMap;
+	std::map< int, CLineIndex >                   SelectedOutputLinesMap;
 
 protected:
 	Phreeqc* PhreeqcPtr;
@@ -1,6 +1,7 @@
 #ifndef _INC_IPHREEQC_CALLBACKS_H
 #define _INC_IPHREEQC_CALLBACKS_H
 
+#include "Var.h"                    /* VAR */
 
 #if defined(__cplusplus)
 extern "C" {
@@ -11,6 +12,9 @@ typedef int (*PFN_PRERUN_CALLBACK)(void *cookie);
 typedef int (*PFN_POSTRUN_CALLBACK)(void *cookie);
 typedef int (*PFN_CATCH_CALLBACK)(void *cookie);
 
+/* called once for each completed SELECTED_OUTPUT row; headings and values are only valid during the call; a nonzero return stops the run */
+typedef int (*PFN_SELECTED_OUTPUT_CALLBACK)(int n_user, int ncols, const char* const* headings, const VAR* values, void *cookie);
+
 
 #if defined(__cplusplus)
 }
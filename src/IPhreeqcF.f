@@ -301,6 +301,19 @@
           GetOutputStringOn = .TRUE.
         ENDIF
       END FUNCTION GetOutputStringOn
+!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+      FUNCTION GetSelectedOutputColumn(ID,COL,VALUES,N,ROWS)
+        IMPLICIT NONE
+        INTEGER(KIND=4) :: ID
+        INTEGER(KIND=4) :: COL
+        REAL(KIND=8)    :: VALUES(*)
+        INTEGER(KIND=4) :: N
+        INTEGER(KIND=4) :: ROWS
+        INTEGER(KIND=4) :: GetSelectedOutputColumn
+        INTEGER(KIND=4) :: GetSelectedOutputColumnF
+        GetSelectedOutputColumn = GetSelectedOutputColumnF(ID,COL,
+     &                     VALUES,N,ROWS)
+      END FUNCTION GetSelectedOutputColumn
 !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
       FUNCTION GetSelectedOutputColumnCount(ID)
         IMPLICIT NONE
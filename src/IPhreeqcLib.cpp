@@ -124,6 +124,24 @@ GetCurrentSelectedOutputUserNumber(int id)
 	return IPQ_BADINSTANCE;
 }
 
+int
+GetDeltaExportOn(int id)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		if (IPhreeqcPtr->GetDeltaExportOn())
+		{
+			return 1;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+	return IPQ_BADINSTANCE;
+}
+
 const char*
 GetDumpFileName(int id)
 {
@@ -472,6 +490,21 @@ GetOutputStringLineCount(int id)
 	return 0;
 }
 
+int
+GetOutputLines(int id, int start, int count, const char** lines)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		if (start < 0 || count < 0 || !lines)
+		{
+			return IPQ_INVALIDARG;
+		}
+		return IPhreeqcPtr->GetOutputLines(start, count, lines);
+	}
+	return IPQ_BADINSTANCE;
+}
+
 int
 GetOutputStringOn(int id)
 {
@@ -501,6 +534,70 @@ GetSelectedOutputColumnCount(int id)
 	return IPQ_BADINSTANCE;
 }
 
+IPQ_RESULT
+GetSelectedOutputColumn(int id, int col, double* values, int n, int* rows)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		switch (IPhreeqcPtr->GetSelectedOutputColumn(col, values, n, rows))
+		{
+		case VR_OK:          return IPQ_OK;
+		case VR_INVALIDARG:  return IPQ_INVALIDARG;
+		case VR_INVALIDCOL:  return IPQ_INVALIDCOL;
+		default:
+			assert(false);
+		}
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const char*
+GetSelectedOutputBinaryFileName(int id)
+{
+	static const char empty[] = "";
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetSelectedOutputBinaryFileName();
+	}
+	return empty;
+}
+
+IPQ_RESULT
+SetSelectedOutputBinaryFileName(int id, const char* filename)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		IPhreeqcPtr->SetSelectedOutputBinaryFileName(filename);
+		return IPQ_OK;
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+LoadSelectedOutputBinaryFile(int id, const char* filename)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->LoadSelectedOutputBinaryFile(filename);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+ConvertSelectedOutputBinaryFile(int id, const char* binary_filename, const char* text_filename)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->ConvertSelectedOutputBinaryFile(binary_filename, text_filename);
+	}
+	return IPQ_BADINSTANCE;
+}
+
 int
 GetSelectedOutputCount(int id)
 {
@@ -756,6 +853,22 @@ OutputWarningString(int id)
 #endif
 }
 
+IPQ_RESULT
+RegisterVirtualFile(int id, const char* name, const char* data, int len)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		switch (IPhreeqcPtr->RegisterVirtualFile(name, data, len))
+		{
+		case VR_INVALIDARG: return IPQ_INVALIDARG;
+		case VR_OK:         return IPQ_OK;
+		default:            assert(false);
+		}
+	}
+	return IPQ_BADINSTANCE;
+}
+
 int
 RunAccumulated(int id)
 {
@@ -789,6 +902,280 @@ RunString(int id, const char* input)
 	return IPQ_BADINSTANCE;
 }
 
+int
+CreateTemplate(int id, const char* input)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		int t = IPhreeqcPtr->CreateTemplate(input);
+		return (t < 0) ? IPQ_INVALIDARG : t;
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+GetTemplateSlotCount(int id, int t)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		int n = IPhreeqcPtr->GetTemplateSlotCount(t);
+		return (n < 0) ? IPQ_INVALIDARG : n;
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const char*
+GetTemplateSlotName(int id, int t, int slot)
+{
+	static const char empty[] = "";
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetTemplateSlotName(t, slot);
+	}
+	return empty;
+}
+
+int
+RunTemplate(int id, int t, const double* values)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->RunTemplate(t, values);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+SaveState(int id, int start, int end, const char* filename)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SaveState(start, end, filename);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+LoadState(int id, const char* filename)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->LoadState(filename);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+SaveStateBuffer(int id, int start, int end)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SaveStateBuffer(start, end);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetStateBuffer(int id)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetStateBuffer();
+	}
+	return NULL;
+}
+
+int
+GetStateBufferSize(int id)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetStateBufferSize();
+	}
+	return IPQ_BADINSTANCE;
+}
+
+int
+LoadStateBuffer(int id, const void* buffer, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->LoadStateBuffer(buffer, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetSolutionBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetSolutionBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetSolutionBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetSolutionBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetExchangeBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetExchangeBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetExchangeBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetExchangeBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetSurfaceBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetSurfaceBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetSurfaceBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetSurfaceBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetGasPhaseBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetGasPhaseBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetGasPhaseBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetGasPhaseBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetEquilibriumPhasesBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetEquilibriumPhasesBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetEquilibriumPhasesBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetEquilibriumPhasesBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetSolidSolutionsBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetSolidSolutionsBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetSolidSolutionsBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetSolidSolutionsBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
+const void*
+GetKineticsBlob(int id, int n_user, int* size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->GetKineticsBlob(n_user, size);
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+int
+SetKineticsBlob(int id, int n_user, const void* blob, int size)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		return IPhreeqcPtr->SetKineticsBlob(n_user, blob, size);
+	}
+	return IPQ_BADINSTANCE;
+}
+
 IPQ_RESULT
 SetBasicCallback(int id, double (*fcn)(double x1, double x2, const char *str, void *cookie), void *cookie1)
 {
@@ -800,6 +1187,17 @@ SetBasicCallback(int id, double (*fcn)(double x1, double x2, const char *str, vo
 	}
 	return IPQ_BADINSTANCE;
 }
+IPQ_RESULT
+SetSelectedOutputCallback(int id, PFN_SELECTED_OUTPUT_CALLBACK fcn, void *cookie)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		IPhreeqcPtr->SetSelectedOutputCallback(fcn, cookie);
+		return IPQ_OK;
+	}
+	return IPQ_BADINSTANCE;
+}
 #if !defined(R_SO)
 #ifdef IPHREEQC_NO_FORTRAN_MODULE
 IPQ_RESULT
@@ -843,6 +1241,18 @@ SetCurrentSelectedOutputUserNumber(int id, int n)
 	return IPQ_BADINSTANCE;
 }
 
+IPQ_RESULT
+SetDeltaExportOn(int id, int value)
+{
+	IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+	if (IPhreeqcPtr)
+	{
+		IPhreeqcPtr->SetDeltaExportOn(value != 0);
+		return IPQ_OK;
+	}
+	return IPQ_BADINSTANCE;
+}
+
 IPQ_RESULT
 SetDumpFileName(int id, const char* filename)
 {
@@ -1428,6 +1838,92 @@ GetSolutionList(int id)
   return err_msg;
 }
 
+// log K cache
+int
+GetLogkCacheHits(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetLogkCacheHits();
+  }
+  return -99;
+}
+int
+GetLogkCacheMisses(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetLogkCacheMisses();
+  }
+  return -99;
+}
+
+// model cache
+int
+GetModelCacheHits(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetModelCacheHits();
+  }
+  return -99;
+}
+int
+GetModelCacheMisses(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetModelCacheMisses();
+  }
+  return -99;
+}
+
+// allocation statistics
+double
+GetAllocatedBytes(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetAllocatedBytes();
+  }
+  return -99;
+}
+double
+GetPeakAllocatedBytes(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetPeakAllocatedBytes();
+  }
+  return -99;
+}
+double
+GetTotalAllocatedBytes(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetTotalAllocatedBytes();
+  }
+  return -99;
+}
+double
+GetAllocationCount(int id)
+{
+  IPhreeqc* IPhreeqcPtr = IPhreeqcLib::GetInstance(id);
+  if (IPhreeqcPtr)
+  {
+    return IPhreeqcPtr->GetAllocationCount();
+  }
+  return -99;
+}
+
 
 //// static method
 //void IPhreeqcLib::CleanupIPhreeqcInstances(void)
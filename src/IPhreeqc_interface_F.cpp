@@ -239,6 +239,13 @@ GetOutputFileOnF(int *id)
 	return ::GetOutputFileOn(*id);
 }
 
+IPQ_RESULT
+GetSelectedOutputColumnF(int *id, int *col, double* values, int *n, int *rows)
+{
+	int adjcol = *col - 1;
+	return ::GetSelectedOutputColumn(*id, adjcol, values, *n, rows);
+}
+
 int
 GetSelectedOutputColumnCountF(int *id)
 {
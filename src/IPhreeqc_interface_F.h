@@ -36,6 +36,7 @@
 #define GetOutputStringLineF                FC_FUNC (getoutputstringlinef,                GETOUTPUTSTRINGLINEF)
 #define GetOutputStringLineCountF           FC_FUNC (getoutputstringlinecountf,           GETOUTPUTSTRINGLINECOUNTF)
 #define GetOutputStringOnF                  FC_FUNC (getoutputstringonf,                  GETOUTPUTSTRINGONF)
+#define GetSelectedOutputColumnF            FC_FUNC (getselectedoutputcolumnf,            GETSELECTEDOUTPUTCOLUMNF)
 #define GetSelectedOutputColumnCountF       FC_FUNC (getselectedoutputcolumncountf,       GETSELECTEDOUTPUTCOLUMNCOUNTF)
 #define GetSelectedOutputCountF             FC_FUNC (getselectedoutputcountf,             GETSELECTEDOUTPUTCOUNTF)
 #define GetSelectedOutputFileNameF          FC_FUNC (getselectedoutputfilenamef,          GETSELECTEDOUTPUTFILENAMEF)
@@ -112,6 +113,7 @@ extern "C" {
   IPQ_DLL_EXPORT void       GetOutputStringLineF(int *id, int* n, char* line, int* line_length);
   IPQ_DLL_EXPORT int        GetOutputStringLineCountF(int *id);
   IPQ_DLL_EXPORT int        GetOutputStringOnF(int *id);
+  IPQ_DLL_EXPORT IPQ_RESULT GetSelectedOutputColumnF(int *id, int *col, double* values, int *n, int *rows);
   IPQ_DLL_EXPORT int        GetSelectedOutputColumnCountF(int *id);
   IPQ_DLL_EXPORT int        GetSelectedOutputCountF(int *id);
   IPQ_DLL_EXPORT void       GetSelectedOutputFileNameF(int *id, char* filename, int* filename_length);
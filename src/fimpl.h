@@ -126,6 +126,10 @@ IPQ_DLL_EXPORT int  IPQ_DECL IPQ_CASE_UND(getoutputstringon, GETOUTPUTSTRINGON,
 {
 	return GetOutputStringOnF(id);
 }
+IPQ_DLL_EXPORT int  IPQ_DECL IPQ_CASE_UND(getselectedoutputcolumn, GETSELECTEDOUTPUTCOLUMN, getselectedoutputcolumn_, GETSELECTEDOUTPUTCOLUMN_)(int *id, int *col, double* values, int *n, int *rows)
+{
+	return GetSelectedOutputColumnF(id, col, values, n, rows);
+}
 IPQ_DLL_EXPORT int  IPQ_DECL IPQ_CASE_UND(getselectedoutputcolumncount, GETSELECTEDOUTPUTCOLUMNCOUNT, getselectedoutputcolumncount_, GETSELECTEDOUTPUTCOLUMNCOUNT_)(int *id)
 {
 	return GetSelectedOutputColumnCountF(id);
@@ -40,6 +40,7 @@
 #define GetOutputStringLineF                FC_FUNC (getoutputstringlinef,                GETOUTPUTSTRINGLINEF)
 #define GetOutputStringLineCountF           FC_FUNC (getoutputstringlinecountf,           GETOUTPUTSTRINGLINECOUNTF)
 #define GetOutputStringOnF                  FC_FUNC (getoutputstringonf,                  GETOUTPUTSTRINGONF)
+#define GetSelectedOutputColumnF            FC_FUNC (getselectedoutputcolumnf,            GETSELECTEDOUTPUTCOLUMNF)
 #define GetSelectedOutputColumnCountF       FC_FUNC (getselectedoutputcolumncountf,       GETSELECTEDOUTPUTCOLUMNCOUNTF)
 #define GetSelectedOutputCountF             FC_FUNC (getselectedoutputcountf,             GETSELECTEDOUTPUTCOUNTF)
 #define GetSelectedOutputFileNameF          FC_FUNC (getselectedoutputfilenamef,          GETSELECTEDOUTPUTFILENAMEF)
@@ -115,6 +116,7 @@ extern "C" {
   void       GetOutputStringLineF(int *id, int* n, char* line, size_t line_length);
   int        GetOutputStringLineCountF(int *id);
   int        GetOutputStringOnF(int *id);
+  IPQ_RESULT GetSelectedOutputColumnF(int *id, int *col, double* values, int *n, int *rows);
   int        GetSelectedOutputColumnCountF(int *id);
   int        GetSelectedOutputCountF(int *id);
   void       GetSelectedOutputFileNameF(int *id, char* filename, size_t filename_length);
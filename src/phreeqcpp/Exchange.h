@@ -19,6 +19,12 @@ public:
 	cxxExchange(const std::map < int, cxxExchange > &exchange_map,
 		cxxMix & mx, int n_user, PHRQ_io *io=NULL);
 	~cxxExchange();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxExchange(const cxxExchange &) = default;
+	cxxExchange(cxxExchange &&) = default;
+	cxxExchange & operator = (const cxxExchange &) = default;
+	cxxExchange & operator = (cxxExchange &&) = default;
+#endif
 
 	void dump_raw(std::ostream & s_oss, unsigned int indent, int *n_out=NULL) const;
 
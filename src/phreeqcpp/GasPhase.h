@@ -20,6 +20,12 @@ class cxxGasPhase:public cxxNumKeyword
 	cxxGasPhase(std::map < int, cxxGasPhase > &entity_map,
 		cxxMix & mx, int n_user, PHRQ_io * io=NULL);
 	 ~cxxGasPhase();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxGasPhase(const cxxGasPhase &) = default;
+	cxxGasPhase(cxxGasPhase &&) = default;
+	cxxGasPhase & operator = (const cxxGasPhase &) = default;
+	cxxGasPhase & operator = (cxxGasPhase &&) = default;
+#endif
 
 	enum GP_TYPE
 	{
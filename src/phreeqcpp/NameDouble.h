@@ -34,6 +34,12 @@ class IPQ_DLL_EXPORT cxxNameDouble:public
 	cxxNameDouble(class name_coef *nc, int count);
 	cxxNameDouble(const cxxNameDouble & old, LDBLE factor);
 	 ~cxxNameDouble();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxNameDouble(const cxxNameDouble &) = default;
+	cxxNameDouble(cxxNameDouble &&) = default;
+	cxxNameDouble & operator = (const cxxNameDouble &) = default;
+	cxxNameDouble & operator = (cxxNameDouble &&) = default;
+#endif
 
 	LDBLE Get_total_element(const char *string) const;
 	cxxNameDouble Simplify_redox(void) const;
@@ -11,6 +11,12 @@ class cxxNumKeyword: public PHRQ_base
   public:
 	cxxNumKeyword(PHRQ_io *io=NULL);
 	virtual ~ cxxNumKeyword();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxNumKeyword(const cxxNumKeyword &) = default;
+	cxxNumKeyword(cxxNumKeyword &&) = default;
+	cxxNumKeyword & operator = (const cxxNumKeyword &) = default;
+	cxxNumKeyword & operator = (cxxNumKeyword &&) = default;
+#endif
 	const std::string &Get_description() const
 	{
 		return this->description;
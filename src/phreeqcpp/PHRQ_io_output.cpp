@@ -51,6 +51,14 @@ echo_msg(const char *str)
 	}
 }
 
+/* ---------------------------------------------------------------------- */
+bool Phreeqc::
+echo_active(void)
+/* ---------------------------------------------------------------------- */
+{
+	return pr.echo_input == TRUE && phrq_io && phrq_io->echo_active();
+}
+
 /* ---------------------------------------------------------------------- */
 void Phreeqc::
 set_forward_output_to_log(int value)
@@ -363,7 +371,7 @@ void Phreeqc::
 output_msg(const char * str)
 /* ---------------------------------------------------------------------- */
 {
-	if (phrq_io)
+	if (phrq_io && !discard_output)
 	{
 		if (get_forward_output_to_log())
 		{
@@ -375,6 +383,17 @@ output_msg(const char * str)
 		}
 	}
 }
+/* ---------------------------------------------------------------------- */
+bool Phreeqc::
+output_active(void)
+/* ---------------------------------------------------------------------- */
+{
+	if (phrq_io)
+	{
+		return get_forward_output_to_log() ? phrq_io->log_active() : phrq_io->output_active();
+	}
+	return false;
+}
 // ---------------------------------------------------------------------- */
 // punch file methods
 // ---------------------------------------------------------------------- */
@@ -19,6 +19,12 @@ class cxxPPassemblage:public cxxNumKeyword
 	cxxPPassemblage(const std::map < int, cxxPPassemblage > &entity_map,
 					  cxxMix & mx, int n_user, PHRQ_io * io=NULL);
 	~cxxPPassemblage();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxPPassemblage(const cxxPPassemblage &) = default;
+	cxxPPassemblage(cxxPPassemblage &&) = default;
+	cxxPPassemblage & operator = (const cxxPPassemblage &) = default;
+	cxxPPassemblage & operator = (cxxPPassemblage &&) = default;
+#endif
 
 	void dump_raw(std::ostream & s_oss, unsigned int indent, int *n_out=NULL) const;
 
@@ -14,6 +14,7 @@
 #include "PBasic.h"
 #include "Temperature.h"
 #include "SSassemblage.h"
+#include "Serializer.h"
 
 #if defined(PHREEQCI_GUI)
 #ifdef _DEBUG
@@ -846,6 +847,16 @@ void Phreeqc::init(void)
 	current_pa                      = NAN;
 	current_mu                      = NAN;
 	mu_terms_in_logk                = true;
+	logk_cache.clear();
+	logk_cache_max                  = 16;
+	logk_cache_model                = 0;
+	logk_cache_model_count          = 0;
+	logk_cache_hits                 = 0;
+	logk_cache_misses               = 0;
+	model_cache.clear();
+	model_cache_max                 = 16;
+	model_cache_hits                = 0;
+	model_cache_misses              = 0;
 	current_A                       = 0.0;
 	current_x                       = 0.0;
 	fix_current                     = 0.0;
@@ -1251,6 +1262,7 @@ void Phreeqc::init(void)
 	negative_concentrations = FALSE;
 	calculating_deriv		= FALSE;
 	numerical_deriv			= FALSE;
+	sparse_newton			= FALSE;
 	count_total_steps       = 0;
 	phast                   = FALSE;
 	output_newline          = true;
@@ -1294,6 +1306,10 @@ void Phreeqc::init(void)
 	solution_volume         = 0;
 	/* phqalloc.cpp ------------------------------- */
 	s_pTail                 = NULL;
+	phrq_alloc_bytes        = 0;
+	phrq_alloc_peak         = 0;
+	phrq_alloc_total        = 0;
+	phrq_alloc_count        = 0;
 	/* Basic */
 	//basic_interpreter       = NULL;
 	basic_callback_ptr      = NULL;
@@ -1409,9 +1425,12 @@ void Phreeqc::init(void)
 	/* model.cpp ------------------------------- */
 	gas_in                  = FALSE;
 	min_value               = 1e-10;
+	sparse_solve_count      = 0;
+	sparse_fallback_count   = 0;
 
 	/* phrq_io_output.cpp ------------------------------- */
 	forward_output_to_log   = 0;
+	discard_output          = false;
 	/* phreeqc_files.cpp ------------------------------- */
 #ifdef NPP
 	default_data_base = "c:\\phreeqc\\database\\phreeqc.dat";
@@ -1472,6 +1491,13 @@ void Phreeqc::init(void)
 	// auto delete_info
 	// auto run_info
 	run_info.Set_io(phrq_io);
+	elements_map.Set_table(&strings_table);
+	species_map.Set_table(&strings_table);
+	phases_map.Set_table(&strings_table);
+	logk_map.Set_table(&strings_table);
+	Rxn_dirty.assign(Serializer::PT_PRESSURE + 1, std::set<int>());
+	Rxn_dirty_all.assign(Serializer::PT_PRESSURE + 1, true);
+	delta_export = false;
 	/* readtr.cpp */
 	// auto dump_file_name_cpp;
 	/* sit.cpp ------------------------------- */
@@ -1502,6 +1528,9 @@ void Phreeqc::init(void)
 	J_ij_count_spec         = 0;
 	m_s                     = NULL;
 	count_m_s               = 0;
+	m_s_size                = 0;
+	s_name_rank.clear();
+	mcd_elts.clear();
 	tot1_h                  = 0;
 	tot1_o                  = 0;
 	tot2_h                  = 0;
@@ -1554,6 +1583,16 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	current_pa = pSrc->current_pa;
 	current_mu = pSrc->current_mu;
 	mu_terms_in_logk = pSrc->mu_terms_in_logk;
+	logk_cache.clear();
+	logk_cache_max = pSrc->logk_cache_max;
+	logk_cache_model = 0;
+	logk_cache_model_count = 0;
+	logk_cache_hits = 0;
+	logk_cache_misses = 0;
+	model_cache.clear();
+	model_cache_max = pSrc->model_cache_max;
+	model_cache_hits = 0;
+	model_cache_misses = 0;
 
 	/* ----------------------------------------------------------------------
 	*   STRUCTURES
@@ -1982,6 +2021,7 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	negative_concentrations = pSrc->negative_concentrations;
 	calculating_deriv = pSrc->calculating_deriv;
 	numerical_deriv = pSrc->numerical_deriv;
+	sparse_newton = pSrc->sparse_newton;
 	count_total_steps = 0;
 	phast = FALSE;
 	output_newline = true;
@@ -2023,11 +2063,11 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	//screen_string;
 	spread_length = pSrc->spread_length;
 	//maps set by store below
-	//std::map<std::string, std::string*> strings_map;
-	//std::map<std::string, class element*> elements_map;
-	//std::map<std::string, class species*> species_map;
-	//std::map<std::string, class phase*> phases_map;
-	//std::map<std::string, class logk*> logk_map;
+	//StringTable strings_table;
+	//StringTableMap<class element> elements_map;
+	//StringTableMap<class species> species_map;
+	//StringTableMap<class phase> phases_map;
+	//StringTableMap<class logk> logk_map;
 	//std::map<std::string, class master_isotope*> master_isotope_map;
 	/* ----------------------------------------------------------------------
 	*   ISOTOPES
@@ -2120,6 +2160,10 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	solution_mass = pSrc->solution_mass;
 	solution_volume = pSrc->solution_volume;
 	s_pTail = NULL;
+	phrq_alloc_bytes = 0;
+	phrq_alloc_peak = 0;
+	phrq_alloc_total = 0;
+	phrq_alloc_count = 0;
 	//basic_interpreter = NULL;
 	/* cl1.cpp ------------------------------- */
 	//std::vector<double> x_arg, res_arg, scratch;
@@ -2220,6 +2264,8 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	/* model.cpp ------------------------------- */
 	gas_in = FALSE;
 	min_value = 1e-10;
+	sparse_solve_count = 0;
+	sparse_fallback_count = 0;
 	//std::vector<double> normal, ineq_array, res, cu, zero, delta1;
 	//std::vector<int> iu, is, back_eq;									 
 	/* phrq_io_output.cpp ------------------------------- */
@@ -2275,6 +2321,11 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	IPRSNT = pSrc->IPRSNT;
 	M = pSrc->M;
 	LGAMMA = pSrc->LGAMMA;
+	pz_terms = pSrc->pz_terms;
+	pz_alphas = pSrc->pz_alphas;
+	pz_g = pSrc->pz_g;
+	pz_gp = pSrc->pz_gp;
+	pz_exp = pSrc->pz_exp;
 	for (int i = 0; i < 23; i++)
 	{
 		BK[i] = pSrc->BK[i];
@@ -2318,6 +2369,7 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	sit_IPRSNT = pSrc->sit_IPRSNT;
 	sit_M = pSrc->sit_M;
 	sit_LGAMMA = pSrc->sit_LGAMMA;
+	sit_terms = pSrc->sit_terms;
 	s_list = pSrc->s_list;
 	cation_list = pSrc->cation_list;
 	neutral_list = pSrc->neutral_list;
@@ -2346,6 +2398,9 @@ Phreeqc::InternalCopy(const Phreeqc* pSrc)
 	J_ij_count_spec = pSrc->J_ij_count_spec;
 	m_s = NULL;
 	count_m_s = pSrc->count_m_s;
+	m_s_size = 0;
+	s_name_rank.clear();
+	mcd_elts.clear();
 	tot1_h = pSrc->tot1_h;
 	tot1_o = pSrc->tot1_o;
 	tot2_h = pSrc->tot2_h;
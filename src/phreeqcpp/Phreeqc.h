@@ -26,12 +26,14 @@ typedef unsigned char boolean;
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <list>
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
 #include <math.h>
 #include <errno.h>
 #include <float.h>
+#include <stdarg.h>
 #include "phrqtype.h"
 #include "cvdense.h"	
 #include "runner.h"
@@ -47,6 +49,7 @@ typedef unsigned char boolean;
 #include "cxxMix.h"
 #include "Use.h"
 #include "Surface.h"
+#include "StringTable.h"
 #ifdef SWIG_SHARED_OBJ
 #include "thread.h"
 #endif
@@ -250,6 +253,8 @@ public:
 	void output_flush(void);
 	void output_close(void);
 	void output_msg(const char* str);
+	bool output_active(void);
+	bool echo_active(void);
 
 	// punch_ostream
 	bool punch_open(const char* file_name, int n_user);
@@ -445,6 +450,7 @@ public:
 	int check_residuals(void);
 	int free_model_allocs(void);
 	int ineq(int kode);
+	int sparse_ineq(int rows, int cols, int stride);
 	int model(void);
 	int jacobian_sums(void);
 	int mb_gases(void);
@@ -504,6 +510,13 @@ public:
 #endif
 	void PHRQ_free(void* ptr);
 	void PHRQ_free_all(void);
+	// allocation statistics (USE_PHRQ_ALLOC only)
+	size_t get_alloc_bytes(void) { return phrq_alloc_bytes; }
+	size_t get_alloc_peak(void) { return phrq_alloc_peak; }
+	double get_alloc_total(void) { return phrq_alloc_total; }
+	double get_alloc_count(void) { return phrq_alloc_count; }
+protected:
+	void PHRQ_count_alloc(size_t size);
 
 public:
 
@@ -596,6 +609,10 @@ public:
 	int check_same_model(void);
 	int k_temp(LDBLE tc, LDBLE pa);
 	LDBLE k_calc(LDBLE* logk, LDBLE tempk, LDBLE presPa);
+	bool logk_cache_find(LDBLE tc, LDBLE pa);
+	void logk_cache_save(LDBLE tc, LDBLE pa);
+	model_cache_entry *model_cache_find(model_cache_entry &key);
+	void model_cache_save(model_cache_entry &key);
 	int prep(void);
 	int reprep(void);
 	int rewrite_master_to_secondary(class master* master_ptr1,
@@ -605,6 +622,8 @@ public:
 
 	// print.cpp -------------------------------
 	char* sformatf(const char* format, ...);
+	char* vformatf(const char* format, va_list args);
+	void output_msgf(const char* format, ...);
 	int array_print(LDBLE* array_l, int row_count, int column_count,
 		int max_column_count);
 	int set_pr_in_false(void);
@@ -735,6 +754,14 @@ public:
 	int delete_entities(void);
 	int run_as_cells(void);
 	void dump_ostream(std::ostream& os);
+	void Set_delta_export(bool tf);
+	void mark_dirty(int type, int n_user, int n_user_end);
+	void mark_all_dirty(void);
+	void delete_cell(int n_user);
+	void get_dirty(int type, int start, int end, std::set<int>& numbers);
+	void clear_dirty(int type, int start, int end);
+	void dump_select_dirty(void);
+	void dump_clear_dirty(dumper& info);
 
 	// readtr.cpp -------------------------------
 	int read_transport(void);
@@ -1006,6 +1033,7 @@ public:
 	LDBLE moles_from_donnan_layer(cxxSurface* sptr, const char* name, LDBLE moles_needed);
 	LDBLE add_MCD_moles(LDBLE moles, LDBLE min_mol, int i, cxxSolution* sptr, const char* name);
 	int fill_m_s(class J_ij* J_ij, int J_ij_count_spec, int i, int stagnant);
+	const std::vector<class elt_list>& mcd_species_elts(const char* name);
 	static int sort_species_name(const void* ptr1, const void* ptr2);
 	int disp_surf(LDBLE stagkin_time);
 	int diff_stag_surf(int mobile_cell);
@@ -1054,7 +1082,7 @@ public:
 	char* string_duplicate(const char* token);
 #endif
 	const char* string_hsave(const char* str);
-	void strings_map_clear();
+	void strings_table_clear();
 protected:
 	char* string_pad(const char* str, int i);
 	static int string_trim(char* str);
@@ -1080,6 +1108,12 @@ public:
 
   // VITENS VIPHREEQC Extension functions
   cxxSolution * find_solution(int);
+  // log K cache statistics
+  int get_logk_cache_hits(void) { return logk_cache_hits; }
+  int get_logk_cache_misses(void) { return logk_cache_misses; }
+  // model cache statistics
+  int get_model_cache_hits(void) { return model_cache_hits; }
+  int get_model_cache_misses(void) { return model_cache_misses; }
   cxxGasPhase * find_gas_phase(int);
   cxxPPassemblage * find_equilibrium_phase(int);
   cxxSurface * find_surface(int);
@@ -1149,6 +1183,15 @@ protected:
 	LDBLE current_pa;
 	LDBLE current_mu;
 	bool mu_terms_in_logk;
+	/* log K cache, most recently used first */
+	std::list<logk_cache_entry> logk_cache;
+	size_t logk_cache_max;
+	int logk_cache_model, logk_cache_model_count;
+	int logk_cache_hits, logk_cache_misses;
+	/* rewritten model equations by master species, most recently used first */
+	std::list<model_cache_entry> model_cache;
+	size_t model_cache_max;
+	int model_cache_hits, model_cache_misses;
 
 	/* ----------------------------------------------------------------------
 	*   STRUCTURES
@@ -1249,6 +1292,12 @@ protected:
 	std::set<int> Rxn_new_ss_assemblage;
 	std::set<int> Rxn_new_surface;
 	std::set<int> Rxn_new_temperature;  // not used
+	/*
+	* Entities changed since the last delta export, indexed by Serializer::PACK_TYPE
+	*/
+	std::vector< std::set<int> > Rxn_dirty;
+	std::vector< bool > Rxn_dirty_all;
+	bool delta_export;                  // marks are only recorded while true
 	/*----------------------------------------------------------------------
 	*   Irreversible reaction
 	*---------------------------------------------------------------------- */
@@ -1588,6 +1637,7 @@ protected:
 	int negative_concentrations;
 	int calculating_deriv;
 	int numerical_deriv;
+	int sparse_newton;
 
 	int count_total_steps;
 	int phast;
@@ -1617,11 +1667,11 @@ protected:
 	*   Map definitions
 	*/
 
-	std::map<std::string, std::string*> strings_map;
-	std::map<std::string, class element*> elements_map;
-	std::map<std::string, class species*> species_map;
-	std::map<std::string, class phase*> phases_map;
-	std::map<std::string, class logk*> logk_map;
+	StringTable strings_table;
+	StringTableMap<class element> elements_map;
+	StringTableMap<class species> species_map;
+	StringTableMap<class phase> phases_map;
+	StringTableMap<class logk> logk_map;
 	std::map<std::string, class master_isotope*> master_isotope_map;
 
 #if defined(PHREEQCI_GUI)
@@ -1669,6 +1719,8 @@ protected:
 
 	/* phqalloc.cpp ------------------------------- */
 	PHRQMemHeader* s_pTail;
+	size_t phrq_alloc_bytes, phrq_alloc_peak;
+	double phrq_alloc_total, phrq_alloc_count;
 
 	/* Basic */
 	PBasic* basic_interpreter;
@@ -1754,9 +1806,17 @@ protected:
 	LDBLE min_value;
 	std::vector<double> normal, ineq_array, res, cu, zero, delta1;
 	std::vector<int> iu, is, back_eq;
+	std::vector<int> csr_row_start, csr_col;
+	std::vector<double> csr_val;
+	std::vector<int> sparse_col_map, sparse_order;
+	std::vector<LDBLE> sparse_b, sparse_sol;
+	std::vector< std::vector< std::pair<int, LDBLE> > > sparse_lu;
+	std::vector< std::pair<int, LDBLE> > sparse_merged;
+	int sparse_solve_count, sparse_fallback_count;
 
 	/* phrq_io_output.cpp ------------------------------- */
 	int forward_output_to_log;
+	bool discard_output;
 
 	/* phreeqc_files.cpp ------------------------------- */
 	std::string default_data_base;
@@ -1780,6 +1840,8 @@ protected:
 	class pitz_param* mcb0, * mcb1, * mcc0;
 	std::vector<int> IPRSNT;
 	std::vector<double> M, LGAMMA;
+	std::vector<class pitz_term> pz_terms;
+	std::vector<LDBLE> pz_alphas, pz_g, pz_gp, pz_exp;
 	LDBLE BK[23], DK[23];
 
 	LDBLE dummy;
@@ -1810,6 +1872,7 @@ protected:
 	int sit_MAXCATIONS, sit_FIRSTANION, sit_MAXNEUTRAL;
 	std::vector<int> sit_IPRSNT;
 	std::vector<double> sit_M, sit_LGAMMA;
+	std::vector<class pitz_term> sit_terms;
 	std::vector<int> s_list, cation_list, neutral_list, anion_list, ion_list, param_list;
 
 	/* tidy.cpp ------------------------------- */
@@ -1830,7 +1893,9 @@ protected:
 	int J_ij_count_spec;
 
 	class M_S* m_s;
-	int count_m_s;
+	int count_m_s, m_s_size;
+	std::vector<int> s_name_rank; /* alphabetical rank of s[i]->name, for sorting in fill_spec */
+	std::map<const char*, std::vector<class elt_list> > mcd_elts; /* elements in J_ij species, by saved name */
 	LDBLE tot1_h, tot1_o, tot2_h, tot2_o;
 	LDBLE diffc_max, diffc_tr, J_ij_sum;
 	int transp_surf;
@@ -1939,9 +2004,10 @@ namespace Utilities
 	template < typename T >
 	T* Rxn_find(std::map < int, T >& b, int i)
 	{
-		if (b.find(i) != b.end())
+		typename std::map < int, T >::iterator it = b.find(i);
+		if (it != b.end())
 		{
-			return (&(b.find(i)->second));
+			return (&(it->second));
 		}
 		else
 		{
@@ -1967,11 +2033,11 @@ namespace Utilities
 		it = b.find(i);
 		if (it != b.end())
 		{
-			b[j] = it->second;
-			it = b.find(j);
-			it->second.Set_n_user(j);
-			it->second.Set_n_user_end(j);
-			return &(it->second);
+			T& entity = b[j];
+			entity = it->second;
+			entity.Set_n_user(j);
+			entity.Set_n_user_end(j);
+			return &entity;
 		}
 		else
 		{
@@ -1983,19 +2049,44 @@ namespace Utilities
 	void Rxn_copies(std::map < int, T >& b, int n_user, int n_user_end)
 	{
 		if (n_user_end <= n_user) return;
-		typename std::map < int, T >::iterator it;
+		typename std::map < int, T >::iterator it, jt, hint;
 		it = b.find(n_user);
 		if (it != b.end())
 		{
+			// copies go in ascending order, insert each one just after the previous
+			jt = it;
 			for (int j = n_user + 1; j <= n_user_end; j++)
 			{
-				b[j] = it->second;
-				it = b.find(j);
-				it->second.Set_n_user(j);
-				it->second.Set_n_user_end(j);
+				hint = jt;
+				hint++;
+				if (hint != b.end() && hint->first == j)
+					jt = hint;
+				else
+					jt = b.insert(hint, typename std::map < int, T >::value_type(j, T()));
+				jt->second = it->second;
+				jt->second.Set_n_user(j);
+				jt->second.Set_n_user_end(j);
 			}
 		}
 	}
+	template < typename T >
+	T* Rxn_store(std::map < int, T >& b, int n_user, T& entity)
+	{
+		// saves entity as number n_user, an existing node is reused;
+		// entity is moved into the map where the compiler allows and left empty
+		typename std::map < int, T >::iterator it = b.lower_bound(n_user);
+		if (it == b.end() || it->first != n_user)
+		{
+			it = b.insert(it, typename std::map < int, T >::value_type(n_user, T()));
+		}
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+		it->second = std::move(entity);
+#else
+		it->second = entity;
+#endif
+		return &(it->second);
+	}
+
 	template < typename T >
 	int Rxn_read_raw(std::map < int, T >& m, std::set < int >& s, Phreeqc* phreeqc_cookie)
 	{
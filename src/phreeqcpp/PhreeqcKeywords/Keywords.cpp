@@ -17,7 +17,7 @@ Keywords::~Keywords(void)
 {
 }
 
-Keywords::KEYWORDS Keywords::Keyword_search(std::string key)
+Keywords::KEYWORDS Keywords::Keyword_search(const std::string &key)
 {
 	std::map<const std::string, Keywords::KEYWORDS>::const_iterator it;
 	it = phreeqc_keywords.find(key);
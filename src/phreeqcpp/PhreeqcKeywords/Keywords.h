@@ -89,7 +89,7 @@ public:
 	Keywords(void);
 	~Keywords(void);
 
-	static KEYWORDS Keyword_search(std::string key);
+	static KEYWORDS Keyword_search(const std::string &key);
 	static const std::string & Keyword_name_search(KEYWORDS key);
 
 	static const std::map<const std::string, KEYWORDS> phreeqc_keywords;
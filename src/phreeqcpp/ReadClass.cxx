@@ -22,7 +22,10 @@
 #include "runner.h"
 #include "cxxMix.h"
 #include "Surface.h"
+#include "Pressure.h"
+#include "Serializer.h"
 #include "phqalloc.h"
+#include <limits.h>
 
 #if defined(PHREEQCI_GUI)
 #ifdef _DEBUG
@@ -260,6 +263,46 @@ dump_entities(void)
 	}
 	return (OK);
 }
+template <typename T>
+static void map_numbers(std::map<int, T>& m, int start, int end, std::set<int>& numbers)
+{
+	typename std::map<int, T>::iterator it = m.lower_bound(start);
+	for (; it != m.end() && it->first <= end; it++)
+	{
+		numbers.insert(it->first);
+	}
+}
+static void entity_numbers(Phreeqc& p, int type, int start, int end, std::set<int>& numbers)
+{
+	start = (start < 0) ? 0 : start;
+	switch (type)
+	{
+	case Serializer::PT_SOLUTION:     map_numbers(p.Get_Rxn_solution_map(), start, end, numbers); break;
+	case Serializer::PT_EXCHANGE:     map_numbers(p.Get_Rxn_exchange_map(), start, end, numbers); break;
+	case Serializer::PT_GASPHASE:     map_numbers(p.Get_Rxn_gas_phase_map(), start, end, numbers); break;
+	case Serializer::PT_KINETICS:     map_numbers(p.Get_Rxn_kinetics_map(), start, end, numbers); break;
+	case Serializer::PT_PPASSEMBLAGE: map_numbers(p.Get_Rxn_pp_assemblage_map(), start, end, numbers); break;
+	case Serializer::PT_SSASSEMBLAGE: map_numbers(p.Get_Rxn_ss_assemblage_map(), start, end, numbers); break;
+	case Serializer::PT_SURFACES:     map_numbers(p.Get_Rxn_surface_map(), start, end, numbers); break;
+	case Serializer::PT_TEMPERATURE:  map_numbers(p.Get_Rxn_temperature_map(), start, end, numbers); break;
+	case Serializer::PT_PRESSURE:     map_numbers(p.Get_Rxn_pressure_map(), start, end, numbers); break;
+	}
+}
+static StorageBinListItem& bin_item(StorageBinList& bins, int type)
+{
+	switch (type)
+	{
+	case Serializer::PT_EXCHANGE:     return bins.Get_exchange();
+	case Serializer::PT_GASPHASE:     return bins.Get_gas_phase();
+	case Serializer::PT_KINETICS:     return bins.Get_kinetics();
+	case Serializer::PT_PPASSEMBLAGE: return bins.Get_pp_assemblage();
+	case Serializer::PT_SSASSEMBLAGE: return bins.Get_ss_assemblage();
+	case Serializer::PT_SURFACES:     return bins.Get_surface();
+	case Serializer::PT_TEMPERATURE:  return bins.Get_temperature();
+	case Serializer::PT_PRESSURE:     return bins.Get_pressure();
+	default:                          return bins.Get_solution();
+	}
+}
 /* ---------------------------------------------------------------------- */
 int Phreeqc::
 delete_entities(void)
@@ -280,6 +323,21 @@ delete_entities(void)
 		return(OK);
 	}
 
+	// deletions are part of the next delta export
+	for (int type = 0; delta_export && type < (int) Rxn_dirty.size(); type++)
+	{
+		StorageBinListItem& item = bin_item(delete_info, type);
+		if (!item.Get_defined()) continue;
+		if (item.Get_numbers().size() == 0)
+		{
+			entity_numbers(*this, type, 0, INT_MAX, Rxn_dirty[type]);
+		}
+		else
+		{
+			Rxn_dirty[type].insert(item.Get_numbers().lower_bound(0), item.Get_numbers().end());
+		}
+	}
+
 	// solutions
 	if (delete_info.Get_solution().Get_defined())
 	{
@@ -623,6 +681,7 @@ run_as_cells(void)
 			if (use.Get_kinetics_in() == TRUE)
 			{
 				Utilities::Rxn_copy(Rxn_kinetics_map, -2, use.Get_n_kinetics_user());
+				mark_dirty(Serializer::PT_KINETICS, use.Get_n_kinetics_user(), use.Get_n_kinetics_user());
 			}
 			saver();
 		}
@@ -839,6 +898,7 @@ run_as_cells(void)
 		if (use.Get_kinetics_in() == TRUE)
 		{
 			Utilities::Rxn_copy(Rxn_kinetics_map, -2, use.Get_n_kinetics_user());
+			mark_dirty(Serializer::PT_KINETICS, use.Get_n_kinetics_user(), use.Get_n_kinetics_user());
 		}
 		saver();
 	}
@@ -1098,6 +1158,183 @@ dump_ostream(std::ostream& os)
 	// Turn off dump until next read
 	dump_info.SetAll(false);
 }
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+Set_delta_export(bool tf)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *   Nothing is recorded while delta export is off, so turning it on
+ *   marks every entity dirty and turning it off drops the marks.
+ */
+	if (tf && !delta_export)
+	{
+		mark_all_dirty();
+	}
+	else if (!tf)
+	{
+		for (size_t i = 0; i < Rxn_dirty.size(); i++)
+		{
+			Rxn_dirty[i].clear();
+		}
+	}
+	delta_export = tf;
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+mark_dirty(int type, int n_user, int n_user_end)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *   Records entities of one type (Serializer::PACK_TYPE) that have been
+ *   saved, copied or loaded, for delta exports. Negative (temporary)
+ *   numbers are not tracked, and a type that is already all dirty needs
+ *   no marks.
+ */
+	if (!delta_export || type < 0 || type >= (int) Rxn_dirty.size() || n_user_end < 0 ||
+		Rxn_dirty_all[type])
+	{
+		return;
+	}
+	for (int i = (n_user < 0) ? 0 : n_user; ; i++)
+	{
+		Rxn_dirty[type].insert(i);
+		if (i >= n_user_end) break;
+	}
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+mark_all_dirty(void)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *   Entities may have changed in ways that are not tracked; the next
+ *   delta export writes every entity. Marks are kept so that deleted
+ *   entities are still reported.
+ */
+	for (size_t i = 0; i < Rxn_dirty_all.size(); i++)
+	{
+		Rxn_dirty_all[i] = true;
+	}
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+delete_cell(int n_user)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *   Removes every entity numbered n_user, as listed by a delta export
+ */
+	Rxn_solution_map.erase(n_user);
+	Rxn_exchange_map.erase(n_user);
+	Rxn_gas_phase_map.erase(n_user);
+	Rxn_kinetics_map.erase(n_user);
+	Rxn_pp_assemblage_map.erase(n_user);
+	Rxn_ss_assemblage_map.erase(n_user);
+	Rxn_surface_map.erase(n_user);
+	Rxn_temperature_map.erase(n_user);
+	Rxn_pressure_map.erase(n_user);
+	if (delta_export && n_user >= 0)
+	{
+		// recorded for all-dirty types too, so the deletion is exported
+		for (int type = 0; type < (int) Rxn_dirty.size(); type++)
+		{
+			Rxn_dirty[type].insert(n_user);
+		}
+	}
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+get_dirty(int type, int start, int end, std::set<int>& numbers)
+/* ---------------------------------------------------------------------- */
+{
+	if (type < 0 || type >= (int) Rxn_dirty.size() || start > end)
+	{
+		return;
+	}
+	numbers.insert(Rxn_dirty[type].lower_bound(start), Rxn_dirty[type].upper_bound(end));
+	if (Rxn_dirty_all[type])
+	{
+		entity_numbers(*this, type, start, end, numbers);
+	}
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+clear_dirty(int type, int start, int end)
+/* ---------------------------------------------------------------------- */
+{
+	if (type < 0 || type >= (int) Rxn_dirty.size() || start > end)
+	{
+		return;
+	}
+	if (Rxn_dirty_all[type])
+	{
+		// entities outside the range stay dirty
+		entity_numbers(*this, type, 0, INT_MAX, Rxn_dirty[type]);
+		Rxn_dirty_all[type] = false;
+	}
+	Rxn_dirty[type].erase(Rxn_dirty[type].lower_bound(start), Rxn_dirty[type].upper_bound(end));
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+dump_select_dirty(void)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *   Restricts the entities selected by DUMP to those changed since the
+ *   last delta export. Mixes and reactions are not tracked and are
+ *   dumped as selected.
+ */
+	for (int type = 0; type < (int) Rxn_dirty.size(); type++)
+	{
+		StorageBinListItem& item = bin_item(dump_info.Get_StorageBinList(), type);
+		if (!item.Get_defined()) continue;
+
+		std::set<int> numbers;
+		get_dirty(type, 0, INT_MAX, numbers);
+		if (item.Get_numbers().size() > 0)
+		{
+			std::set<int> selected;
+			std::set<int>::iterator it = item.Get_numbers().begin();
+			for (; it != item.Get_numbers().end(); it++)
+			{
+				if (numbers.find(*it) != numbers.end())
+				{
+					selected.insert(*it);
+				}
+			}
+			numbers.swap(selected);
+		}
+		if (numbers.size() == 0)
+		{
+			// an empty list would select all; -1 is never dumped
+			numbers.insert(-1);
+		}
+		item.Get_numbers().swap(numbers);
+	}
+}
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+dump_clear_dirty(dumper& info)
+/* ---------------------------------------------------------------------- */
+{
+	for (int type = 0; type < (int) Rxn_dirty.size(); type++)
+	{
+		StorageBinListItem& item = bin_item(info.Get_StorageBinList(), type);
+		if (!item.Get_defined()) continue;
+
+		if (Rxn_dirty_all[type])
+		{
+			entity_numbers(*this, type, 0, INT_MAX, Rxn_dirty[type]);
+			Rxn_dirty_all[type] = false;
+		}
+		std::set<int>::iterator it = item.Get_numbers().begin();
+		for (; it != item.Get_numbers().end(); it++)
+		{
+			Rxn_dirty[type].erase(*it);
+		}
+	}
+}
 #if defined MULTICHART
 /* ---------------------------------------------------------------------- */
 int Phreeqc::
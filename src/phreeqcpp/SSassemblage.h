@@ -25,6 +25,12 @@ public:
 	cxxSSassemblage(const std::map < int, cxxSSassemblage > &entity_map,
 		cxxMix & mx, int n_user, PHRQ_io * io = NULL);
 	~cxxSSassemblage();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxSSassemblage(const cxxSSassemblage &) = default;
+	cxxSSassemblage(cxxSSassemblage &&) = default;
+	cxxSSassemblage & operator = (const cxxSSassemblage &) = default;
+	cxxSSassemblage & operator = (cxxSSassemblage &&) = default;
+#endif
 
 	//void dump_xml(std::ostream& os, unsigned int indent = 0)const;
 
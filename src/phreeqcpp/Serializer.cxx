@@ -113,6 +113,99 @@ bool Serializer::Serialize(Phreeqc &phreeqc_ref, int start, int end, bool includ
 	return true;
 }
 
+template <typename T>
+static bool pack_entity(std::map<int, T> &m, int n_user, int type, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles)
+{
+	T *entity_ptr = Utilities::Rxn_find(m, n_user);
+	if (entity_ptr == NULL)
+		return false;
+	ints.push_back(type);
+	entity_ptr->Serialize(dictionary, ints, doubles);
+	return true;
+}
+template <typename T>
+static bool unpack_entity(std::map<int, T> &m, int n_user, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles, int &ii, int &dd)
+{
+	// the entity must use up the blob; anything left over means it held more than one
+	T entity;
+	entity.Deserialize(dictionary, ints, doubles, ii, dd);
+	if (ii != (int) ints.size() || dd != (int) doubles.size())
+		return false;
+	entity.Set_n_user_both(n_user);
+	m[n_user] = entity;
+	return true;
+}
+bool
+Serializer::SerializeEntity(Phreeqc &phreeqc_ref, PACK_TYPE type, int n_user)
+{
+	switch (type)
+	{
+	case PT_SOLUTION:
+		return pack_entity(phreeqc_ref.Get_Rxn_solution_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_EXCHANGE:
+		return pack_entity(phreeqc_ref.Get_Rxn_exchange_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_GASPHASE:
+		return pack_entity(phreeqc_ref.Get_Rxn_gas_phase_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_KINETICS:
+		return pack_entity(phreeqc_ref.Get_Rxn_kinetics_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_PPASSEMBLAGE:
+		return pack_entity(phreeqc_ref.Get_Rxn_pp_assemblage_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_SSASSEMBLAGE:
+		return pack_entity(phreeqc_ref.Get_Rxn_ss_assemblage_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_SURFACES:
+		return pack_entity(phreeqc_ref.Get_Rxn_surface_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_TEMPERATURE:
+		return pack_entity(phreeqc_ref.Get_Rxn_temperature_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	case PT_PRESSURE:
+		return pack_entity(phreeqc_ref.Get_Rxn_pressure_map(), n_user, type, this->dictionary, this->ints, this->doubles);
+	}
+	return false;
+}
+bool
+Serializer::DeserializeEntity(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles, PACK_TYPE type, int n_user)
+{
+	if (ints.size() < 2 || ints[0] != (int) type)
+		return false;
+	int ii = 1;
+	int dd = 0;
+	bool ok = false;
+	switch (type)
+	{
+	case PT_SOLUTION:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_solution_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_EXCHANGE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_exchange_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_GASPHASE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_gas_phase_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_KINETICS:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_kinetics_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_PPASSEMBLAGE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_pp_assemblage_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_SSASSEMBLAGE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_ss_assemblage_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_SURFACES:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_surface_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_TEMPERATURE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_temperature_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	case PT_PRESSURE:
+		ok = unpack_entity(phreeqc_ref.Get_Rxn_pressure_map(), n_user, dictionary, ints, doubles, ii, dd);
+		break;
+	default:
+		break;
+	}
+	if (!ok)
+		return false;
+	phreeqc_ref.mark_dirty(type, n_user, n_user);
+	return true;
+}
 bool 
 Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles)
 {
@@ -130,6 +223,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				int n_user = soln.Get_n_user();
 				//std::cerr << "unpacked solution " << n_user << std::endl;
 				phreeqc_ref.Get_Rxn_solution_map()[n_user] = soln;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_EXCHANGE:	
@@ -138,6 +232,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_exchange_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_GASPHASE:
@@ -146,6 +241,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_gas_phase_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_KINETICS:	
@@ -154,6 +250,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_kinetics_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_PPASSEMBLAGE:	
@@ -163,6 +260,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				int n_user = entity.Get_n_user();
 				//std::cerr << "unpacked pp assemblage " << n_user << std::endl;
 				phreeqc_ref.Get_Rxn_pp_assemblage_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_SSASSEMBLAGE:	
@@ -171,6 +269,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_ss_assemblage_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_SURFACES:	
@@ -179,6 +278,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_surface_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_TEMPERATURE:
@@ -187,6 +287,7 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_temperature_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		case PT_PRESSURE:	
@@ -195,13 +296,15 @@ Serializer::Deserialize(Phreeqc &phreeqc_ref, Dictionary &dictionary, std::vecto
 				entity.Deserialize(dictionary, ints, doubles, ii, dd);
 				int n_user = entity.Get_n_user();
 				phreeqc_ref.Get_Rxn_pressure_map()[n_user] = entity;
+				phreeqc_ref.mark_dirty(type, n_user, n_user);
 			}
 			break;
 		default:
-#if !defined(R_SO)
-			std::cerr << "Unknown pack type in deserialize " << type << std::endl;
-			exit(4);
-#endif
+			{
+				std::ostringstream oss;
+				oss << "Unknown pack type in deserialize " << type << ".";
+				phreeqc_ref.error_msg(oss.str().c_str(), STOP);
+			}
 			break;
 		}
 	}
@@ -27,6 +27,10 @@ public:
 	};
 	bool Serialize(Phreeqc &phreeqc_ptr, int start, int end, bool include_t, bool include_p, PHRQ_io *io = NULL);
 	bool Deserialize(Phreeqc &phreeqc_ptr, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles);
+	// a single entity of one type, stored back under n_user; DeserializeEntity
+	// fails unless ints and doubles hold exactly one entity of that type
+	bool SerializeEntity(Phreeqc &phreeqc_ptr, PACK_TYPE type, int n_user);
+	bool DeserializeEntity(Phreeqc &phreeqc_ptr, Dictionary &dictionary, std::vector<int> &ints, std::vector<double> &doubles, PACK_TYPE type, int n_user);
 	Dictionary &GetDictionary(void) {return this->dictionary;}
 	std::vector<int> &GetInts(void) {return this->ints;}
 	std::vector<double> &GetDoubles(void) {return this->doubles;}
@@ -106,6 +106,57 @@ cxxSolution::operator =(const cxxSolution &rhs)
 	}
 	return *this;
 }
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+cxxSolution::cxxSolution(cxxSolution &&old_sol)
+:	initial_data(NULL)
+{
+	*this = std::move(old_sol);
+}
+cxxSolution &
+cxxSolution::operator =(cxxSolution &&rhs)
+{
+	// takes the maps of rhs instead of copying them, rhs is left empty
+	if (this != &rhs)
+	{
+		this->io                         = rhs.io;
+		this->n_user                     = rhs.n_user;
+		this->n_user_end                 = rhs.n_user_end;
+		this->description                = std::move(rhs.description);
+		this->new_def                    = rhs.new_def;
+		this->patm                       = rhs.patm;
+		this->potV                       = rhs.potV;
+		this->tc                         = rhs.tc;
+		this->sc                         = rhs.sc;
+		this->species_list               = std::move(rhs.species_list);
+		this->species_masters_list       = std::move(rhs.species_masters_list);
+		this->species_activity_list      = std::move(rhs.species_activity_list);
+		this->phases_list                = std::move(rhs.phases_list);
+		this->ph                         = rhs.ph;
+		this->pe                         = rhs.pe;
+		this->mu                         = rhs.mu;
+		this->ah2o                       = rhs.ah2o;
+		this->total_h                    = rhs.total_h;
+		this->total_o                    = rhs.total_o;
+		this->density                    = rhs.density;
+		this->cb                         = rhs.cb;
+		this->mass_water                 = rhs.mass_water;
+		this->soln_vol                   = rhs.soln_vol;
+		this->total_alkalinity           = rhs.total_alkalinity;
+		this->totals                     = std::move(rhs.totals);
+		this->master_activity            = std::move(rhs.master_activity);
+		this->species_gamma              = std::move(rhs.species_gamma);
+		this->isotopes                   = std::move(rhs.isotopes);
+		this->species_map                = std::move(rhs.species_map);
+		this->log_gamma_map              = std::move(rhs.log_gamma_map);
+		this->log_molalities_map         = std::move(rhs.log_molalities_map);
+		if (this->initial_data)
+			delete initial_data;
+		this->initial_data               = rhs.initial_data;
+		rhs.initial_data                 = NULL;
+	}
+	return *this;
+}
+#endif
 cxxSolution::cxxSolution(std::map < int, cxxSolution > &solutions,
 						 cxxMix & mix, int l_n_user, PHRQ_io * io)
 //
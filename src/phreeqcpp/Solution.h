@@ -21,6 +21,10 @@ class cxxSolution:public cxxNumKeyword
 	cxxSolution(PHRQ_io *io=NULL);
 	cxxSolution(const cxxSolution &old_sol);
 	const cxxSolution & operator = (const cxxSolution &rhs);
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxSolution(cxxSolution &&old_sol);
+	cxxSolution & operator = (cxxSolution &&rhs);
+#endif
 	cxxSolution(std::map < int, cxxSolution > &solution_map,
 				  cxxMix & mx, int n_user, PHRQ_io *io=NULL);
 	virtual ~cxxSolution();
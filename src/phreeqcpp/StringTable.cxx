@@ -0,0 +1,111 @@
+#include <string.h>
+#include "StringTable.h"
+
+#if defined(PHREEQCI_GUI)
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+#endif
+
+StringTable::StringTable(void)
+{
+}
+StringTable::~StringTable(void)
+{
+	this->Clear();
+}
+size_t
+StringTable::Hash(const char *str, size_t len)
+{
+	// FNV-1a
+	size_t h = (size_t) 2166136261u;
+	for (size_t i = 0; i < len; i++)
+	{
+		h ^= (unsigned char) str[i];
+		h *= (size_t) 16777619u;
+	}
+	return h;
+}
+int
+StringTable::Find(const char *str, size_t len, size_t hash) const
+{
+	if (this->slots.size() == 0) return -1;
+	size_t mask = this->slots.size() - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		int id = this->slots[i];
+		if (id < 0) return -1;
+		if (this->hashes[id] == hash &&
+			this->strings[id]->size() == len &&
+			memcmp(this->strings[id]->data(), str, len) == 0)
+		{
+			return id;
+		}
+	}
+}
+int
+StringTable::Find(const char *str) const
+{
+	size_t len = strlen(str);
+	return this->Find(str, len, Hash(str, len));
+}
+int
+StringTable::Find(const std::string &str) const
+{
+	return this->Find(str.data(), str.size(), Hash(str.data(), str.size()));
+}
+int
+StringTable::Intern(const char *str, size_t len)
+{
+	size_t hash = Hash(str, len);
+	int id = this->Find(str, len, hash);
+	if (id >= 0) return id;
+
+	if (2 * (this->strings.size() + 1) > this->slots.size())
+	{
+		this->Rehash(this->slots.size() ? 2 * this->slots.size() : 1024);
+	}
+	id = (int) this->strings.size();
+	this->strings.push_back(new std::string(str, len));
+	this->hashes.push_back(hash);
+	size_t mask = this->slots.size() - 1;
+	size_t i = hash & mask;
+	for (; this->slots[i] >= 0; i = (i + 1) & mask);
+	this->slots[i] = id;
+	return id;
+}
+int
+StringTable::Intern(const char *str)
+{
+	return this->Intern(str, strlen(str));
+}
+int
+StringTable::Intern(const std::string &str)
+{
+	return this->Intern(str.data(), str.size());
+}
+void
+StringTable::Rehash(size_t n_slots)
+{
+	this->slots.assign(n_slots, -1);
+	size_t mask = n_slots - 1;
+	for (size_t id = 0; id < this->strings.size(); id++)
+	{
+		size_t i = this->hashes[id] & mask;
+		for (; this->slots[i] >= 0; i = (i + 1) & mask);
+		this->slots[i] = (int) id;
+	}
+}
+void
+StringTable::Clear(void)
+{
+	for (size_t i = 0; i < this->strings.size(); i++)
+	{
+		delete this->strings[i];
+	}
+	this->strings.clear();
+	this->hashes.clear();
+	this->slots.clear();
+}
@@ -0,0 +1,104 @@
+#if !defined(STRINGTABLE_H_INCLUDED)
+#define STRINGTABLE_H_INCLUDED
+#include <algorithm>
+#include <string>
+#include <vector>
+/*
+ *   Interned strings with stable ids and stable addresses.
+ *   Lookups hash the string once and probe an open-addressing
+ *   table (linear probing, at most half full) of ids.
+ */
+class StringTable
+{
+public:
+	StringTable(void);
+	~StringTable(void);
+
+	int Intern(const char *str);
+	int Intern(const std::string &str);
+	int Find(const char *str) const;
+	int Find(const std::string &str) const;
+	const char *Get(int id) const {return this->strings[id]->c_str();}
+	const std::string &GetString(int id) const {return *this->strings[id];}
+	size_t Size(void) const {return this->strings.size();}
+	void Clear(void);
+
+protected:
+	int Find(const char *str, size_t len, size_t hash) const;
+	int Intern(const char *str, size_t len);
+	void Rehash(size_t n_slots);
+	static size_t Hash(const char *str, size_t len);
+
+	std::vector<std::string *> strings;   // by id
+	std::vector<size_t> hashes;           // by id
+	std::vector<int> slots;               // ids, -1 if empty
+private:
+	StringTable(const StringTable &);
+	StringTable &operator=(const StringTable &);
+};
+/*
+ *   Name table keyed by strings interned in a StringTable;
+ *   stores the value for each id in a vector.
+ */
+template <typename T>
+class StringTableMap
+{
+public:
+	StringTableMap(void) : table(NULL), count(0) {}
+
+	void Set_table(StringTable *t) {this->table = t;}
+	T *find(const std::string &name) const
+	{
+		int id = this->table->Find(name);
+		return (id >= 0 && id < (int) this->items.size()) ? this->items[id] : NULL;
+	}
+	T *find(const char *name) const
+	{
+		int id = this->table->Find(name);
+		return (id >= 0 && id < (int) this->items.size()) ? this->items[id] : NULL;
+	}
+	void store(const std::string &name, T *item)
+	{
+		size_t id = (size_t) this->table->Intern(name);
+		if (id >= this->items.size())
+		{
+			this->items.resize(id + 1, NULL);
+		}
+		if (this->items[id] == NULL) this->count++;
+		this->items[id] = item;
+	}
+	size_t size(void) const {return this->count;}
+	void clear(void)
+	{
+		this->items.clear();
+		this->count = 0;
+	}
+	// values in name order, as a std::map would iterate them
+	void sorted(std::vector<T *> &values) const
+	{
+		std::vector<int> ids;
+		for (size_t i = 0; i < this->items.size(); i++)
+		{
+			if (this->items[i] != NULL) ids.push_back((int) i);
+		}
+		std::sort(ids.begin(), ids.end(), NameLess(this->table));
+		values.clear();
+		for (size_t i = 0; i < ids.size(); i++)
+		{
+			values.push_back(this->items[ids[i]]);
+		}
+	}
+
+protected:
+	struct NameLess
+	{
+		NameLess(const StringTable *t) : table(t) {}
+		bool operator()(int a, int b) const {return this->table->GetString(a) < this->table->GetString(b);}
+		const StringTable *table;
+	};
+	StringTable *table;
+	std::vector<T *> items;  // by string id
+	size_t count;
+};
+
+#endif // !defined(STRINGTABLE_H_INCLUDED)
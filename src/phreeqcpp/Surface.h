@@ -27,6 +27,12 @@ public:
 	cxxSurface(std::map < int, cxxSurface > &entity_map, cxxMix & mx,
 				 int n_user, PHRQ_io *io=NULL);
 	~cxxSurface();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxSurface(const cxxSurface &) = default;
+	cxxSurface(cxxSurface &&) = default;
+	cxxSurface & operator = (const cxxSurface &) = default;
+	cxxSurface & operator = (cxxSurface &&) = default;
+#endif
 
 	//void dump_xml(std::ostream & os, unsigned int indent = 0) const;
 	void dump_raw(std::ostream & s_oss, unsigned int indent, int *n_out=NULL) const;
@@ -412,16 +412,24 @@ dump_msg(const char * str)
 int PHRQ_io::
 getc(void)
 {
-	if (std::istream* is = get_istream())
+	// reads the stream buffer directly; istream::get and peek would
+	// construct a sentry for every character
+	std::istream* is = get_istream();
+	if (is == NULL || !is->good())
 	{
-		int n = is->get();
-		if (n == 13 && is->peek() == 10)
-		{
-			n = is->get();
-		}
-		return n;
+		return EOF;
+	}
+	std::streambuf *sb = is->rdbuf();
+	int n = sb ? sb->sbumpc() : EOF;
+	if (n == 13 && sb->sgetc() == 10)
+	{
+		n = sb->sbumpc();
+	}
+	if (n == EOF)
+	{
+		is->setstate(std::ios_base::eofbit | std::ios_base::failbit);
 	}
-	return EOF;
+	return n;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -678,6 +686,21 @@ pop_istream()
 	}
 }
 /* ---------------------------------------------------------------------- */
+static bool
+token_starts_with(const char *begin, const char *end, const char *prefix)
+/* ---------------------------------------------------------------------- */
+{
+	// case-insensitive prefix test on the token [begin, end)
+	for (; *prefix; ++prefix, ++begin)
+	{
+		if (begin == end || ::tolower((unsigned char) *begin) != *prefix)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+/* ---------------------------------------------------------------------- */
 PHRQ_io::LINE_TYPE PHRQ_io::
 get_line(void)
 /* ---------------------------------------------------------------------- */
@@ -696,7 +719,6 @@ get_line(void)
  *      OK,
  *      OPTION
  */
-	std::string stdtoken;
 	bool continue_loop = true;;
 
 	PHRQ_io::LINE_TYPE return_value;
@@ -729,7 +751,7 @@ get_line(void)
 			*   Get long lines
 			*/
 			bool empty = true;
-			m_line = m_line_save.substr(0, m_line_save.find_first_of('#'));
+			m_line.assign(m_line_save, 0, m_line_save.find('#'));
 			for (unsigned int i = 0; i < m_line.size(); ++i)
 			{
 				if (!::isspace(m_line[i]))
@@ -752,49 +774,44 @@ get_line(void)
 		}
 		if (continue_loop) continue;
 		//
+		// Locate the first token once and inspect it in place
+		//
+		const char *line_end = m_line.c_str() + m_line.size();
+		const char *beg = m_line.c_str();
+		for (; beg < line_end && ::isspace((unsigned char) *beg); ++beg);
+		const char *end = beg;
+		for (; end < line_end && !::isspace((unsigned char) *end); ++end);
+		//
 		// Determine return_value
 		//
 		if (return_value == LT_OK)
 		{
-			if (check_key(m_line.begin(), m_line.end()))
+			if (check_key(beg, end))
 			{
 				return_value = LT_KEYWORD;
 			}
-			else
+			else if (end - beg > 1 && beg[0] == '-' && ::isalpha((unsigned char) beg[1]))
 			{
-				std::string::iterator beg = m_line.begin();
-				std::string::iterator end = m_line.end();
-				std::string token;
-				CParser::copy_token(token, beg, end);
-
-				if (token.size() > 1 && token[0] == '-' &&::isalpha(token[1]))
-				{
-					return_value = LT_OPTION;
-				}
+				return_value = LT_OPTION;
 			}
 		}
 
 		// add new include file to stack
-		std::string::iterator beg = m_line.begin();
-		std::string::iterator end = m_line.end();
-		CParser::copy_token(stdtoken, beg, end);
-		std::transform(stdtoken.begin(), stdtoken.end(), stdtoken.begin(), ::tolower);
-		if ((strstr(stdtoken.c_str(),"include$") == stdtoken.c_str()) ||
-			(strstr(stdtoken.c_str(),"include_file") == stdtoken.c_str()))
+		if (token_starts_with(beg, end, "include$") ||
+			token_starts_with(beg, end, "include_file"))
 		{
 			std::string file_name;
-			file_name.assign(beg, end);
+			file_name.assign(end, line_end);
 			file_name = trim(file_name);
 
 			if (file_name.size() > 0)
 			{
-				std::ifstream *next_stream = new std::ifstream(file_name.c_str(), std::ios_base::in);
-				if (!next_stream->is_open())
+				std::istream *next_stream = this->open_include(file_name.c_str());
+				if (next_stream == NULL)
 				{
 					std::ostringstream errstr;
 					errstr << "\n***********  Could not open include file " << file_name
 						   <<".\n             Please, write the full path to this file. ***********\n\n";
-					delete next_stream;
 #if defined(PHREEQCI_GUI)
 					warning_msg(errstr.str().c_str());
 					continue;
@@ -820,10 +837,28 @@ get_line(void)
 	return LT_EOF;
 }
 
+/* ---------------------------------------------------------------------- */
+std::istream * PHRQ_io::
+open_include(const char *file_name)
+/* ---------------------------------------------------------------------- */
+{
+	// returns a stream owned by the caller, or NULL if the file cannot be opened
+	std::ifstream *next_stream = new std::ifstream(file_name, std::ios_base::in);
+	if (!next_stream->is_open())
+	{
+		delete next_stream;
+		return NULL;
+	}
+	return next_stream;
+}
+
 /**
         Reads input stream until end of line, ";", or eof
         stores characters in line_save
 
+        Characters are read through getc, which subclasses may override
+        to supply their own input.
+
         returns:
                 EOF on empty line on end of file or
                 OK otherwise
@@ -831,11 +866,11 @@ get_line(void)
 PHRQ_io::LINE_TYPE PHRQ_io::
 get_logical_line(void)
 {
-	int j;
-	unsigned int pos;
+	int j = EOF;
+	size_t pos;
 	char c;
 
-	m_line_save.erase(m_line_save.begin(), m_line_save.end());	// m_line_save.clear();
+	m_line_save.clear();
 	while ((j = getc()) != EOF)
 	{
 		c = (char) j;
@@ -861,21 +896,21 @@ get_logical_line(void)
 		}
 		if (c == '\\')
 		{
-			pos = (int) m_line_save.size();
+			pos = m_line_save.size();
 			m_line_save += c;
 			while ((j = getc()) != EOF)
 			{
 				c = (char) j;
 				if (c == '\\')
 				{
-					pos = (int) m_line_save.size();
+					pos = m_line_save.size();
 					m_line_save += c;
 					continue;
 				}
 				if (c == '\n')
 				{
 					// remove '\\'
-					m_line_save = m_line_save.substr(0,pos);
+					m_line_save.resize(pos);
 					break;
 				}
 				m_line_save += c;
@@ -888,9 +923,12 @@ get_logical_line(void)
 			m_line_save += c;
 		}
 	}
-	if (j == std::char_traits < char >::eof() && m_line_save.size() == 0)
+	if (j == std::char_traits < char >::eof())
 	{
-		return (LT_EOF);
+		if (m_line_save.size() == 0)
+		{
+			return (LT_EOF);
+		}
 	}
 	return (LT_OK);
 }
@@ -911,3 +949,22 @@ check_key(std::string::iterator begin, std::string::iterator end)
 	return true;
 }
 
+bool PHRQ_io::
+check_key(const char *begin, const char *end)
+{
+	// [begin, end) is the first token of the line; the lower-case
+	// copy reuses m_key_token so no string is allocated per line
+	m_key_token.resize(end - begin);
+	for (size_t i = 0; begin < end; ++begin, ++i)
+	{
+		m_key_token[i] = (char) ::tolower((unsigned char) *begin);
+	}
+
+	m_next_keyword = Keywords::Keyword_search(m_key_token);
+	if (m_next_keyword == Keywords::KEY_NONE)
+	{
+		return false;
+	}
+	return true;
+}
+
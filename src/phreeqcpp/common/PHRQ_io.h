@@ -58,6 +58,8 @@ public:
 	void output_flush(void);
 	void output_close(void);
 	virtual void output_msg(const char * str);
+	// false only when output_msg would discard; subclasses that own the sink may narrow it
+	virtual bool output_active(void)				{return this->output_on;};
 	void Set_output_ostream(std::ostream * out)		{this->output_ostream = out;};
 	std::ostream *Get_output_ostream(void)			{return this->output_ostream;};
 	void Set_output_on(bool tf)						{this->output_on = tf;};
@@ -68,6 +70,7 @@ public:
 	void log_flush(void);
 	void log_close(void);
 	virtual void log_msg(const char * str);
+	virtual bool log_active(void)					{return this->log_on;};
 	void Set_log_ostream(std::ostream * out)		{this->log_ostream = out;}
 	std::ostream *Get_log_ostream(void)				{return this->log_ostream;}
 	void Set_log_on(bool tf)						{this->log_on = tf;}
@@ -129,10 +132,12 @@ public:
 	bool Get_screen_on(void)const					{return this->screen_on;};
 
 	// input methods
-	virtual int getc(void);
+	virtual int getc(void);                         // get_logical_line reads every character through getc
 	virtual LINE_TYPE get_line(void);
 	virtual LINE_TYPE get_logical_line(void);
+	virtual std::istream * open_include(const char *file_name);
 	bool check_key(std::string::iterator begin, std::string::iterator end);
+	bool check_key(const char *begin, const char *end);
 	std::string & Get_m_line()						{return m_line;}
 	std::string & Get_m_line_save()					{return m_line_save;}
 	std::string & Get_accumulated()					{return accumulated;}
@@ -154,6 +159,7 @@ public:
 		ECHO_OUTPUT
 	};
 	virtual void echo_msg(const char * str);
+	bool echo_active(void)							{return this->echo_on && (this->echo_destination == ECHO_LOG ? this->log_active() : this->output_active());};
 	void Set_echo_on(bool tf)						{this->echo_on = tf;};
 	bool Get_echo_on(void)const						{return this->echo_on;};
 	void Set_echo_destination(ECHO_OPTION eo)		{this->echo_destination = eo;};
@@ -192,6 +198,7 @@ protected:
 	std::string m_line;
 	std::string m_line_save;
 	std::string accumulated;
+	std::string m_key_token;
 
 #if defined(_MSC_VER)
 /* reset warning C4251 */
@@ -20,6 +20,12 @@ class cxxKinetics:public cxxNumKeyword
 	cxxKinetics(const std::map < int, cxxKinetics > &entity_map, cxxMix & mx,
 				int n_user, PHRQ_io *io=NULL);
 	~cxxKinetics();
+#if (__GNUC__ && (__cplusplus >= 201103L)) || (_MSC_VER >= 1900)
+	cxxKinetics(const cxxKinetics &) = default;
+	cxxKinetics(cxxKinetics &&) = default;
+	cxxKinetics & operator = (const cxxKinetics &) = default;
+	cxxKinetics & operator = (cxxKinetics &&) = default;
+#endif
 
 	//void dump_xml(std::ostream& os, unsigned int indent = 0)const;
 
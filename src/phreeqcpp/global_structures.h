@@ -186,7 +186,7 @@ typedef struct PHRQMemHeader
 	struct PHRQMemHeader *pPrev;	/* memory allocated just prior to this one */
 	size_t size;				/* memory request + sizeof(PHRQMemHeader) */
 #if !defined(NDEBUG)
-	char *szFileName;			/* file name */
+	const char *szFileName;		/* file name (__FILE__, not copied) */
 	int nLine;					/* line number */
 	int dummy;					/* alignment */
 #endif
@@ -462,6 +462,52 @@ public:
 	std::vector<const char*> surface_comp;
 	std::vector<const char*> surface_charge;
 };
+/*----------------------------------------------------------------------
+ *   Log K values of s_x and phases saved for a temperature and pressure
+ *---------------------------------------------------------------------- */
+class logk_cache_entry
+{
+public:
+	~logk_cache_entry() {};
+	logk_cache_entry()
+	{
+		tc = 0;
+		pa = 0;
+		model_id = -1;
+		mu_terms = true;
+	}
+	LDBLE tc;
+	LDBLE pa;
+	int model_id;
+	bool mu_terms;
+	std::vector<LDBLE> s_lk;
+	std::vector<LDBLE> phase_lk;
+	std::vector<int> phase_in;
+};
+/*----------------------------------------------------------------------
+ *   Rewritten mass-action equations saved for a set of master species
+ *---------------------------------------------------------------------- */
+class model_cache_entry
+{
+public:
+	~model_cache_entry() {};
+	model_cache_entry()
+	{
+		logk_model = -1;
+	}
+	/* key: master species in the model and reactions used for rewriting */
+	std::vector<int> master_in;
+	std::vector<CReaction> master_rxn;     /* rxn_secondary if in == REWRITE */
+	std::vector<const char*> master_pe;    /* pe_rxn if in == REWRITE */
+	std::map<std::string, CReaction> pe;
+	std::string default_pe;
+	/* species and phases in the model, in order, with rxn_x */
+	std::vector<int> s_in;
+	std::vector<CReaction> s_rxn;
+	std::vector<int> phase_in;
+	std::vector<CReaction> phase_rxn;
+	int logk_model;
+};
 class name_coef
 {
 public:
@@ -1541,10 +1587,12 @@ public:
 	~J_ij_save() {};
 	J_ij_save()
 	{
+		name = NULL;
 		// species change in cells i and j
 		flux_t = 0;
 		flux_c = 0;
 	}
+	const char* name;
 	double flux_t, flux_c;
 };
 class M_S
@@ -1629,6 +1677,32 @@ public:
 	LDBLE etheta;
 	LDBLE ethetap;
 };
+class pitz_term
+{
+public:
+	~pitz_term() {};
+	pitz_term()
+	{
+		for (size_t i = 0; i < 3; i++) ispec[i] = -1;
+		type = TYPE_Other;
+		param = -1;
+		alpha = -1;
+		theta = -1;
+		p = 0;
+		zfac = 0;
+		os_coef = 0;
+		for (size_t i = 0; i < 3; i++) ln_coef[i] = 0;
+	}
+	int ispec[3];
+	pitz_param_type type;
+	int param;		/* index in pitz_params */
+	int alpha;		/* index in pz_alphas, B1 and B2 */
+	int theta;		/* index in theta_params, ETHETA */
+	LDBLE p;
+	LDBLE zfac;		/* 2 sqrt(|z0 z1|), C0 */
+	LDBLE os_coef;
+	LDBLE ln_coef[3];
+};
 class const_iso
 {
 public:
@@ -73,7 +73,7 @@ check_line_impl(const char *string, int allow_empty, int allow_eof,
 	do
 	{
 		i = get_line();
-		if ((print == TRUE && i != EOF) || i == KEYWORD)
+		if (((print == TRUE && i != EOF) || i == KEYWORD) && echo_active())
 		{
 			echo_msg(sformatf( "\t%s\n", line_save));
 		}
@@ -110,8 +110,10 @@ get_line(void)
 
 	// copy parser line to line and line_save
 	// make sure there is enough space
-	size_t l1 = strlen(phrq_io->Get_m_line().c_str()) + 1;
-	size_t l2 = strlen(phrq_io->Get_m_line_save().c_str()) + 1;
+	const std::string &io_line = phrq_io->Get_m_line();
+	const std::string &io_line_save = phrq_io->Get_m_line_save();
+	size_t l1 = io_line.size() + 1;
+	size_t l2 = io_line_save.size() + 1;
 	size_t l = (l1 > l2) ? l1 : l2;
 	if (l >= (size_t) max_line)
 	{
@@ -124,7 +126,7 @@ get_line(void)
 		if (line == NULL)
 			malloc_error();
 	}
-	strcpy(line, phrq_io->Get_m_line().c_str());
-	strcpy(line_save, phrq_io->Get_m_line_save().c_str());
+	memcpy(line, io_line.c_str(), l1);
+	memcpy(line_save, io_line_save.c_str(), l2);
 	return j;
 }
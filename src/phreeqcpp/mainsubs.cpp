@@ -12,6 +12,7 @@
 #include "SSassemblage.h"
 #include "cxxKinetics.h"
 #include "Solution.h"
+#include "Serializer.h"
 
 #if defined(WINDOWS) || defined(_WINDOWS)
 #include <windows.h>
@@ -886,6 +887,7 @@ reactions(void)
 	if (use.Get_kinetics_in() == TRUE)
 	{
 		Utilities::Rxn_copy(Rxn_kinetics_map, -2, use.Get_n_kinetics_user());
+		mark_dirty(Serializer::PT_KINETICS, use.Get_n_kinetics_user(), use.Get_n_kinetics_user());
 	}
 	saver();
 
@@ -942,12 +944,14 @@ saver(void)
 		{
 			Utilities::Rxn_copy(Rxn_solution_map, n, i);
 		}
+		mark_dirty(Serializer::PT_SOLUTION, n, save.n_solution_user_end);
 	}
 	if (save.pp_assemblage == TRUE)
 	{
 		n = save.n_pp_assemblage_user;
 		xpp_assemblage_save(n);
 		Utilities::Rxn_copies(Rxn_pp_assemblage_map, save.n_pp_assemblage_user, save.n_pp_assemblage_user_end);
+		mark_dirty(Serializer::PT_PPASSEMBLAGE, n, save.n_pp_assemblage_user_end);
 	}
 	if (save.exchange == TRUE)
 	{
@@ -957,12 +961,14 @@ saver(void)
 		{
 			Utilities::Rxn_copy(Rxn_exchange_map, n, i);
 		}
+		mark_dirty(Serializer::PT_EXCHANGE, n, save.n_exchange_user_end);
 	}
 	if (save.surface == TRUE)
 	{
 		n = save.n_surface_user;
 		xsurface_save(n);
 		Utilities::Rxn_copies(Rxn_surface_map, n, save.n_surface_user_end);
+		mark_dirty(Serializer::PT_SURFACES, n, save.n_surface_user_end);
 	}
 	if (save.gas_phase == TRUE)
 	{
@@ -973,12 +979,14 @@ saver(void)
 		{
 			Utilities::Rxn_copy(Rxn_gas_phase_map, n, i);
 		}
+		mark_dirty(Serializer::PT_GASPHASE, n, save.n_gas_phase_user_end);
 	}
 	if (save.ss_assemblage == TRUE)
 	{
 		n = save.n_ss_assemblage_user;
 		xss_assemblage_save(n);
 		Utilities::Rxn_copies(Rxn_ss_assemblage_map, save.n_ss_assemblage_user, save.n_ss_assemblage_user_end);
+		mark_dirty(Serializer::PT_SSASSEMBLAGE, n, save.n_ss_assemblage_user_end);
 	}
 	if (save.kinetics == TRUE && use.Get_kinetics_in() == TRUE
 	    /*&& use.Get_kinetics_ptr() != NULL */)
@@ -998,6 +1006,7 @@ saver(void)
 			{
 				Utilities::Rxn_copy(Rxn_kinetics_map, n, i);
 			}
+			mark_dirty(Serializer::PT_KINETICS, save.n_kinetics_user, save.n_kinetics_user_end);
 		}
 	}
 	return (OK);
@@ -1083,7 +1092,8 @@ xexchange_save(int n_user)
 /*
  *   Finish up
  */
-	Rxn_exchange_map[n_user] = temp_exchange;
+	Utilities::Rxn_store(Rxn_exchange_map, n_user, temp_exchange);
+	mark_dirty(Serializer::PT_EXCHANGE, n_user, n_user);
 
 	use.Set_exchange_ptr(NULL);
 	return (OK);
@@ -1139,7 +1149,8 @@ xgas_save(int n_user)
 			gc_ptr->Set_f(phase_ptr->p_soln_x);
 		}
 	}
-	Rxn_gas_phase_map[n_user] = temp_gas_phase;
+	Utilities::Rxn_store(Rxn_gas_phase_map, n_user, temp_gas_phase);
+	mark_dirty(Serializer::PT_GASPHASE, n_user, n_user);
 
 	use.Set_gas_phase_ptr(NULL);
 	return (OK);
@@ -1183,7 +1194,8 @@ xss_assemblage_save(int n_user)
 /*
  *   Finish up
  */
-	Rxn_ss_assemblage_map[n_user] = temp_ss_assemblage;
+	Utilities::Rxn_store(Rxn_ss_assemblage_map, n_user, temp_ss_assemblage);
+	mark_dirty(Serializer::PT_SSASSEMBLAGE, n_user, n_user);
 
 	use.Set_ss_assemblage_ptr(NULL);
 	return (OK);
@@ -1225,7 +1237,8 @@ xpp_assemblage_save(int n_user)
  *   Finish up
  */
 
-	Rxn_pp_assemblage_map[n_user] = temp_pp_assemblage;
+	Utilities::Rxn_store(Rxn_pp_assemblage_map, n_user, temp_pp_assemblage);
+	mark_dirty(Serializer::PT_PPASSEMBLAGE, n_user, n_user);
 	use.Set_pp_assemblage_ptr(NULL);
 	return (OK);
 }
@@ -1500,7 +1513,8 @@ xsolution_save(int n_user)
 /*
  *   Save solution
  */
-	Rxn_solution_map[n_user] = temp_solution;
+	Utilities::Rxn_store(Rxn_solution_map, n_user, temp_solution);
+	mark_dirty(Serializer::PT_SOLUTION, n_user, n_user);
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -1666,7 +1680,8 @@ xsurface_save(int n_user)
 /*
  *   Finish up
  */
-	Rxn_surface_map[n_user] = temp_surface;
+	Utilities::Rxn_store(Rxn_surface_map, n_user, temp_surface);
+	mark_dirty(Serializer::PT_SURFACES, n_user, n_user);
 	use.Set_surface_ptr(NULL);
 	return (OK);
 }
@@ -1808,6 +1823,10 @@ copy_use(int i)
 	{
 		save.ss_assemblage = FALSE;
 	}
+	for (int type = 0; type < (int) Rxn_dirty.size(); type++)
+	{
+		mark_dirty(type, i, i);
+	}
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -1863,7 +1882,7 @@ step_save_exch(int n_user)
 		}
 	}
 
-	Rxn_exchange_map[n_user] = temp_exchange;
+	Utilities::Rxn_store(Rxn_exchange_map, n_user, temp_exchange);
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -95,6 +95,7 @@ model(void)
 #endif
 	iterations = 0;
 	count_basis_change = count_infeasible = 0;
+	sparse_solve_count = sparse_fallback_count = 0;
 	stop_program = FALSE;
 	remove_unstable_phases = FALSE;
 	for (;;)
@@ -257,6 +258,11 @@ model(void)
 	log_msg(sformatf( "Number of basis changes: %d\n\n",
 			   count_basis_change));
 	log_msg(sformatf( "Number of iterations: %d\n\n", iterations));
+	if (sparse_newton == TRUE)
+	{
+		log_msg(sformatf( "Sparse LU solves: %d, cl1 fallbacks: %d\n\n",
+				   sparse_solve_count, sparse_fallback_count));
+	}
 	debug_model = debug_model_save;
 	set_forward_output_to_log(FALSE);
 	unset_inert_moles();
@@ -1772,11 +1778,26 @@ ineq(int in_kode)
 		   (size_t) max_column_count * sizeof(LDBLE));
 #endif
 /*
- *   Call CL1
+ *   Only equalities: try sparse LU, otherwise call CL1
  */
-	cl1(k, l, m, n, l_nklmd, l_n2d, &ineq_array[0],
-		&l_kode, ineq_tol, &l_iter, &delta1[0], &res[0],
-		&l_error, &cu[0], &iu[0], &is[0], FALSE);
+	if (sparse_newton == TRUE && k == 0 && m == 0 &&
+		sparse_ineq(l, n, l_n2d) == OK)
+	{
+		l_kode = 0;
+		l_iter = 0;
+		l_error = 0.0;
+		sparse_solve_count++;
+	}
+	else
+	{
+		if (sparse_newton == TRUE && k == 0 && m == 0)
+		{
+			sparse_fallback_count++;
+		}
+		cl1(k, l, m, n, l_nklmd, l_n2d, &ineq_array[0],
+			&l_kode, ineq_tol, &l_iter, &delta1[0], &res[0],
+			&l_error, &cu[0], &iu[0], &is[0], FALSE);
+	}
 /*   Set return_kode */
 	if (l_kode == 1)
 	{
@@ -1920,6 +1941,165 @@ ineq(int in_kode)
 	return (return_code);
 }
 
+/* ------------------------------------------------------------------------------- */
+int Phreeqc::
+sparse_ineq(int rows, int cols, int stride)
+/* ------------------------------------------------------------------------------- */
+{
+/*
+ *	Solves the equality rows of ineq_array by sparse LU when no
+ *	optimization or inequality rows are present.
+ *	Copies the jacobian into CSR form, drops empty columns, and
+ *	eliminates with partial pivoting on sorted sparse rows.
+ *	Result is written to delta1, row residuals to res, as cl1 does.
+ *	Returns ERROR if the system is not square or is singular;
+ *	caller then falls back to cl1.
+ *	Work vectors are members and keep their space between iterations.
+ */
+	int i, j;
+	size_t kk;
+/*
+ *   Compressed sparse row copy of the equality rows
+ */
+	csr_row_start.resize((size_t)rows + 1);
+	csr_col.clear();
+	csr_val.clear();
+	sparse_col_map.assign((size_t)cols, -1);
+	for (i = 0; i < rows; i++)
+	{
+		csr_row_start[i] = (int)csr_col.size();
+		for (j = 0; j < cols; j++)
+		{
+			LDBLE v = ineq_array[(size_t)i * stride + (size_t)j];
+			if (v != 0.0)
+			{
+				csr_col.push_back(j);
+				csr_val.push_back(v);
+				sparse_col_map[j] = 0;
+			}
+		}
+	}
+	csr_row_start[rows] = (int)csr_col.size();
+/*
+ *   Columns without entries are not solved for, delta is zero
+ */
+	int count_active = 0;
+	for (j = 0; j < cols; j++)
+	{
+		if (sparse_col_map[j] == 0)
+		{
+			sparse_col_map[j] = count_active++;
+		}
+	}
+	if (count_active != rows || rows == 0)
+		return (ERROR);
+/*
+ *   Gaussian elimination on sorted sparse rows
+ */
+	if (sparse_lu.size() < (size_t)rows)
+		sparse_lu.resize((size_t)rows);
+	sparse_b.resize((size_t)rows);
+	sparse_order.resize((size_t)rows);
+	for (i = 0; i < rows; i++)
+	{
+		std::vector< std::pair<int, LDBLE> > &r = sparse_lu[i];
+		r.clear();
+		for (int p = csr_row_start[i]; p < csr_row_start[(size_t)i + 1]; p++)
+		{
+			r.push_back(std::pair<int, LDBLE>(sparse_col_map[csr_col[p]], csr_val[p]));
+		}
+		sparse_b[i] = ineq_array[(size_t)i * stride + (size_t)cols];
+		sparse_order[i] = i;
+	}
+	for (j = 0; j < rows; j++)
+	{
+		int pivot = -1;
+		LDBLE max = 0.0;
+		for (i = j; i < rows; i++)
+		{
+			const std::vector< std::pair<int, LDBLE> > &r = sparse_lu[sparse_order[i]];
+			if (r.size() > 0 && r[0].first == j && fabs(r[0].second) > max)
+			{
+				max = fabs(r[0].second);
+				pivot = i;
+			}
+		}
+		if (pivot < 0 || !(max > 0.0))
+			return (ERROR);
+		std::swap(sparse_order[j], sparse_order[pivot]);
+		const std::vector< std::pair<int, LDBLE> > &p = sparse_lu[sparse_order[j]];
+		for (i = j + 1; i < rows; i++)
+		{
+			std::vector< std::pair<int, LDBLE> > &r = sparse_lu[sparse_order[i]];
+			if (r.size() == 0 || r[0].first != j)
+				continue;
+			LDBLE f = r[0].second / p[0].second;
+			sparse_merged.clear();
+			size_t ir = 1, ip = 1;
+			while (ir < r.size() || ip < p.size())
+			{
+				if (ip >= p.size() || (ir < r.size() && r[ir].first < p[ip].first))
+				{
+					sparse_merged.push_back(r[ir++]);
+				}
+				else if (ir >= r.size() || p[ip].first < r[ir].first)
+				{
+					sparse_merged.push_back(std::pair<int, LDBLE>(p[ip].first, -f * p[ip].second));
+					ip++;
+				}
+				else
+				{
+					LDBLE v = r[ir].second - f * p[ip].second;
+					if (v != 0.0)
+						sparse_merged.push_back(std::pair<int, LDBLE>(r[ir].first, v));
+					ir++;
+					ip++;
+				}
+			}
+			r.swap(sparse_merged);
+			sparse_b[sparse_order[i]] -= f * sparse_b[sparse_order[j]];
+		}
+	}
+/*
+ *   Back substitution
+ */
+	sparse_sol.resize((size_t)rows);
+	for (j = rows - 1; j >= 0; j--)
+	{
+		const std::vector< std::pair<int, LDBLE> > &p = sparse_lu[sparse_order[j]];
+		LDBLE sum = sparse_b[sparse_order[j]];
+		for (kk = 1; kk < p.size(); kk++)
+		{
+			sum -= p[kk].second * sparse_sol[p[kk].first];
+		}
+		sparse_sol[j] = sum / p[0].second;
+		if (!PHR_ISFINITE(sparse_sol[j]))
+			return (ERROR);
+	}
+	for (j = 0; j < cols; j++)
+	{
+		delta1[j] = (sparse_col_map[j] < 0) ? 0.0 : sparse_sol[sparse_col_map[j]];
+	}
+/*
+ *   Residuals of the equality rows, b - A * delta1
+ */
+	for (i = 0; i < rows; i++)
+	{
+		LDBLE sum = ineq_array[(size_t)i * stride + (size_t)cols];
+		for (int p = csr_row_start[i]; p < csr_row_start[(size_t)i + 1]; p++)
+		{
+			sum -= csr_val[p] * delta1[csr_col[p]];
+		}
+		res[i] = sum;
+	}
+	if (debug_model == TRUE)
+	{
+		output_msg(sformatf( "Sparse LU, %d rows, %d nonzeros\n", rows,
+				   csr_row_start[rows]));
+	}
+	return (OK);
+}
+
 /* ---------------------------------------------------------------------- */
 int Phreeqc::
 jacobian_sums(void)
@@ -19,6 +19,21 @@ static char THIS_FILE[] = __FILE__;
 
 #if defined(USE_PHRQ_ALLOC)
 /* ---------------------------------------------------------------------- */
+void Phreeqc::
+PHRQ_count_alloc(size_t size)
+/* ---------------------------------------------------------------------- */
+{
+	/*
+	 *   Allocation statistics: bytes in use (without headers), high-water
+	 *   mark and cumulative bytes requested
+	 */
+	phrq_alloc_bytes += size;
+	if (phrq_alloc_bytes > phrq_alloc_peak)
+		phrq_alloc_peak = phrq_alloc_bytes;
+	phrq_alloc_total += (double) size;
+	phrq_alloc_count++;
+}
+/* ---------------------------------------------------------------------- */
 #if !defined(NDEBUG)
 void * Phreeqc::
 PHRQ_malloc(size_t size, const char *szFileName, int nLine)
@@ -48,11 +63,10 @@ PHRQ_malloc(size_t size)
 
 	p->size = sizeof(PHRQMemHeader) + size;
 #if !defined(NDEBUG)
-	p->szFileName = (char *) malloc(strlen(szFileName) + 1);
-	if (p->szFileName)
-		strcpy(p->szFileName, szFileName);
+	p->szFileName = szFileName;
 	p->nLine = nLine;
 #endif
+	PHRQ_count_alloc(size);
 
 	s_pTail = p;
 	p++;
@@ -90,10 +104,7 @@ PHRQ_free(void *ptr)
 		p->pPrev->pNext = p->pNext;
 	}
 
-#if !defined(NDEBUG)
-	free(p->szFileName);
-#endif
-
+	phrq_alloc_bytes -= p->size - sizeof(PHRQMemHeader);
 	free(p);
 }
 
@@ -121,7 +132,6 @@ PHRQ_free_all(void)
 		ostrm << s_pTail->pNext->szFileName << "(" << s_pTail->pNext->nLine;
 		ostrm << ") " << (void *) (s_pTail->pNext + 1) << ": freed in PHRQ_free_all\n";
 		output_msg(ostrm.str().c_str());
-		free(s_pTail->pNext->szFileName);
 #endif
 		free(s_pTail->pNext);
 	}
@@ -131,10 +141,10 @@ PHRQ_free_all(void)
 	ostrm <<  s_pTail->szFileName << "(" << s_pTail->nLine;
 	ostrm << ") " << (void *) (s_pTail + 1) << ": freed in PHRQ_free_all\n";
 	output_msg(ostrm.str().c_str());
-	free(s_pTail->szFileName);
 #endif
 	free(s_pTail);
 	s_pTail = NULL;
+	phrq_alloc_bytes = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -166,11 +176,10 @@ PHRQ_calloc(size_t num, size_t size
 	p->size = sizeof(PHRQMemHeader) + size * num;
 
 #if !defined(NDEBUG)
-	p->szFileName = (char *) malloc(strlen(szFileName) + 1);
-	if (p->szFileName)
-		strcpy(p->szFileName, szFileName);
+	p->szFileName = szFileName;
 	p->nLine = nLine;
 #endif
+	PHRQ_count_alloc(size * num);
 
 	s_pTail = p;
 	p++;
@@ -210,6 +219,13 @@ PHRQ_realloc(void *ptr, size_t size
 	if (p != NULL)
 	{
 		p->size = new_size;
+		// a resize is not a new allocation; only growth adds to the total
+		size_t old_bytes = old_size - sizeof(PHRQMemHeader);
+		phrq_alloc_bytes = phrq_alloc_bytes - old_bytes + size;
+		if (phrq_alloc_bytes > phrq_alloc_peak)
+			phrq_alloc_peak = phrq_alloc_bytes;
+		if (size > old_bytes)
+			phrq_alloc_total += (double) (size - old_bytes);
 #if !defined(NDEBUG)
 		if (new_size > old_size)
 		{
@@ -236,10 +252,7 @@ PHRQ_realloc(void *ptr, size_t size
 	}
 
 #if !defined(NDEBUG)
-	free(p->szFileName);
-	p->szFileName = (char *) malloc(strlen(szFileName) + 1);
-	if (p->szFileName)
-		strcpy(p->szFileName, szFileName);
+	p->szFileName = szFileName;
 	p->nLine = nLine;
 #endif
 
@@ -772,6 +772,10 @@ C
 	{
 		calc_pitz_param(mcc0, TK, TR);
 	}
+	for (size_t j = 0; j < pz_terms.size(); j++)
+	{
+		pz_terms[j].p = pitz_params[pz_terms[j].param]->p;
+	}
 #endif
 	calc_dielectrics(TK - 273.15, patm_x);
 	OTEMP = TK;
@@ -1190,7 +1194,7 @@ pitzer(void)
 /* ---------------------------------------------------------------------- */
 {
 	int i, i0, i1, i2;
-	LDBLE param, l_alpha, z0, z1;
+	LDBLE param, z0, z1;
 	LDBLE etheta, ethetap;
 	/*
 	   LDBLE CONV, XI, XX, OSUM, BIGZ, DI, F, XXX, GAMCLM, 
@@ -1303,20 +1307,26 @@ pitzer(void)
 			theta_params[i]->ethetap = ethetap;
 		}
 	}
+	/*
+	 *  G, GP and exp(-alpha sqrt(I)) depend only on alpha
+	 */
+	for (size_t k = 0; k < pz_alphas.size(); k++)
+	{
+		pz_g[k] = G(pz_alphas[k] * DI);
+		pz_gp[k] = GP(pz_alphas[k] * DI);
+		pz_exp[k] = exp(-pz_alphas[k] * DI);
+	}
 	/*
 	 *  Sums for F, LGAMMA, and OSMOT
 	 */
- 	for (size_t j = 0; j < param_list.size(); j++)
- 	{
- 		int i = param_list[j];
-		i0 = pitz_params[i]->ispec[0];
-		i1 = pitz_params[i]->ispec[1];
-		z0 = spec[i0]->z;
-		z1 = spec[i1]->z;
-		param = pitz_params[i]->p;
-		l_alpha = pitz_params[i]->alpha;
+	for (size_t j = 0; j < pz_terms.size(); j++)
+	{
+		const class pitz_term &t = pz_terms[j];
+		i0 = t.ispec[0];
+		i1 = t.ispec[1];
+		param = t.p;
 		F_var = 0;
-		switch (pitz_params[i]->type)
+		switch (t.type)
 		{
 		case TYPE_B0:
 			LGAMMA[i0] += M[i1] * 2.0 * param;
@@ -1324,45 +1334,31 @@ pitzer(void)
 			OSMOT += M[i0] * M[i1] * param;
 			break;
 		case TYPE_B1:
-			if (param != 0.0)
-			{
-				F_var = M[i0] * M[i1] * param * GP(l_alpha * DI) / I;
-				LGAMMA[i0] += M[i1] * 2.0 * param * G(l_alpha * DI);
-				LGAMMA[i1] += M[i0] * 2.0 * param * G(l_alpha * DI);
-				OSMOT += M[i0] * M[i1] * param * exp(-l_alpha * DI);
-			}
-			break;
 		case TYPE_B2:
 			if (param != 0.0)
 			{
-				F_var = M[i0] * M[i1] * param * GP(l_alpha * DI) / I;
-				LGAMMA[i0] += M[i1] * 2.0 * param * G(l_alpha * DI);
-				LGAMMA[i1] += M[i0] * 2.0 * param * G(l_alpha * DI);
-				OSMOT += M[i0] * M[i1] * param * exp(-l_alpha * DI);
+				F_var = M[i0] * M[i1] * param * pz_gp[t.alpha] / I;
+				LGAMMA[i0] += M[i1] * 2.0 * param * pz_g[t.alpha];
+				LGAMMA[i1] += M[i0] * 2.0 * param * pz_g[t.alpha];
+				OSMOT += M[i0] * M[i1] * param * pz_exp[t.alpha];
 			}
 			break;
 		case TYPE_C0:
-			CSUM +=
-				M[i0] * M[i1] * pitz_params[i]->p / (2.0 *
-													 sqrt(fabs(z0 * z1)));
-			LGAMMA[i0] += M[i1] * BIGZ * param / (2.0 * sqrt(fabs(z0 * z1)));
-			LGAMMA[i1] += M[i0] * BIGZ * param / (2.0 * sqrt(fabs(z0 * z1)));
-			OSMOT +=
-				M[i0] * M[i1] * BIGZ * param / (2.0 * sqrt(fabs(z0 * z1)));
+			CSUM += M[i0] * M[i1] * param / t.zfac;
+			LGAMMA[i0] += M[i1] * BIGZ * param / t.zfac;
+			LGAMMA[i1] += M[i0] * BIGZ * param / t.zfac;
+			OSMOT += M[i0] * M[i1] * BIGZ * param / t.zfac;
 			break;
 		case TYPE_THETA:
-			LGAMMA[i0] += 2.0 * M[i1] * (param /*+ ETHETA(z0, z1, I) */ );
-			LGAMMA[i1] += 2.0 * M[i0] * (param /*+ ETHETA(z0, z1, I) */ );
+			LGAMMA[i0] += 2.0 * M[i1] * param;
+			LGAMMA[i1] += 2.0 * M[i0] * param;
 			OSMOT += M[i0] * M[i1] * param;
 			break;
 		case TYPE_ETHETA:
-			/*
-			   ETHETAS(z0, z1, I, &etheta, &ethetap);
-			 */
-			if (use_etheta == TRUE)
+			if (use_etheta == TRUE && t.theta >= 0)
 			{
-				etheta = pitz_params[i]->thetas->etheta;
-				ethetap = pitz_params[i]->thetas->ethetap;
+				etheta = theta_params[t.theta]->etheta;
+				ethetap = theta_params[t.theta]->ethetap;
 				F_var = M[i0] * M[i1] * ethetap;
 				LGAMMA[i0] += 2.0 * M[i1] * etheta;
 				LGAMMA[i1] += 2.0 * M[i0] * etheta;
@@ -1370,7 +1366,9 @@ pitzer(void)
 			}
 			break;
 		case TYPE_PSI:
-			i2 = pitz_params[i]->ispec[2];
+		case TYPE_ZETA:
+		case TYPE_ETA:
+			i2 = t.ispec[2];
 			if (IPRSNT[i2] == FALSE)
 				continue;
 			LGAMMA[i0] += M[i1] * M[i2] * param;
@@ -1379,37 +1377,18 @@ pitzer(void)
 			OSMOT += M[i0] * M[i1] * M[i2] * param;
 			break;
 		case TYPE_LAMDA:
-			LGAMMA[i0] += M[i1] * param * pitz_params[i]->ln_coef[0];
-			LGAMMA[i1] += M[i0] * param * pitz_params[i]->ln_coef[1];
-			OSMOT += M[i0] * M[i1] * param * pitz_params[i]->os_coef;
-			break;
-		case TYPE_ZETA:
-			i2 = pitz_params[i]->ispec[2];
-			if (IPRSNT[i2] == FALSE)
-				continue;
-			LGAMMA[i0] += M[i1] * M[i2] * param;
-			LGAMMA[i1] += M[i0] * M[i2] * param;
-			LGAMMA[i2] += M[i0] * M[i1] * param;
-			OSMOT += M[i0] * M[i1] * M[i2] * param;
+			LGAMMA[i0] += M[i1] * param * t.ln_coef[0];
+			LGAMMA[i1] += M[i0] * param * t.ln_coef[1];
+			OSMOT += M[i0] * M[i1] * param * t.os_coef;
 			break;
 		case TYPE_MU:
-			i2 = pitz_params[i]->ispec[2];
+			i2 = t.ispec[2];
 			if (IPRSNT[i2] == FALSE)
 				continue;
-
-			LGAMMA[i0] += M[i1] * M[i2] * param * pitz_params[i]->ln_coef[0];
-			LGAMMA[i1] += M[i0] * M[i2] * param * pitz_params[i]->ln_coef[1];
-			LGAMMA[i2] += M[i0] * M[i1] * param * pitz_params[i]->ln_coef[2];
-			OSMOT += M[i0] * M[i1] * M[i2] * param * pitz_params[i]->os_coef;
-			break;
-		case TYPE_ETA:
-			i2 = pitz_params[i]->ispec[2];
-			if (IPRSNT[i2] == FALSE)
-				continue;
-			LGAMMA[i0] += M[i1] * M[i2] * param;
-			LGAMMA[i1] += M[i0] * M[i2] * param;
-			LGAMMA[i2] += M[i0] * M[i1] * param;
-			OSMOT += M[i0] * M[i1] * M[i2] * param;
+			LGAMMA[i0] += M[i1] * M[i2] * param * t.ln_coef[0];
+			LGAMMA[i1] += M[i0] * M[i2] * param * t.ln_coef[1];
+			LGAMMA[i2] += M[i0] * M[i1] * param * t.ln_coef[2];
+			OSMOT += M[i0] * M[i1] * M[i2] * param * t.os_coef;
 			break;
 		case TYPE_ALPHAS:
 			break;
@@ -2704,4 +2683,54 @@ pitzer_make_lists(void)
 		}
 		param_list.push_back(i);
 	}
+	/*
+	 *  Dense copy of the active parameters for pitzer()
+	 */
+	pz_terms.clear();
+	pz_alphas.clear();
+	for (size_t j = 0; j < param_list.size(); j++)
+	{
+		class pitz_param *pz_ptr = pitz_params[param_list[j]];
+		class pitz_term t;
+		for (int k = 0; k < 3; k++)
+		{
+			t.ispec[k] = pz_ptr->ispec[k];
+			t.ln_coef[k] = pz_ptr->ln_coef[k];
+		}
+		t.type = pz_ptr->type;
+		t.param = param_list[j];
+		t.p = pz_ptr->p;
+		t.os_coef = pz_ptr->os_coef;
+		if (t.type == TYPE_B1 || t.type == TYPE_B2)
+		{
+			size_t k;
+			for (k = 0; k < pz_alphas.size(); k++)
+			{
+				if (pz_alphas[k] == pz_ptr->alpha)
+					break;
+			}
+			if (k == pz_alphas.size())
+				pz_alphas.push_back(pz_ptr->alpha);
+			t.alpha = (int)k;
+		}
+		else if (t.type == TYPE_C0)
+		{
+			t.zfac = 2.0 * sqrt(fabs(spec[t.ispec[0]]->z * spec[t.ispec[1]]->z));
+		}
+		else if (t.type == TYPE_ETHETA)
+		{
+			for (size_t k = 0; k < theta_params.size(); k++)
+			{
+				if (theta_params[k] == pz_ptr->thetas)
+				{
+					t.theta = (int)k;
+					break;
+				}
+			}
+		}
+		pz_terms.push_back(t);
+	}
+	pz_g.resize(pz_alphas.size());
+	pz_gp.resize(pz_alphas.size());
+	pz_exp.resize(pz_alphas.size());
 }
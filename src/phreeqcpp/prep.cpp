@@ -1116,17 +1116,32 @@ build_model(void)
 	s_x.clear();
 	compute_gfw("H2O", &gfw_water);
 	gfw_water *= 0.001;
+/*
+ *   Same master species as a cached model, reuse species, phases,
+ *   and their rewritten mass-action equations
+ */
+	model_cache_entry key;
+	model_cache_entry *cache_ptr = model_cache_find(key);
+	size_t n_cache = 0;
 	for (i = 0; i < (int)s.size(); i++)
 	{
 		if (s[i]->type > H2O && s[i]->type != EX && s[i]->type != SURF)
 			continue;
 		s[i]->in = FALSE;
-		count_trxn = 0;
-		trxn_add(s[i]->rxn_s, 1.0, false);	/* rxn_s is set in tidy_model */
+		if (cache_ptr != NULL)
+		{
+			if (n_cache < cache_ptr->s_in.size() && cache_ptr->s_in[n_cache] == i)
+				s[i]->in = TRUE;
+		}
+		else
+		{
+			count_trxn = 0;
+			trxn_add(s[i]->rxn_s, 1.0, false);	/* rxn_s is set in tidy_model */
 /*
  *   Check if species is in model
  */
-		s[i]->in = inout();
+			s[i]->in = inout();
+		}
 		if (s[i]->in == TRUE)
 		{
 			/* for isotopes, activity of water is for 1H and 16O */
@@ -1142,16 +1157,30 @@ build_model(void)
 			s_x[count_s_x] = s[i];
 			
 /*
- *   Write mass action equation for current model
+ *   Write mass action equation for current model,
+ *   surface species depend on the surface unknowns
  */
-			//if (write_mass_action_eqn_x(STOP) == ERROR) continue;
-			write_mass_action_eqn_x(STOP);
-			if (s[i]->type == SURF)
+			if (cache_ptr != NULL && s[i]->type != SURF)
 			{
-				add_potential_factor();
-				add_cd_music_factors(i);
+				s[i]->rxn_x = cache_ptr->s_rxn[n_cache++];
+			}
+			else
+			{
+				if (cache_ptr != NULL)
+				{
+					n_cache++;
+					count_trxn = 0;
+					trxn_add(s[i]->rxn_s, 1.0, false);
+				}
+				//if (write_mass_action_eqn_x(STOP) == ERROR) continue;
+				write_mass_action_eqn_x(STOP);
+				if (s[i]->type == SURF)
+				{
+					add_potential_factor();
+					add_cd_music_factors(i);
+				}
+				trxn_copy(s[i]->rxn_x);
 			}
-			trxn_copy(s[i]->rxn_x);
 			for (j = 0; j < 3; j++)
 			{
 				s[i]->dz[j] = s[i]->rxn_x.dz[j];
@@ -1289,8 +1318,20 @@ build_model(void)
 	/*
  *   Rewrite phases to current master species
  */
+	n_cache = 0;
 	for (i = 0; i < (int)phases.size(); i++)
 	{
+		if (cache_ptr != NULL)
+		{
+			phases[i]->in = FALSE;
+			if (n_cache < cache_ptr->phase_in.size() && cache_ptr->phase_in[n_cache] == i)
+			{
+				phases[i]->in = TRUE;
+				phases[i]->rxn_x = cache_ptr->phase_rxn[n_cache++];
+				write_phase_sys_total(i);
+			}
+			continue;
+		}
 		count_trxn = 0;
 		trxn_add_phase(phases[i]->rxn_s, 1.0, false);
 		trxn_reverse_k();
@@ -1329,6 +1370,17 @@ build_model(void)
  *   Save model description
  */
 	save_model();
+	if (cache_ptr != NULL)
+	{
+		/* same equations as the cached model, log k's still apply;
+		   surface species are rewritten for the surface in use */
+		if (use.Get_surface_ptr() == NULL && cache_ptr->logk_model > 0)
+			logk_cache_model = cache_ptr->logk_model;
+	}
+	else if (input_error == 0)
+	{
+		model_cache_save(key);
+	}
 
 	if (input_error > 0)
 	{
@@ -5425,33 +5477,47 @@ k_temp(LDBLE tc, LDBLE pa) /* pa - pressure in atm */
 	calc_dielectrics(tc, pa);
 
 	calc_vm(tc, pa);
-
-	mu_terms_in_logk = false;
-	for (i = 0; i < (int)this->s_x.size(); i++)
+/*
+ *  Below 1 atm log k does not depend on delta_v, reuse cached values
+ */
+	bool cache_logk = (logk_cache_max > 0 && pa * PASCAL_PER_ATM <= REF_PRES_PASCAL);
+	if (cache_logk && logk_cache_find(tc, pa))
 	{
-		//if (s_x[i]->rxn_x.logk[vm_tc])
-		/* calculate delta_v for the reaction... */
-			s_x[i]->rxn_x.logk[delta_v] = calc_delta_v(*&s_x[i]->rxn_x, false);
-		if (tc == current_tc && s_x[i]->rxn_x.logk[delta_v] == 0)
-			continue;
-		mu_terms_in_logk = true;
-		s_x[i]->lk = k_calc(s_x[i]->rxn_x.logk, tempk, pa * PASCAL_PER_ATM);
+		logk_cache_hits++;
 	}
+	else
+	{
+		if (cache_logk)
+			logk_cache_misses++;
+		mu_terms_in_logk = false;
+		for (i = 0; i < (int)this->s_x.size(); i++)
+		{
+			//if (s_x[i]->rxn_x.logk[vm_tc])
+			/* calculate delta_v for the reaction... */
+				s_x[i]->rxn_x.logk[delta_v] = calc_delta_v(*&s_x[i]->rxn_x, false);
+			if (tc == current_tc && s_x[i]->rxn_x.logk[delta_v] == 0)
+				continue;
+			mu_terms_in_logk = true;
+			s_x[i]->lk = k_calc(s_x[i]->rxn_x.logk, tempk, pa * PASCAL_PER_ATM);
+		}
 /*
  *    Calculate log k for all pure phases
  */
-	for (i = 0; i < (int)phases.size(); i++)
-	{
-		if (phases[i]->in == TRUE)  
+		for (i = 0; i < (int)phases.size(); i++)
 		{
+			if (phases[i]->in == TRUE)  
+			{
 
-			phases[i]->rxn_x.logk[delta_v] = calc_delta_v(*&phases[i]->rxn_x, true) -
-				phases[i]->logk[vm0];
-			if (phases[i]->rxn_x.logk[delta_v])
-				mu_terms_in_logk = true;
-			phases[i]->lk = k_calc(phases[i]->rxn_x.logk, tempk, pa * PASCAL_PER_ATM);
+				phases[i]->rxn_x.logk[delta_v] = calc_delta_v(*&phases[i]->rxn_x, true) -
+					phases[i]->logk[vm0];
+				if (phases[i]->rxn_x.logk[delta_v])
+					mu_terms_in_logk = true;
+				phases[i]->lk = k_calc(phases[i]->rxn_x.logk, tempk, pa * PASCAL_PER_ATM);
 
+			}
 		}
+		if (cache_logk)
+			logk_cache_save(tc, pa);
 	}
 /*
  *    Calculate miscibility gaps for solid solutions
@@ -5475,6 +5541,213 @@ k_temp(LDBLE tc, LDBLE pa) /* pa - pressure in atm */
 	return (OK);
 }
 
+/* ---------------------------------------------------------------------- */
+bool Phreeqc::
+logk_cache_find(LDBLE tc, LDBLE pa)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *  Copies cached log k's for the current model at tc, pa into s_x and
+ *  phases. Returns false if no entry matches or a phase that is now in
+ *  the model was not in the model when the entry was saved.
+ */
+	std::list<logk_cache_entry>::iterator it = logk_cache.begin();
+	for (; it != logk_cache.end(); it++)
+	{
+		if (it->model_id == logk_cache_model && it->tc == tc && it->pa == pa &&
+			it->s_lk.size() == s_x.size() && it->phase_lk.size() == phases.size())
+			break;
+	}
+	if (it == logk_cache.end())
+		return false;
+	for (size_t i = 0; i < phases.size(); i++)
+	{
+		if (phases[i]->in == TRUE && it->phase_in[i] == FALSE)
+			return false;
+	}
+	for (size_t i = 0; i < s_x.size(); i++)
+	{
+		s_x[i]->lk = it->s_lk[i];
+	}
+	for (size_t i = 0; i < phases.size(); i++)
+	{
+		if (phases[i]->in == TRUE)
+			phases[i]->lk = it->phase_lk[i];
+	}
+	mu_terms_in_logk = it->mu_terms;
+	/* move to front, least recently used is at the back */
+	logk_cache.splice(logk_cache.begin(), logk_cache, it);
+	return true;
+}
+
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+logk_cache_save(LDBLE tc, LDBLE pa)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *  Saves log k's of s_x and phases for the current model at tc, pa.
+ *  Drops the least recently used entry when the cache is full.
+ */
+	std::list<logk_cache_entry>::iterator it = logk_cache.begin();
+	for (; it != logk_cache.end(); it++)
+	{
+		if (it->model_id == logk_cache_model && it->tc == tc && it->pa == pa)
+			break;
+	}
+	if (it != logk_cache.end())
+	{
+		logk_cache.splice(logk_cache.begin(), logk_cache, it);
+	}
+	else
+	{
+		if (logk_cache.size() >= logk_cache_max)
+		{
+			logk_cache.pop_back();
+		}
+		logk_cache.push_front(logk_cache_entry());
+	}
+	logk_cache_entry &entry = logk_cache.front();
+	entry.tc = tc;
+	entry.pa = pa;
+	entry.model_id = logk_cache_model;
+	entry.mu_terms = mu_terms_in_logk;
+	entry.s_lk.resize(s_x.size());
+	for (size_t i = 0; i < s_x.size(); i++)
+	{
+		entry.s_lk[i] = s_x[i]->lk;
+	}
+	entry.phase_lk.resize(phases.size());
+	entry.phase_in.resize(phases.size());
+	for (size_t i = 0; i < phases.size(); i++)
+	{
+		entry.phase_in[i] = phases[i]->in;
+		entry.phase_lk[i] = phases[i]->lk;
+	}
+}
+
+/* ---------------------------------------------------------------------- */
+static bool
+same_reaction(const CReaction &rxn1, const CReaction &rxn2)
+/* ---------------------------------------------------------------------- */
+{
+	if (rxn1.token.size() != rxn2.token.size())
+		return false;
+	if (memcmp(rxn1.logk, rxn2.logk, sizeof(rxn1.logk)) != 0)
+		return false;
+	for (size_t i = 0; i < rxn1.token.size(); i++)
+	{
+		if (rxn1.token[i].s != rxn2.token[i].s ||
+			rxn1.token[i].coef != rxn2.token[i].coef)
+			return false;
+	}
+	return true;
+}
+
+/* ---------------------------------------------------------------------- */
+model_cache_entry * Phreeqc::
+model_cache_find(model_cache_entry &key)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *  Fills key with the master species in the model, the rewritten
+ *  secondary master species, and the pe reactions. Returns the cached
+ *  model with the same key, or NULL; debug output needs the full rewrite.
+ */
+	if (model_cache_max == 0 || debug_mass_action == TRUE || debug_prep == TRUE)
+		return NULL;
+	key.master_in.resize(master.size());
+	for (size_t i = 0; i < master.size(); i++)
+	{
+		key.master_in[i] = master[i]->in;
+		if (master[i]->in == REWRITE)
+		{
+			key.master_pe.push_back(master[i]->pe_rxn);
+			key.master_rxn.push_back(master[i]->rxn_secondary);
+		}
+	}
+	key.pe = pe_x;
+	key.default_pe = default_pe_x;
+
+	std::list<model_cache_entry>::iterator it = model_cache.begin();
+	for (; it != model_cache.end(); it++)
+	{
+		if (it->master_in != key.master_in || it->default_pe != key.default_pe ||
+			it->pe.size() != key.pe.size())
+			continue;
+		size_t n;
+		for (n = 0; n < key.master_rxn.size(); n++)
+		{
+			const char *pe1 = it->master_pe[n];
+			const char *pe2 = key.master_pe[n];
+			if (pe1 != pe2 && (pe1 == NULL || pe2 == NULL || strcmp(pe1, pe2) != 0))
+				break;
+			if (!same_reaction(it->master_rxn[n], key.master_rxn[n]))
+				break;
+		}
+		if (n < key.master_rxn.size())
+			continue;
+		std::map<std::string, CReaction>::const_iterator jit = it->pe.begin();
+		std::map<std::string, CReaction>::const_iterator kit = key.pe.begin();
+		for (; jit != it->pe.end(); jit++, kit++)
+		{
+			if (jit->first != kit->first || !same_reaction(jit->second, kit->second))
+				break;
+		}
+		if (jit != it->pe.end())
+			continue;
+		model_cache_hits++;
+		/* move to front, least recently used is at the back */
+		model_cache.splice(model_cache.begin(), model_cache, it);
+		return &model_cache.front();
+	}
+	model_cache_misses++;
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+void Phreeqc::
+model_cache_save(model_cache_entry &key)
+/* ---------------------------------------------------------------------- */
+{
+/*
+ *  Saves the species and phases of the model just built with their
+ *  rewritten mass-action equations under key from model_cache_find.
+ *  Drops the least recently used entry when the cache is full.
+ */
+	if (model_cache_max == 0 || key.master_in.size() == 0)
+		return;
+	if (model_cache.size() >= model_cache_max)
+	{
+		model_cache.pop_back();
+	}
+	model_cache.push_front(model_cache_entry());
+	model_cache_entry &entry = model_cache.front();
+	entry.master_in.swap(key.master_in);
+	entry.master_rxn.swap(key.master_rxn);
+	entry.master_pe.swap(key.master_pe);
+	entry.pe.swap(key.pe);
+	entry.default_pe.swap(key.default_pe);
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		if (s[i]->in == TRUE &&
+			(s[i]->type <= H2O || s[i]->type == EX || s[i]->type == SURF))
+		{
+			entry.s_in.push_back((int) i);
+			entry.s_rxn.push_back(s[i]->rxn_x);
+		}
+	}
+	for (size_t i = 0; i < phases.size(); i++)
+	{
+		if (phases[i]->in == TRUE)
+		{
+			entry.phase_in.push_back((int) i);
+			entry.phase_rxn.push_back(phases[i]->rxn_x);
+		}
+	}
+	entry.logk_model = logk_cache_model;
+}
+
 /* ---------------------------------------------------------------------- */
 LDBLE Phreeqc::
 k_calc(LDBLE * l_logk, LDBLE tempk, LDBLE presPa)
@@ -5635,6 +5908,8 @@ save_model(void)
 	current_pa = NAN;
 	current_mu = NAN;
 	mu_terms_in_logk = true;
+	/* mass-action equations were rewritten, cached log k's do not apply */
+	logk_cache_model = ++logk_cache_model_count;
 
 	last_model.numerical_fixed_volume = numerical_fixed_volume;
 
@@ -34,25 +34,25 @@ array_print(LDBLE * array_l, int row_count, int column_count,
 	for (i = 0; i < row_count; i++)
 	{
 		k = 0;
-		output_msg(sformatf("%d\n", i));
+		output_msgf("%d\n", i);
 		for (j = 0; j < column_count; j++)
 		{
 			if (k > 7)
 			{
-				output_msg(sformatf("\n"));
+				output_msgf("\n");
 				k = 0;
 			}
-			output_msg(sformatf("%11.2e",
-					   (double) array_l[i * l_max_column_count + j]));
+			output_msgf("%11.2e",
+					   (double) array_l[i * l_max_column_count + j]);
 			k++;
 		}
 		if (k != 0)
 		{
-			output_msg(sformatf("\n"));
+			output_msgf("\n");
 		}
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 
@@ -109,26 +109,38 @@ print_all(void)
 	}
 /*
  *   Print results
- */
-	s_h2o->lm = s_h2o->la;
-	print_using();
-	print_mix();
-	print_reaction();
-	print_kinetics();
-	print_user_print();
-	print_gas_phase();
-	print_pp_assemblage();
-	print_ss_assemblage();
-	print_surface();
-	print_exchange();
-	print_initial_solution_isotopes();
-	print_isotope_ratios();
-	print_isotope_alphas();
-	print_totals();
-	print_eh();
-	print_species();
-	print_alkalinity();
-	print_saturation_indices();
+ *   The routines also update model state, so they always run, but
+ *   nothing is formatted when no stream receives the output
+ */
+	discard_output = !output_active();
+	try
+	{
+		s_h2o->lm = s_h2o->la;
+		print_using();
+		print_mix();
+		print_reaction();
+		print_kinetics();
+		print_user_print();
+		print_gas_phase();
+		print_pp_assemblage();
+		print_ss_assemblage();
+		print_surface();
+		print_exchange();
+		print_initial_solution_isotopes();
+		print_isotope_ratios();
+		print_isotope_alphas();
+		print_totals();
+		print_eh();
+		print_species();
+		print_alkalinity();
+		print_saturation_indices();
+	}
+	catch (...)
+	{
+		discard_output = false;
+		throw;
+	}
+	discard_output = false;
 	if (!pr.saturation_indices)
 		set_pr_in_false();
 	return (OK);
@@ -268,9 +280,9 @@ print_diffuse_layer(cxxSurfaceCharge *charge_ptr)
 	{
 		d = 0.0;
 	}
-	output_msg(sformatf(
+	output_msgf(
 			   "\tWater in diffuse layer: %8.3e kg, %4.1f%% of total DDL-water.\n",
-			   (double) charge_ptr->Get_mass_water(), (double) d));
+			   (double) charge_ptr->Get_mass_water(), (double) d);
 	if (use.Get_surface_ptr()->Get_debye_lengths() > 0 && d > 0)
 	{
 		sum_surfs = 0.0;
@@ -284,17 +296,17 @@ print_diffuse_layer(cxxSurfaceCharge *charge_ptr)
 				charge_ptr_search->Get_grams();
 		}
 		r = 0.002 * mass_water_bulk_x / sum_surfs;
-		output_msg(sformatf(
+		output_msgf(
 				   "\tRadius of total pore:   %8.3e m; of free pore: %8.3e m.\n",
-				   (double) r, (double) (r - use.Get_surface_ptr()->Get_thickness())));
+				   (double) r, (double) (r - use.Get_surface_ptr()->Get_thickness()));
 	}
 
 	if (debug_diffuse_layer == TRUE)
 	{
-		output_msg(sformatf(
-				   "\n\t\tDistribution of species in diffuse layer\n\n"));
-		output_msg(sformatf(
-				   "\n\tSpecies     \t    Moles   \tMoles excess\t      g\n"));
+		output_msgf(
+				   "\n\t\tDistribution of species in diffuse layer\n\n");
+		output_msgf(
+				   "\n\tSpecies     \t    Moles   \tMoles excess\t      g\n");
 	}
 	if ((mass_water_surface = charge_ptr->Get_mass_water()))
 	{
@@ -312,9 +324,9 @@ print_diffuse_layer(cxxSurfaceCharge *charge_ptr)
 			moles_surface = mass_water_surface * molality + moles_excess;
 			if (debug_diffuse_layer == TRUE)
 			{
-				output_msg(sformatf("\t%-12s\t%12.3e\t%12.3e\t%12.3e\n",
+				output_msgf("\t%-12s\t%12.3e\t%12.3e\t%12.3e\n",
 					s_x[j]->name, moles_surface, moles_excess,
-					charge_ptr->Get_g_map()[s_x[j]->z].Get_g()));
+					charge_ptr->Get_g_map()[s_x[j]->z].Get_g());
 			}
 			/*
 			 *   Accumulate elements in diffuse layer
@@ -332,24 +344,24 @@ print_diffuse_layer(cxxSurfaceCharge *charge_ptr)
 		 */
 		if (use.Get_surface_ptr()->Get_dl_type() != cxxSurface::DONNAN_DL)
 		{
-			output_msg(sformatf(
-				"\n\tTotal moles in diffuse layer (excluding water)\n\n"));
+			output_msgf(
+				"\n\tTotal moles in diffuse layer (excluding water)\n\n");
 		}
 		else
 		{
 			LDBLE exp_g = charge_ptr->Get_g_map()[1].Get_g() * mass_water_aq_x / mass_water_surface + 1;
 			LDBLE psi_DL = -log(exp_g) * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ;
-			output_msg(sformatf(
-				"\n\tTotal moles in diffuse layer (excluding water), Donnan calculation."));
-			output_msg(sformatf(
+			output_msgf(
+				"\n\tTotal moles in diffuse layer (excluding water), Donnan calculation.");
+			output_msgf(
 				"\n\tDonnan Layer potential, psi_DL = %10.3e V.\n\tBoltzmann factor, exp(-psi_DL * F / RT) = %9.3e (= c_DL / c_free if z is +1).\n\n",
-				psi_DL, exp_g));
+				psi_DL, exp_g);
 		}
-		output_msg(sformatf("\tElement       \t     Moles\n"));
+		output_msgf("\tElement       \t     Moles\n");
 		for (j = 0; j < count_elts; j++)
 		{
-			output_msg(sformatf("\t%-14s\t%12.4e\n",
-				elt_list[j].elt->name, (double)elt_list[j].coef));
+			output_msgf("\t%-14s\t%12.4e\n",
+				elt_list[j].elt->name, (double)elt_list[j].coef);
 		}
 	}
 	return (OK);
@@ -417,8 +429,8 @@ print_eh(void)
 			if (first == TRUE)
 			{
 				print_centered("Redox couples");
-				output_msg(sformatf("\t%-15s%12s%12s\n\n",
-						   "Redox couple", "pe", "Eh (volts)"));
+				output_msgf("\t%-15s%12s%12s\n\n",
+						   "Redox couple", "pe", "Eh (volts)");
 				first = FALSE;
 			}
 /*
@@ -427,12 +439,12 @@ print_eh(void)
 			strcpy(token, master[i]->elt->name);
 			strcat(token, "/");
 			strcat(token, master[k]->elt->name);
-			output_msg(sformatf("\t%-15s%12.4f%12.4f\n", token,
-					   (double) pe, (double) eh));
+			output_msgf("\t%-15s%12.4f%12.4f\n", token,
+					   (double) pe, (double) eh);
 		}
 	}
 	if (first == FALSE)
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -488,8 +500,8 @@ print_exchange(void)
 		if (name1 != name)
 		{
 			name = name1;
-			output_msg(sformatf("%-14s%12.3e mol", name,
-					   (double) master_ptr->unknown->moles));
+			output_msgf("%-14s%12.3e mol", name,
+					   (double) master_ptr->unknown->moles);
 			cxxExchange *exchange_ptr = (cxxExchange *) (use.Get_exchange_ptr());
 			if (master_ptr->unknown->exch_comp == NULL)
 			{		
@@ -502,25 +514,25 @@ print_exchange(void)
 			assert(exchange_comp_ptr);
 			if (exchange_comp_ptr->Get_phase_name().size() > 0)
 			{
-				output_msg(sformatf("\t[%g (mol %s)/(mol %s)]",
+				output_msgf("\t[%g (mol %s)/(mol %s)]",
 					(double) exchange_comp_ptr->Get_phase_proportion(),
 					exchange_comp_ptr->Get_formula().c_str(),
-					exchange_comp_ptr->Get_phase_name().c_str()));
+					exchange_comp_ptr->Get_phase_name().c_str());
 			}
 			else if (exchange_comp_ptr->Get_rate_name().size() > 0)
 			{
-				output_msg(sformatf(
+				output_msgf(
 						   "\t[%g (mol %s)/(mol kinetic reactant %s)]",
 						   (double) exchange_comp_ptr->Get_phase_proportion(),
 						   exchange_comp_ptr->Get_formula().c_str(),
-						   exchange_comp_ptr->Get_rate_name().c_str()));
+						   exchange_comp_ptr->Get_rate_name().c_str());
 			}
-			output_msg(sformatf("\n\n"));
+			output_msgf("\n\n");
 			/* Heading for species */
-			output_msg(sformatf("\t%-15s%12s%12s%12s%10s\n", " ", " ",
-					   "Equiv-  ", "Equivalent", "Log "));
-			output_msg(sformatf("\t%-15s%12s%12s%12s%10s\n\n",
-					   "Species", "Moles  ", "alents  ", "Fraction", "Gamma"));
+			output_msgf("\t%-15s%12s%12s%12s%10s\n", " ", " ",
+					   "Equiv-  ", "Equivalent", "Log ");
+			output_msgf("\t%-15s%12s%12s%12s%10s\n\n",
+					   "Species", "Moles  ", "alents  ", "Fraction", "Gamma");
 		}
 /*
  *   Print species data
@@ -550,17 +562,17 @@ print_exchange(void)
 			{
 				dum2 = 1;
 			}
-			output_msg(sformatf("\t%-15s%12.3e%12.3e%12.3e%10.3f\n",
+			output_msgf("\t%-15s%12.3e%12.3e%12.3e%10.3f\n",
 					   species_list[i].s->name,
 					   (double) species_list[i].s->moles,
 					   (double) (species_list[i].s->moles * dum2 *
 								 species_list[i].s->equiv),
 					   (double) (species_list[i].s->moles *
 								 dum /* / dum2 */ ),
-					   (double) (species_list[i].s->lg - log10(dum))));
+					   (double) (species_list[i].s->lg - log10(dum)));
 		}
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -605,27 +617,27 @@ print_gas_phase(void)
  *   Print heading
  */
 	print_centered("Gas phase");
-	output_msg(sformatf("Total pressure: %5.2f      atmospheres",
-			   (double) gas_phase_ptr->Get_total_p()));
+	output_msgf("Total pressure: %5.2f      atmospheres",
+			   (double) gas_phase_ptr->Get_total_p());
 	if (gas_phase_ptr->Get_total_p() >= MAX_P_NONLLNL && llnl_temp.size() == 0)
 		output_msg(" WARNING: Program limit.\n");
 	else if (PR)
 		output_msg("          (Peng-Robinson calculation)\n");
 	else
 		output_msg(" \n");
-	output_msg(sformatf("    Gas volume: %10.2e liters\n",
-			   (double) gas_phase_ptr->Get_volume()));
+	output_msgf("    Gas volume: %10.2e liters\n",
+			   (double) gas_phase_ptr->Get_volume());
 	if(gas_phase_ptr->Get_total_moles() > 0)
 	{
 		if (PR)
 		{
-			output_msg(sformatf("  Molar volume: %10.2e liters/mole",
-				    (double) (gas_phase_ptr->Get_v_m())));
+			output_msgf("  Molar volume: %10.2e liters/mole",
+				    (double) (gas_phase_ptr->Get_v_m()));
 		}
 		else
 		{
-			output_msg(sformatf("  Molar volume: %10.2e liters/mole",
-				(double) (gas_phase_ptr->Get_volume() / gas_phase_ptr->Get_total_moles())));
+			output_msgf("  Molar volume: %10.2e liters/mole",
+				(double) (gas_phase_ptr->Get_volume() / gas_phase_ptr->Get_total_moles()));
 		}
 	}
 	if (/*!numerical_fixed_volume && */((PR && gas_phase_ptr->Get_v_m() <= 0.016)))
@@ -633,18 +645,18 @@ print_gas_phase(void)
 	else
 		output_msg("\n");
 	if (PR)
-	output_msg(sformatf( "   P * Vm / RT: %8.5f  (Compressibility Factor Z) \n",
-			     (double) (gas_phase_ptr->Get_total_p() * gas_phase_ptr->Get_v_m() / (R_LITER_ATM * tk_x))));
+	output_msgf( "   P * Vm / RT: %8.5f  (Compressibility Factor Z) \n",
+			     (double) (gas_phase_ptr->Get_total_p() * gas_phase_ptr->Get_v_m() / (R_LITER_ATM * tk_x)));
 
 
-	output_msg(sformatf("\n%68s\n%78s\n", "Moles in gas",
-			   "----------------------------------"));
+	output_msgf("\n%68s\n%78s\n", "Moles in gas",
+			   "----------------------------------");
 	if (PR)
-		output_msg(sformatf( "%-11s%12s%12s%7s%12s%12s%12s\n\n", "Component",
-			   "log P", "P", "phi", "Initial", "Final", "Delta"));
+		output_msgf( "%-11s%12s%12s%7s%12s%12s%12s\n\n", "Component",
+			   "log P", "P", "phi", "Initial", "Final", "Delta");
 	else
-		output_msg(sformatf("%-18s%12s%12s%12s%12s%12s\n\n", "Component",
-			   "log P", "P", "Initial", "Final", "Delta"));
+		output_msgf("%-18s%12s%12s%12s%12s%12s\n\n", "Component",
+			   "log P", "P", "Initial", "Final", "Delta");
 
 	for (size_t j = 0; j < gas_phase_ptr->Get_gas_comps().size(); j++)
 	{
@@ -692,23 +704,23 @@ print_gas_phase(void)
 			delta_moles = 0.0;
 		if (PR)
 		{
-			output_msg(sformatf("%-11s%12.2f%12.3e%7.3f%12.3e%12.3e%12.3e\n",
+			output_msgf("%-11s%12.2f%12.3e%7.3f%12.3e%12.3e%12.3e\n",
 				   phase_ptr->name,
 				   (double) lp,
 				   (double) phase_ptr->p_soln_x,
 				   (double) phase_ptr->pr_phi,
 				   (double) initial_moles,
 				   (double) moles,
-				   (double) delta_moles));
+				   (double) delta_moles);
 		}
 		else
-			output_msg(sformatf("%-18s%12.2f%12.3e%12.3e%12.3e%12.3e\n",
+			output_msgf("%-18s%12.2f%12.3e%12.3e%12.3e%12.3e\n",
 				   phase_ptr->name,
 				   (double) lp,
 				   (double) phase_ptr->p_soln_x,
 				   (double) initial_moles,
 				   (double) moles,
-				   (double) delta_moles));
+				   (double) delta_moles);
 		//if (!strcmp(phase_ptr->name, "H2O(g)") && phase_ptr->p_soln_x == 90)
 		//	output_msg("       WARNING: The pressure of H2O(g) is fixed to the program limit.\n");
 
@@ -736,10 +748,10 @@ print_ss_assemblage(void)
 	 *   Print heading
 	 */
 	print_centered("Solid solutions");
-	output_msg(sformatf("\n"));
-	output_msg(sformatf("%-15s  %22s  %11s  %11s  %11s\n\n",
+	output_msgf("\n");
+	output_msgf("%-15s  %22s  %11s  %11s  %11s\n\n",
 			   "Solid solution", "Component", "Moles", "Delta moles",
-			   "Mole fract"));
+			   "Mole fract");
 	/*
 	 *   Print solid solutions
 	 */
@@ -750,9 +762,9 @@ print_ss_assemblage(void)
 		if (ss_ptr->Get_ss_in())
 		{
 			/* solid solution name, moles */
-			output_msg(sformatf("%-15s  %22s  %11.2e\n",
+			output_msgf("%-15s  %22s  %11.2e\n",
 					   ss_ptr->Get_name().c_str(), "  ",
-					   (double)  ss_ptr->Get_total_moles()));
+					   (double)  ss_ptr->Get_total_moles());
 			/* component name, moles, delta moles, mole fraction */
 
 			for (i = 0; i < (int) ss_ptr->Get_ss_comps().size(); i++)
@@ -771,12 +783,12 @@ print_ss_assemblage(void)
 						comp_ptr->Get_moles() -
 						comp_ptr->Get_init_moles();
 				}
-				output_msg(sformatf(
+				output_msgf(
 						   "%15s  %22s  %11.2e  %11.2e  %11.2e\n", " ",
 						   comp_ptr->Get_name().c_str(),
 						   (double) comp_ptr->Get_moles(), (double) delta_moles,
 						   (double) (comp_ptr->Get_moles() /
-									 ss_ptr->Get_total_moles())));
+									 ss_ptr->Get_total_moles()));
 			}
 			if (ss_ptr->Get_miscibility())
 			{
@@ -793,25 +805,25 @@ print_ss_assemblage(void)
 					xb2moles = (xb1 - 1) / xb1 * nb + nc;
 					xb2moles = xb2moles / ((xb1 - 1) / xb1 * xb2 + (1 - xb2));
 					xb1moles = (nb - xb2moles * xb2) / xb1;
-					output_msg(sformatf(
+					output_msgf(
 							   "\n%14s  Solid solution is in miscibility gap\n",
-							   " "));
-					output_msg(sformatf(
+							   " ");
+					output_msgf(
 							   "%14s  End members in pct of %s\n\n", " ",
-							   comp1_ptr->Get_name().c_str()));
-					output_msg(sformatf("%22s  %11g pct  %11.2e\n",
-							   " ", (double) xb1, (double) xb1moles));
-					output_msg(sformatf("%22s  %11g pct  %11.2e\n",
-							   " ", (double) xb2, (double) xb2moles));
+							   comp1_ptr->Get_name().c_str());
+					output_msgf("%22s  %11g pct  %11.2e\n",
+							   " ", (double) xb1, (double) xb1moles);
+					output_msgf("%22s  %11g pct  %11.2e\n",
+							   " ", (double) xb2, (double) xb2moles);
 				}
 			}
 		}
 		else
 		{
 			/* solid solution name, moles */
-			output_msg(sformatf("%-15s  %22s  %11.2e\n",
+			output_msgf("%-15s  %22s  %11.2e\n",
 					   ss_ptr->Get_name().c_str(), "  ",
-					   (double) 0.0));
+					   (double) 0.0);
 			/* component name, moles, delta moles, mole fraction */
 			for (i = 0; i < (int) ss_ptr->Get_ss_comps().size(); i++)
 			{
@@ -829,14 +841,14 @@ print_ss_assemblage(void)
 						comp_ptr->Get_moles() -
 						comp_ptr->Get_init_moles();
 				}
-				output_msg(sformatf(
+				output_msgf(
 						   "%15s  %22s  %11.2e  %11.2e  %11.2e\n", " ",
 						   comp_ptr->Get_name().c_str(),
-						   (double) 0, (double) delta_moles, (double) 0));
+						   (double) 0, (double) delta_moles, (double) 0);
 			}
 		}
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -860,39 +872,39 @@ print_reaction(void)
 /*
  *  Print amount of reaction
  */
-	output_msg(sformatf("Reaction %d.\t%s\n\n", use.Get_n_reaction_user(),
-			   reaction_ptr->Get_description().c_str()));
-	output_msg(sformatf(
+	output_msgf("Reaction %d.\t%s\n\n", use.Get_n_reaction_user(),
+			   reaction_ptr->Get_description().c_str());
+	output_msgf(
 			   "\t%11.3e moles of the following reaction have been added:\n\n",
-			   (double) step_x));
+			   (double) step_x);
 /*
  *  Print reaction
  */
-	output_msg(sformatf("\t%-15s%10s\n", " ", "Relative"));
-	output_msg(sformatf("\t%-15s%10s\n\n", "Reactant", "moles"));
+	output_msgf("\t%-15s%10s\n", " ", "Relative");
+	output_msgf("\t%-15s%10s\n\n", "Reactant", "moles");
 	cxxNameDouble::const_iterator cit = reaction_ptr->Get_reactantList().begin();
 	for ( ; cit != reaction_ptr->Get_reactantList().end(); cit++)
 	{
-		output_msg(sformatf("\t%-15s%13.5f\n",
-				   cit->first.c_str(), (double) cit->second));
+		output_msgf("\t%-15s%13.5f\n",
+				   cit->first.c_str(), (double) cit->second);
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 /*
  *   Debug
  */
 
-	output_msg(sformatf("\t%-15s%10s\n", " ", "Relative"));
-	output_msg(sformatf("\t%-15s%10s\n", "Element", "moles"));
+	output_msgf("\t%-15s%10s\n", " ", "Relative");
+	output_msgf("\t%-15s%10s\n", "Element", "moles");
 	cit = reaction_ptr->Get_elementList().begin();
 	for ( ; cit != reaction_ptr->Get_elementList().end(); cit++)
 	{
 		class element * elt_ptr = element_store(cit->first.c_str());
 		assert(elt_ptr);
-		output_msg(sformatf("\t%-15s%13.5f\n",
+		output_msgf("\t%-15s%13.5f\n",
 				   elt_ptr->name,
-				   (double) cit->second));
+				   (double) cit->second);
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -978,72 +990,72 @@ print_kinetics(void)
  */
 	if (phast == FALSE)
 	{
-		output_msg(sformatf("Kinetics %d.\t%s\n\n",
-				   use.Get_n_kinetics_user(), kinetics_ptr->Get_description().c_str()));
+		output_msgf("Kinetics %d.\t%s\n\n",
+				   use.Get_n_kinetics_user(), kinetics_ptr->Get_description().c_str());
 	}
 	else
 	{
-		output_msg(sformatf("Kinetics.\n\n"));
+		output_msgf("Kinetics.\n\n");
 	}
 /*
  *  Print reaction
  */
 	if (state == TRANSPORT)
 	{
-		output_msg(sformatf("\tTime:      %g seconds\n",
-				   (double) (initial_total_time + transport_step * timest)));
-		output_msg(sformatf("\tTime step: %g seconds\n\n",
-				   (double) kin_time_x));
+		output_msgf("\tTime:      %g seconds\n",
+				   (double) (initial_total_time + transport_step * timest));
+		output_msgf("\tTime step: %g seconds\n\n",
+				   (double) kin_time_x);
 	}
 	else if (state == ADVECTION)
 	{
-		output_msg(sformatf("\tTime:      %g seconds\n",
+		output_msgf("\tTime:      %g seconds\n",
 				   (double) (initial_total_time +
-							 advection_step * advection_kin_time)));
-		output_msg(sformatf("\tTime step: %g seconds\n\n",
-				   (double) kin_time_x));
+							 advection_step * advection_kin_time));
+		output_msgf("\tTime step: %g seconds\n\n",
+				   (double) kin_time_x);
 	}
 	else if (state == PHAST)
 	{
-		output_msg(sformatf("\tTime:      %g seconds\n",
-				   (double) rate_sim_time_end));
-		output_msg(sformatf("\tTime step: %g seconds\n\n",
-				   (double) kin_time_x));
+		output_msgf("\tTime:      %g seconds\n",
+				   (double) rate_sim_time_end);
+		output_msgf("\tTime step: %g seconds\n\n",
+				   (double) kin_time_x);
 	}
 	else if (state == REACTION)
 	{
 		if (incremental_reactions == FALSE)
 		{
-			output_msg(sformatf("\tTime step: %g seconds\n\n",
-					   (double) kin_time_x));
+			output_msgf("\tTime step: %g seconds\n\n",
+					   (double) kin_time_x);
 		}
 		else
 		{
-			output_msg(sformatf(
+			output_msgf(
 					   "\tTime step: %g seconds  (Incremented time: %g seconds)\n\n",
-					   (double) kin_time_x, (double) sim_time));
+					   (double) kin_time_x, (double) sim_time);
 		}
 	}
-	output_msg(sformatf("\t%-15s%12s%12s   %-15s%12s\n\n",
+	output_msgf("\t%-15s%12s%12s   %-15s%12s\n\n",
 			   "Rate name", "Delta Moles", "Total Moles", "Reactant",
-			   "Coefficient"));
+			   "Coefficient");
 	for (size_t i = 0; i < kinetics_ptr->Get_kinetics_comps().size(); i++)
 	{
 		cxxKineticsComp *kinetics_comp_ptr = &(kinetics_ptr->Get_kinetics_comps()[i]);
 		if (state != TRANSPORT && state != PHAST)
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e",
+			output_msgf("\t%-15s%12.3e%12.3e",
 					   kinetics_comp_ptr->Get_rate_name().c_str(),
 					   (double) -kinetics_comp_ptr->Get_moles(),
-					   (double) kinetics_comp_ptr->Get_m()));
+					   (double) kinetics_comp_ptr->Get_m());
 		}
 		else
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e",
+			output_msgf("\t%-15s%12.3e%12.3e",
 					   kinetics_comp_ptr->Get_rate_name().c_str(),
 					   (double) (kinetics_comp_ptr->Get_m() -
 								 kinetics_comp_ptr->Get_initial_moles()),
-					   (double) kinetics_comp_ptr->Get_m()));
+					   (double) kinetics_comp_ptr->Get_m());
 		}
 		cxxNameDouble::iterator it = kinetics_comp_ptr->Get_namecoef().begin();
 		for ( ; it != kinetics_comp_ptr->Get_namecoef().end(); it++)
@@ -1052,19 +1064,19 @@ print_kinetics(void)
 			LDBLE coef = it->second;
 			if (it == kinetics_comp_ptr->Get_namecoef().begin())
 			{
-				output_msg(sformatf("   %-15s%12g\n",
+				output_msgf("   %-15s%12g\n",
 						   name.c_str(),
-						   (double) coef));
+						   (double) coef);
 			}
 			else
 			{
-				output_msg(sformatf("\t%39s   %-15s%12g\n", " ",
+				output_msgf("\t%39s   %-15s%12g\n", " ",
 						    name.c_str(),
-						   (double) coef));
+						   (double) coef);
 			}
 		}
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 #ifdef SKIP
@@ -1081,35 +1093,35 @@ print_master_reactions(void)
 
 	for (i = 0; i < (int)master.size(); i++)
 	{
-		output_msg(sformatf("%s\t%s\n\tPrimary reaction\n",
-				   master[i]->elt->name, master[i]->s->name));
+		output_msgf("%s\t%s\n\tPrimary reaction\n",
+				   master[i]->elt->name, master[i]->s->name);
 		next_token = master[i]->rxn_primary.token;
 		for (; next_token->s != NULL; next_token++)
 		{
-			output_msg(sformatf("\t\t%s\t%f\n", next_token->s->name,
-					   (double) next_token->coef));
+			output_msgf("\t\t%s\t%f\n", next_token->s->name,
+					   (double) next_token->coef);
 		}
-		output_msg(sformatf("\n\tSecondary reaction:\n"));
+		output_msgf("\n\tSecondary reaction:\n");
 		if (master[i]->rxn_secondary != NULL)
 		{
 			next_token = master[i]->rxn_secondary.token;
 			for (; next_token->s != NULL; next_token++)
 			{
-				output_msg(sformatf("\t\t%s\t%f\n",
-						   next_token->s->name, (double) next_token->coef));
+				output_msgf("\t\t%s\t%f\n",
+						   next_token->s->name, (double) next_token->coef);
 			}
 		}
-		output_msg(sformatf("\n\tRedox reaction:\n"));
+		output_msgf("\n\tRedox reaction:\n");
 		if (*(master[i]->pe_rxn) != NULL)
 		{
 			next_token = (*(master[i]->pe_rxn))->token;
 			for (; next_token->s != NULL; next_token++)
 			{
-				output_msg(sformatf("\t\t%s\t%f\n",
-						   next_token->s->name, (double) next_token->coef));
+				output_msgf("\t\t%s\t%f\n",
+						   next_token->s->name, (double) next_token->coef);
 			}
 		}
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	}
 	return (OK);
 }
@@ -1151,13 +1163,13 @@ print_mix(void)
 	}
 	if (state == TRANSPORT)
 	{
-		output_msg(sformatf("Mixture %d.\t%s\n\n", use.Get_n_mix_user(),
-				   mix_ptr->Get_description().c_str()));
+		output_msgf("Mixture %d.\t%s\n\n", use.Get_n_mix_user(),
+				   mix_ptr->Get_description().c_str());
 	}
 	else
 	{
-		output_msg(sformatf("Mixture %d.\t%s\n\n", mix_ptr->Get_n_user(),
-				   mix_ptr->Get_description().c_str()));
+		output_msgf("Mixture %d.\t%s\n\n", mix_ptr->Get_n_user(),
+				   mix_ptr->Get_description().c_str());
 	}
 	std::map<int, LDBLE>::const_iterator cit;
 	for (cit = mix_ptr->Get_mixComps().begin(); cit != mix_ptr->Get_mixComps().end(); cit++)
@@ -1168,11 +1180,11 @@ print_mix(void)
 			input_error++;
 			return (ERROR);
 		}
-		output_msg(sformatf("\t%11.3e Solution %d\t%-55s\n",
+		output_msgf("\t%11.3e Solution %d\t%-55s\n",
 				   (double) cit->second,
-				   cit->first, solution_ptr->Get_description().c_str()));
+				   cit->first, solution_ptr->Get_description().c_str());
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -1224,8 +1236,8 @@ print_saturation_indices(void)
  *   Print heading
  */
 	print_centered("Saturation indices");
-	output_msg(sformatf("  %-15s%9s%8s%9s%3d%4s%3d%4s\n\n", "Phase", "SI**",
-			   "log IAP", "log K(", int(tk_x), " K, ", int(floor(patm_x + 0.5)), " atm)"));
+	output_msgf("  %-15s%9s%8s%9s%3d%4s%3d%4s\n\n", "Phase", "SI**",
+			   "log IAP", "log K(", int(tk_x), " K, ", int(floor(patm_x + 0.5)), " atm)");
 
 	for (i = 0; i < (int)phases.size(); i++)
 	{
@@ -1259,15 +1271,15 @@ print_saturation_indices(void)
 		}
 		si = -lk + iap;
 
-		output_msg(sformatf("  %-15s%7.2f  %8.2f%8.2f  %s",
+		output_msgf("  %-15s%7.2f  %8.2f%8.2f  %s",
 				   phases[i]->name, (double) si, (double) iap, (double) lk,
-				   phases[i]->formula));
+				   phases[i]->formula);
 		if (gas && phases[i]->pr_in && phases[i]->pr_p)
 		{
 			if (phases[i]->moles_x || state == INITIAL_SOLUTION)
 			{
-				output_msg(sformatf("\t%s%5.1f%s%5.3f",
-					    " Pressure ", (double) phases[i]->pr_p, " atm, phi ", (double) phases[i]->pr_phi));
+				output_msgf("\t%s%5.1f%s%5.3f",
+					    " Pressure ", (double) phases[i]->pr_p, " atm, phi ", (double) phases[i]->pr_phi);
 			} else
 			{
 				for (int j = 0; j < count_unknowns; j++)
@@ -1277,8 +1289,8 @@ print_saturation_indices(void)
 					if (!strcmp(x[j]->phase->name, phases[i]->name))
 					{
 						if (x[j]->moles)
-							output_msg(sformatf("\t%s%5.1f%s%5.3f",
-								" Pressure ", (double) phases[i]->pr_p, " atm, phi ", (double) phases[i]->pr_phi));
+							output_msgf("\t%s%5.1f%s%5.3f",
+								" Pressure ", (double) phases[i]->pr_p, " atm, phi ", (double) phases[i]->pr_phi);
 						break;
 					}
 				}
@@ -1287,9 +1299,9 @@ print_saturation_indices(void)
 		phases[i]->pr_in = false;
 		output_msg("\n");
 	}
-	output_msg(sformatf("\n%s\n%s",
+	output_msgf("\n%s\n%s",
 		"**For a gas, SI = log10(fugacity). Fugacity = pressure * phi / 1 atm.",
-		"  For ideal gases, phi = 1."));
+		"  For ideal gases, phi = 1.");
 	output_msg("\n\n");
 
 	return (OK);
@@ -1316,11 +1328,11 @@ print_pp_assemblage(void)
  *   Print heading
  */
 	print_centered("Phase assemblage");
-	output_msg(sformatf("%73s\n", "Moles in assemblage"));
-	output_msg(sformatf("%-14s%8s%2s%7s  %11s", "Phase", "SI", "  ", "log IAP",
-			   "log K(T, P)"));
-	output_msg(sformatf("  %8s%12s%12s", " Initial", " Final",
-			   " Delta"));
+	output_msgf("%73s\n", "Moles in assemblage");
+	output_msgf("%-14s%8s%2s%7s  %11s", "Phase", "SI", "  ", "log IAP",
+			   "log K(T, P)");
+	output_msgf("  %8s%12s%12s", " Initial", " Final",
+			   " Delta");
 	output_msg("\n\n");
 
 	for (j = 0; j < count_unknowns; j++)
@@ -1337,8 +1349,8 @@ print_pp_assemblage(void)
 		phase_ptr = x[j]->phase;
 		if (x[j]->phase->rxn_x.token.size() == 0 || phase_ptr->in == FALSE)
 		{
-			output_msg(sformatf("%-18s%23s", x[j]->phase->name,
-					   "Element not present."));
+			output_msgf("%-18s%23s", x[j]->phase->name,
+					   "Element not present.");
 		}
 		else
 		{
@@ -1368,8 +1380,8 @@ print_pp_assemblage(void)
 			   si = -x[j]->phase->lk + iap;
 			   output_msg(OUTPUT_MESSAGE,"\t%-15s%7.2f%8.2f%8.2f", x[j]->phase->name, (double) si, (double) iap, (double) x[j]->phase->lk);
 			 */
-			output_msg(sformatf("%-14s%8.2f  %7.2f  %8.2f",
-					   x[j]->phase->name, (double) si, (double) iap, (double) lk));
+			output_msgf("%-14s%8.2f  %7.2f  %8.2f",
+					   x[j]->phase->name, (double) si, (double) iap, (double) lk);
 		}
 /*
  *   Print pure phase assemblage data
@@ -1400,12 +1412,12 @@ print_pp_assemblage(void)
 		}
 		if (comp_ptr->Get_add_formula().size() == 0)
 		{
-			output_msg(sformatf("%37s\n", token));
+			output_msgf("%37s\n", token);
 		}
 		else
 		{
-			output_msg(sformatf("\n	 %-18s%-15s%36s\n",
-					   comp_ptr->Get_add_formula().c_str(), " is reactant", token));
+			output_msgf("\n	 %-18s%-15s%36s\n",
+					   comp_ptr->Get_add_formula().c_str(), " is reactant", token);
 		}
 	}
 	output_msg("\n");
@@ -1438,27 +1450,27 @@ print_species(void)
 	{
 		if (ICON == TRUE)
 		{
-			output_msg(sformatf("%60s%10s\n", "MacInnes", "MacInnes"));
-			output_msg(sformatf("%40s%10s%10s%10s%10s\n",
-					   "MacInnes", "Log", "Log", "Log", "mole V"));
+			output_msgf("%60s%10s\n", "MacInnes", "MacInnes");
+			output_msgf("%40s%10s%10s%10s%10s\n",
+					   "MacInnes", "Log", "Log", "Log", "mole V");
 		}
 		else
 		{
-			output_msg(sformatf("%60s%10s\n", "Unscaled", "Unscaled"));
-			output_msg(sformatf("%40s%10s%10s%10s%10s\n",
-					   "Unscaled", "Log", "Log", "Log", "mole V"));
+			output_msgf("%60s%10s\n", "Unscaled", "Unscaled");
+			output_msgf("%40s%10s%10s%10s%10s\n",
+					   "Unscaled", "Log", "Log", "Log", "mole V");
 		}
 	}
 	else
 	{
-		output_msg(sformatf("%50s%10s%10s%10s\n", "Log", "Log", "Log", "mole V"));
+		output_msgf("%50s%10s%10s%10s\n", "Log", "Log", "Log", "mole V");
 	}
 #ifdef NO_UTF8_ENCODING
-	output_msg(sformatf("   %-13s%12s%12s%10s%10s%10s%10s\n\n", "Species",
-			   "Molality", "Activity", "Molality", "Activity", "Gamma", "cm3/mol"));
+	output_msgf("   %-13s%12s%12s%10s%10s%10s%10s\n\n", "Species",
+			   "Molality", "Activity", "Molality", "Activity", "Gamma", "cm3/mol");
 #else
-	output_msg(sformatf("   %-13s%12s%12s%10s%10s%10s%11s\n\n", "Species",
-			   "Molality", "Activity", "Molality", "Activity", "Gamma", "cm�/mol"));
+	output_msgf("   %-13s%12s%12s%10s%10s%10s%11s\n\n", "Species",
+			   "Molality", "Activity", "Molality", "Activity", "Gamma", "cm�/mol");
 #endif
 /*
  *   Print list of species
@@ -1490,8 +1502,8 @@ print_species(void)
 		if (name1 != name)
 		{
 			name = name1;
-			output_msg(sformatf("%-11s%12.3e\n", name,
-					   (double) (master_ptr->total / mass_water_aq_x)));
+			output_msgf("%-11s%12.3e\n", name,
+					   (double) (master_ptr->total / mass_water_aq_x));
 			min = censor * master_ptr->total / mass_water_aq_x;
 			if (min > 0)
 			{
@@ -1515,7 +1527,7 @@ print_species(void)
 			{
 				lm = species_list[i].s->lm;
 			}
-			output_msg(sformatf(
+			output_msgf(
 					   "   %-13s%12.3e%12.3e%10.3f%10.3f%10.3f",
 					   species_list[i].s->name,
 					   (double) ((species_list[i].s->moles) /
@@ -1524,16 +1536,16 @@ print_species(void)
 									  species_list[i].s->lg), (double) lm,
 					   (double) (species_list[i].s->lm +
 								 species_list[i].s->lg),
-					   (double) species_list[i].s->lg));
+					   (double) species_list[i].s->lg);
 			//if (species_list[i].s->logk[vm_tc] || !strcmp(species_list[i].s->name, "H+"))
 			if (species_list[i].s->logk[vm_tc] || species_list[i].s == s_hplus)
-				output_msg(sformatf("%10.2f\n",
-					   (double) species_list[i].s->logk[vm_tc]));
+				output_msgf("%10.2f\n",
+					   (double) species_list[i].s->logk[vm_tc]);
 			else
-				output_msg(sformatf("     (0)  \n"));
+				output_msgf("     (0)  \n");
 		}
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
@@ -1570,11 +1582,11 @@ print_surface(void)
 	s_h2o->lm = s_h2o->la;
 	if (use.Get_surface_ptr()->Get_type() == cxxSurface::DDL)
 	{
-		output_msg(sformatf("%-14s\n", "Diffuse Double Layer Surface-Complexation Model\n"));
+		output_msgf("%-14s\n", "Diffuse Double Layer Surface-Complexation Model\n");
 	}
 	else if (use.Get_surface_ptr()->Get_type() == cxxSurface::CCM)
 	{
-		output_msg(sformatf("%-14s\n", "Constant Capacitance Surface-Complexation Model\n"));
+		output_msgf("%-14s\n", "Constant Capacitance Surface-Complexation Model\n");
 	}
 	for (int j = 0; j < count_unknowns; j++)
 	{
@@ -1596,15 +1608,15 @@ print_surface(void)
 			std::string::iterator e = token.end();
 			CParser::copy_token(name, b, e);
 		}
-		output_msg(sformatf("%-14s\n", name.c_str()));
+		output_msgf("%-14s\n", name.c_str());
 /*
  *   Description of surface
  */
 		if (dl_type_x != cxxSurface::NO_DL)
 		{
-			output_msg(sformatf(
+			output_msgf(
 					   "\t%11.3e  Surface + diffuse layer charge, eq\n",
-					   (double) x[j]->f));
+					   (double) x[j]->f);
 		}
 		/*if (use.Get_surface_ptr()->edl == TRUE && diffuse_layer_x == FALSE) { */
 		if ((use.Get_surface_ptr()->Get_type() == cxxSurface::DDL || use.Get_surface_ptr()->Get_type() == cxxSurface::CCM) && dl_type_x == cxxSurface::NO_DL)
@@ -1615,8 +1627,8 @@ print_surface(void)
 		{
 			charge = calc_surface_charge(name.c_str());
 		}
-		output_msg(sformatf("\t%11.3e  Surface charge, eq\n",
-				   (double) charge));
+		output_msgf("\t%11.3e  Surface charge, eq\n",
+				   (double) charge);
 		if (x[j]->type == SURFACE_CB)
 		{
 			cxxSurfaceCharge * charge_ptr = use.Get_surface_ptr()->Find_charge(x[j]->surface_charge);
@@ -1635,23 +1647,23 @@ print_surface(void)
 			else
 			{
 #ifdef NO_UTF8_ENCODING
-				output_msg(sformatf("\tundefined  sigma, C/m2\n"));
+				output_msgf("\tundefined  sigma, C/m2\n");
 #else
-				output_msg(sformatf("\tundefined  sigma, C/m�\n"));
+				output_msgf("\tundefined  sigma, C/m�\n");
 #endif
 			}
 			if (use.Get_surface_ptr()->Get_type() == cxxSurface::CCM)
 			{			
-				output_msg(sformatf("\t%11.3e  capacitance, F/m^2\n",
-					   (double) (charge_ptr->Get_capacitance0())));
+				output_msgf("\t%11.3e  capacitance, F/m^2\n",
+					   (double) (charge_ptr->Get_capacitance0()));
 			}
-			output_msg(sformatf("\t%11.3e  psi, V\n",
+			output_msgf("\t%11.3e  psi, V\n",
 					   (double) (x[j]->master[0]->s->la * 2 * R_KJ_DEG_MOL *
-								 tk_x * LOG_10 / F_KJ_V_EQ)));
-			output_msg(sformatf("\t%11.3e  -F*psi/RT\n",
-					   (double) (x[j]->master[0]->s->la * (-2) * LOG_10)));
-			output_msg(sformatf("\t%11.3e  exp(-F*psi/RT)\n",
-					   exp(x[j]->master[0]->s->la * (-2) * LOG_10)));
+								 tk_x * LOG_10 / F_KJ_V_EQ));
+			output_msgf("\t%11.3e  -F*psi/RT\n",
+					   (double) (x[j]->master[0]->s->la * (-2) * LOG_10));
+			output_msgf("\t%11.3e  exp(-F*psi/RT)\n",
+					   exp(x[j]->master[0]->s->la * (-2) * LOG_10));
 			cxxSurfaceComp * comp_ptr = surface_ptr->Find_comp(x[j]->surface_comp);
 			if (comp_ptr->Get_phase_name().size() > 0)
 			{
@@ -1715,7 +1727,7 @@ print_surface(void)
 			}
 			if (dl_type_x != cxxSurface::NO_DL)
 				print_diffuse_layer(charge_ptr);
-			output_msg(sformatf("\n"));
+			output_msgf("\n");
 /*
  *   Heading for species
  */
@@ -1726,33 +1738,33 @@ print_surface(void)
 				if (x[j] != x[k]->potential_unknown)
 					continue;
 				master_ptr = x[k]->master[0];
-				output_msg(sformatf("%-14s\n",
-						   x[k]->master[0]->elt->name));
-				output_msg(sformatf("\t%11.3e  moles",
-						   (double) x[k]->moles));
+				output_msgf("%-14s\n",
+						   x[k]->master[0]->elt->name);
+				output_msgf("\t%11.3e  moles",
+						   (double) x[k]->moles);
 				cxxSurfaceComp * comp_k_ptr = surface_ptr->Find_comp(x[k]->surface_comp);
 				if (comp_k_ptr->Get_phase_name().size() > 0)
 				{
-					output_msg(sformatf("\t[%g mol/(mol %s)]\n",
+					output_msgf("\t[%g mol/(mol %s)]\n",
 							   (double) comp_k_ptr->Get_phase_proportion(),
-							   comp_k_ptr->Get_phase_name().c_str()));
+							   comp_k_ptr->Get_phase_name().c_str());
 				}
 				else if (comp_k_ptr->Get_rate_name().size() > 0)
 				{
-					output_msg(sformatf(
+					output_msgf(
 							   "\t[%g mol/(mol kinetic reactant %s)]\n",
 							   (double) comp_k_ptr->Get_phase_proportion(),
-							   comp_k_ptr->Get_rate_name().c_str()));
+							   comp_k_ptr->Get_rate_name().c_str());
 				}
 				else
 				{
-					output_msg(sformatf("\n"));
+					output_msgf("\n");
 				}
-				output_msg(sformatf("\t%-15s%12s%12s%12s%12s\n", " ",
-						   " ", "Mole", " ", "Log"));
-				output_msg(sformatf("\t%-15s%12s%12s%12s%12s\n\n",
+				output_msgf("\t%-15s%12s%12s%12s%12s\n", " ",
+						   " ", "Mole", " ", "Log");
+				output_msgf("\t%-15s%12s%12s%12s%12s\n\n",
 						   "Species", "Moles", "Fraction", "Molality",
-						   "Molality"));
+						   "Molality");
 				for (int i = 0; i < (int)species_list.size(); i++)
 				{
 					if (species_list[i].master_s != master_ptr->s)
@@ -1770,7 +1782,7 @@ print_surface(void)
 					{
 						molfrac = 0.0;
 					}
-					output_msg(sformatf(
+					output_msgf(
 							   "\t%-15s%12.3e%12.3f%12.3e%12.3f\n",
 							   species_list[i].s->name,
 							   (double) species_list[i].s->moles,
@@ -1778,23 +1790,23 @@ print_surface(void)
 							   (double) (species_list[i].s->moles /
 										 mass_water_aq_x),
 							   log10(species_list[i].s->moles /
-									 mass_water_aq_x)));
+									 mass_water_aq_x));
 				}
-				output_msg(sformatf("\n"));
+				output_msgf("\n");
 			}
 		}
 		else
 		{
 			int k = j;
 			master_ptr = x[k]->master[0];
-			output_msg(sformatf("%-14s\n", x[k]->master[0]->elt->name));
-			output_msg(sformatf("\t%11.3e  moles\n",
-					   (double) x[k]->moles));
-			output_msg(sformatf("\t%-15s%12s%12s%12s%12s\n", " ", " ",
-					   "Mole", " ", "Log"));
-			output_msg(sformatf("\t%-15s%12s%12s%12s%12s\n\n",
+			output_msgf("%-14s\n", x[k]->master[0]->elt->name);
+			output_msgf("\t%11.3e  moles\n",
+					   (double) x[k]->moles);
+			output_msgf("\t%-15s%12s%12s%12s%12s\n", " ", " ",
+					   "Mole", " ", "Log");
+			output_msgf("\t%-15s%12s%12s%12s%12s\n\n",
 					   "Species", "Moles", "Fraction", "Molality",
-					   "Molality"));
+					   "Molality");
 			for (int i = 0; i < (int)species_list.size(); i++)
 			{
 				if (species_list[i].master_s != master_ptr->s)
@@ -1812,16 +1824,16 @@ print_surface(void)
 				{
 					molfrac = 0.0;
 				}
-				output_msg(sformatf(
+				output_msgf(
 						   "\t%-15s%12.3e%12.3f%12.3e%12.3f\n",
 						   species_list[i].s->name,
 						   (double) species_list[i].s->moles,
 						   (double) molfrac,
 						   (double) (species_list[i].s->moles /
 									 mass_water_aq_x),
-						   log10(species_list[i].s->moles / mass_water_aq_x)));
+						   log10(species_list[i].s->moles / mass_water_aq_x));
 			}
-			output_msg(sformatf("\n"));
+			output_msgf("\n");
 		}
 	}
 	return (OK);
@@ -1864,15 +1876,15 @@ print_surface_cd_music(void)
 			continue;
 		name = x[j]->master[0]->elt->name;
 		Utilities::replace("_psi", "", name);
-		output_msg(sformatf("%-14s\n", name.c_str()));
+		output_msgf("%-14s\n", name.c_str());
 		cxxSurfaceCharge * charge_ptr = use.Get_surface_ptr()->Find_charge(x[j]->surface_charge);
 /*
  *   Description of surface
  */
 		if (dl_type_x != cxxSurface::NO_DL)
 		{
-			output_msg(sformatf("\t%11.3e  Surface + diffuse layer charge, eq\n\n",
-				(double)(x[(size_t)j + 2]->f + (charge_ptr->Get_sigma0() + charge_ptr->Get_sigma1()) * (charge_ptr->Get_specific_area() * charge_ptr->Get_grams()) / F_C_MOL)));
+			output_msgf("\t%11.3e  Surface + diffuse layer charge, eq\n\n",
+				(double)(x[(size_t)j + 2]->f + (charge_ptr->Get_sigma0() + charge_ptr->Get_sigma1()) * (charge_ptr->Get_specific_area() * charge_ptr->Get_grams()) / F_C_MOL));
 		}
 		master_ptr0 =
 			surface_get_psi_master(charge_ptr->Get_name().c_str(), SURF_PSI);
@@ -1904,15 +1916,15 @@ print_surface_cd_music(void)
 				x[j]->comp_unknowns[k]->moles *
 				x[j]->comp_unknowns[k]->master[0]->s->z;
 		}
-		output_msg(sformatf("\t%11.3e  Surface charge, plane 0, eq\n",
-				   (double) (charge0 + sum)));
-		output_msg(sformatf("\t%11.3e  Surface charge, plane 1, eq\n",
-				   (double) charge1));
-		output_msg(sformatf("\t%11.3e  Surface charge, plane 2, eq\n",
-				   (double) charge2));
-		output_msg(sformatf(
+		output_msgf("\t%11.3e  Surface charge, plane 0, eq\n",
+				   (double) (charge0 + sum));
+		output_msgf("\t%11.3e  Surface charge, plane 1, eq\n",
+				   (double) charge1);
+		output_msgf("\t%11.3e  Surface charge, plane 2, eq\n",
+				   (double) charge2);
+		output_msgf(
 				   "\t%11.3e  Sum of surface charge, all planes, eq\n\n",
-				   (double) (charge0 + sum + charge1 + charge2)));
+				   (double) (charge0 + sum + charge1 + charge2));
 		if (x[j]->type == SURFACE_CB)
 		{
 			if ((charge_ptr->Get_specific_area() *
@@ -1950,69 +1962,69 @@ print_surface_cd_music(void)
 			else
 			{
 #ifdef NO_UTF8_ENCODING
-				output_msg(sformatf("\tundefined  sigma, C/m2\n"));
+				output_msgf("\tundefined  sigma, C/m2\n");
 #else
-				output_msg(sformatf("\tundefined  sigma, C/m�\n"));
+				output_msgf("\tundefined  sigma, C/m�\n");
 #endif
 			}
-			output_msg(sformatf("\t%11.3e  psi, plane 0, V\n",
-					   (double) (-master_ptr0->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ)));
-			output_msg(sformatf("\t%11.3e  psi, plane 1, V\n",
-					   (double) (-master_ptr1->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ)));
-			output_msg(sformatf("\t%11.3e  psi, plane 2, V\n\n",
-					   (double) (-master_ptr2->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ)));
-			output_msg(sformatf("\t%11.3e  exp(-F*psi/RT), plane 0\n",
-					   (double) (exp(master_ptr0->s->la * LOG_10))));
-			output_msg(sformatf("\t%11.3e  exp(-F*psi/RT), plane 1\n",
-					   (double) (exp(master_ptr1->s->la * LOG_10))));
-			output_msg(sformatf(
+			output_msgf("\t%11.3e  psi, plane 0, V\n",
+					   (double) (-master_ptr0->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ));
+			output_msgf("\t%11.3e  psi, plane 1, V\n",
+					   (double) (-master_ptr1->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ));
+			output_msgf("\t%11.3e  psi, plane 2, V\n\n",
+					   (double) (-master_ptr2->s->la * LOG_10 * R_KJ_DEG_MOL * tk_x / F_KJ_V_EQ));
+			output_msgf("\t%11.3e  exp(-F*psi/RT), plane 0\n",
+					   (double) (exp(master_ptr0->s->la * LOG_10)));
+			output_msgf("\t%11.3e  exp(-F*psi/RT), plane 1\n",
+					   (double) (exp(master_ptr1->s->la * LOG_10)));
+			output_msgf(
 					   "\t%11.3e  exp(-F*psi/RT), plane 2\n\n",
-					   (double) (exp(master_ptr2->s->la * LOG_10))));
+					   (double) (exp(master_ptr2->s->la * LOG_10)));
 
-			output_msg(sformatf("\t%11.3e  capacitance 0-1, F/m^2\n",
-					   (double) (charge_ptr->Get_capacitance0())));
-			output_msg(sformatf("\t%11.3e  capacitance 1-2, F/m^2\n",
-					   (double) (charge_ptr->Get_capacitance1())));
+			output_msgf("\t%11.3e  capacitance 0-1, F/m^2\n",
+					   (double) (charge_ptr->Get_capacitance0()));
+			output_msgf("\t%11.3e  capacitance 1-2, F/m^2\n",
+					   (double) (charge_ptr->Get_capacitance1()));
 			cxxSurfaceComp * comp_ptr = surface_ptr->Find_comp(x[j]->surface_comp);
 			if (comp_ptr->Get_phase_name().size() > 0)
 			{
-				output_msg(sformatf(
+				output_msgf(
 						   "\t%11.3e  specific area, m^2/mol %s\n",
 						   (double) charge_ptr->Get_specific_area(),
-						   comp_ptr->Get_phase_name().c_str()));
-				output_msg(sformatf(
+						   comp_ptr->Get_phase_name().c_str());
+				output_msgf(
 						   "\t%11.3e  m^2 for %11.3e moles of %s\n\n",
 						   (double) (charge_ptr->Get_grams() *
 									 charge_ptr->Get_specific_area()),
 						   (double) charge_ptr->Get_grams(),
-						   comp_ptr->Get_phase_name().c_str()));
+						   comp_ptr->Get_phase_name().c_str());
 			}
 			else if (comp_ptr->Get_rate_name().size() > 0)
 			{
-				output_msg(sformatf(
+				output_msgf(
 						   "\t%11.3e  specific area, m^2/mol %s\n",
 						   (double) charge_ptr->Get_specific_area(),
-						   comp_ptr->Get_rate_name().c_str()));
-				output_msg(sformatf(
+						   comp_ptr->Get_rate_name().c_str());
+				output_msgf(
 						   "\t%11.3e  m^2 for %11.3e moles of %s\n\n",
 						   (double) (charge_ptr->Get_grams() *
 									 charge_ptr->Get_specific_area()),
 						   (double) charge_ptr->Get_grams(),
-						   comp_ptr->Get_rate_name().c_str()));
+						   comp_ptr->Get_rate_name().c_str());
 			}
 			else
 			{
-				output_msg(sformatf(
+				output_msgf(
 						   "\t%11.3e  specific area, m^2/g\n",
-						   (double) charge_ptr->Get_specific_area()));
-				output_msg(sformatf("\t%11.3e  m^2 for %11.3e g\n\n",
+						   (double) charge_ptr->Get_specific_area());
+				output_msgf("\t%11.3e  m^2 for %11.3e g\n\n",
 						   (double) (charge_ptr->Get_specific_area() *
 									 charge_ptr->Get_grams()),
-						   (double) charge_ptr->Get_grams()));
+						   (double) charge_ptr->Get_grams());
 			}
 			if (dl_type_x != cxxSurface::NO_DL)
 				print_diffuse_layer(charge_ptr);
-			output_msg(sformatf("\n"));
+			output_msgf("\n");
 /*
  *   Heading for species
  */
@@ -2023,33 +2035,33 @@ print_surface_cd_music(void)
 				if (x[j] != x[k]->potential_unknown)
 					continue;
 				master_ptr = x[k]->master[0];
-				output_msg(sformatf("%-14s\n",
-						   x[k]->master[0]->elt->name));
-				output_msg(sformatf("\t%11.3e  moles",
-						   (double) x[k]->moles));
+				output_msgf("%-14s\n",
+						   x[k]->master[0]->elt->name);
+				output_msgf("\t%11.3e  moles",
+						   (double) x[k]->moles);
 				cxxSurfaceComp * comp_k_ptr = surface_ptr->Find_comp(x[k]->surface_comp);
 				if (comp_k_ptr->Get_phase_name().size() > 0)
 				{
-					output_msg(sformatf("\t[%g mol/(mol %s)]\n",
+					output_msgf("\t[%g mol/(mol %s)]\n",
 							   (double) comp_k_ptr->Get_phase_proportion(),
-							   comp_k_ptr->Get_phase_name().c_str()));
+							   comp_k_ptr->Get_phase_name().c_str());
 				}
 				else if (comp_k_ptr->Get_rate_name().size() > 0)
 				{
-					output_msg(sformatf(
+					output_msgf(
 							   "\t[%g mol/(mol kinetic reactant %s)]\n",
 							   (double) comp_k_ptr->Get_phase_proportion(),
-							   comp_k_ptr->Get_rate_name().c_str()));
+							   comp_k_ptr->Get_rate_name().c_str());
 				}
 				else
 				{
-					output_msg(sformatf("\n"));
+					output_msgf("\n");
 				}
-				output_msg(sformatf("\t%-20s%12s%12s%12s%12s\n", " ",
-						   " ", "Mole", " ", "Log"));
-				output_msg(sformatf("\t%-20s%12s%12s%12s%12s\n\n",
+				output_msgf("\t%-20s%12s%12s%12s%12s\n", " ",
+						   " ", "Mole", " ", "Log");
+				output_msgf("\t%-20s%12s%12s%12s%12s\n\n",
 						   "Species", "Moles", "Fraction", "Molality",
-						   "Molality"));
+						   "Molality");
 				for (int i = 0; i < (int)species_list.size(); i++)
 				{
 					if (species_list[i].master_s != master_ptr->s)
@@ -2067,7 +2079,7 @@ print_surface_cd_music(void)
 					{
 						molfrac = 0.0;
 					}
-					output_msg(sformatf(
+					output_msgf(
 							   "\t%-20s%12.3e%12.3f%12.3e%12.3f\n",
 							   species_list[i].s->name,
 							   (double) species_list[i].s->moles,
@@ -2075,9 +2087,9 @@ print_surface_cd_music(void)
 							   (double) (species_list[i].s->moles /
 										 mass_water_aq_x),
 							   log10(species_list[i].s->moles /
-									 mass_water_aq_x)));
+									 mass_water_aq_x));
 				}
-				output_msg(sformatf("\n"));
+				output_msgf("\n");
 			}
 		}
 	}
@@ -2099,16 +2111,16 @@ print_totals(void)
 		return (OK);
 	print_centered("Solution composition");
 	pure_water = TRUE;
-	output_msg(sformatf("\t%-15s%12s%12s\n\n", "Elements", "Molality",
-			   "Moles"));
+	output_msgf("\t%-15s%12s%12s\n\n", "Elements", "Molality",
+			   "Moles");
 	for (i = 0; i < count_unknowns; i++)
 	{
 		if (x[i] == alkalinity_unknown)
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e\n",
+			output_msgf("\t%-15s%12.3e%12.3e\n",
 					   "Alkalinity",
 					   (double) (x[i]->f / mass_water_aq_x),
-					   (double) x[i]->f));
+					   (double) x[i]->f);
 			pure_water = FALSE;
 		}
 		if (x[i] == ph_unknown)
@@ -2117,87 +2129,87 @@ print_totals(void)
 			continue;
 		if (x[i] == charge_balance_unknown)
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e",
+			output_msgf("\t%-15s%12.3e%12.3e",
 					   x[i]->description,
 					   (double) (x[i]->sum / mass_water_aq_x),
-					   (double) x[i]->sum));
-			output_msg(sformatf("  Charge balance\n"));
+					   (double) x[i]->sum);
+			output_msgf("  Charge balance\n");
 			pure_water = FALSE;
 			continue;
 		}
 		if (x[i]->type == SOLUTION_PHASE_BOUNDARY)
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e",
+			output_msgf("\t%-15s%12.3e%12.3e",
 					   x[i]->description,
 					   (double) (x[i]->sum / mass_water_aq_x),
-					   (double) x[i]->sum));
-			output_msg(sformatf("  Equilibrium with %s\n",
-					   x[i]->phase->name));
+					   (double) x[i]->sum);
+			output_msgf("  Equilibrium with %s\n",
+					   x[i]->phase->name);
 			pure_water = FALSE;
 			continue;
 		}
 		if (x[i]->type == MB)
 		{
-			output_msg(sformatf("\t%-15s%12.3e%12.3e\n",
+			output_msgf("\t%-15s%12.3e%12.3e\n",
 					   x[i]->description,
 					   (double) (x[i]->sum / mass_water_aq_x),
-					   (double) x[i]->sum));
+					   (double) x[i]->sum);
 			pure_water = FALSE;
 		}
 	}
 
 	if (pure_water == TRUE)
 	{
-		output_msg(sformatf("\t%-15s\n", "Pure water"));
+		output_msgf("\t%-15s\n", "Pure water");
 	}
 /*
  *   Description of solution
  */
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	print_centered("Description of solution");
 /*
  *   pH
  */
-	output_msg(sformatf("%45s%7.3f    ", "pH  = ",
-			   (double) (-(s_hplus->la))));
+	output_msgf("%45s%7.3f    ", "pH  = ",
+			   (double) (-(s_hplus->la)));
 	if (ph_unknown == NULL)
 	{
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	}
 	else if (ph_unknown == charge_balance_unknown)
 	{
-		output_msg(sformatf("  Charge balance\n"));
+		output_msgf("  Charge balance\n");
 	}
 	else if (ph_unknown->type == SOLUTION_PHASE_BOUNDARY)
 	{
-		output_msg(sformatf("  Equilibrium with %s\n",
-				   ph_unknown->phase->name));
+		output_msgf("  Equilibrium with %s\n",
+				   ph_unknown->phase->name);
 	}
 	else if (ph_unknown->type == ALK)
 	{
-		output_msg(sformatf("  Adjust alkalinity\n"));
+		output_msgf("  Adjust alkalinity\n");
 	}
 /*
  *    pe
  */
-	output_msg(sformatf("%45s%7.3f    ", "pe  = ",
-			   (double) (-(s_eminus->la))));
+	output_msgf("%45s%7.3f    ", "pe  = ",
+			   (double) (-(s_eminus->la)));
 	if (pe_unknown == NULL)
 	{
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	}
 	else if (pe_unknown == charge_balance_unknown)
 	{
-		output_msg(sformatf("  Charge balance\n"));
+		output_msgf("  Charge balance\n");
 	}
 	else if (pe_unknown->type == SOLUTION_PHASE_BOUNDARY)
 	{
-		output_msg(sformatf("  Equilibrium with %s\n",
-				   pe_unknown->phase->name));
+		output_msgf("  Equilibrium with %s\n",
+				   pe_unknown->phase->name);
 	}
 	else if (pe_unknown->type == MH)
 	{
-		output_msg(sformatf("  Adjusted to redox equilibrium\n"));
+		output_msgf("  Adjusted to redox equilibrium\n");
 	}
 /*
  *   Others
@@ -2207,11 +2219,11 @@ print_totals(void)
 	{
 		//output_msg(sformatf("%36s%i%7s%i\n",
 #ifdef NO_UTF8_ENCODING
-		output_msg(sformatf("%35s%3.0f%7s%i\n",
-				   "Specific Conductance (uS/cm, ", tc_x, "oC)  = ", (int) SC));
+		output_msgf("%35s%3.0f%7s%i\n",
+				   "Specific Conductance (uS/cm, ", tc_x, "oC)  = ", (int) SC);
 #else
-		output_msg(sformatf("%35s%3.0f%7s%i\n",
-				   "Specific Conductance (�S/cm, ", tc_x, "�C)  = ", (int) SC));
+		output_msgf("%35s%3.0f%7s%i\n",
+				   "Specific Conductance (�S/cm, ", tc_x, "�C)  = ", (int) SC);
 #endif
 	}
 /* VP: Density Start */
@@ -2226,53 +2238,53 @@ print_totals(void)
 			   (double) dens));
 		if (state == INITIAL_SOLUTION && use.Get_solution_ptr()->Get_initial_data()->Get_calc_density())
 		{
-			output_msg(sformatf(" (Iterated) "));
+			output_msgf(" (Iterated) ");
 		}		
-		if (dens > 1.999) output_msg(sformatf("%18s", " (Program limit)"));
-		output_msg(sformatf("\n"));
-		output_msg(sformatf("%45s%9.5f\n", "     Volume (L)  = ",
-			   (double) calc_solution_volume()));
+		if (dens > 1.999) output_msgf("%18s", " (Program limit)");
+		output_msgf("\n");
+		output_msgf("%45s%9.5f\n", "     Volume (L)  = ",
+			   (double) calc_solution_volume());
 	}
 /* VP: Density End */
 #ifdef NPP
 	if (print_viscosity)
 	{
-		output_msg(sformatf("%45s%9.5f", "Viscosity (mPa s)  = ",
-			   (double) viscos));
+		output_msgf("%45s%9.5f", "Viscosity (mPa s)  = ",
+			   (double) viscos);
 		if (tc_x > 200 && !pure_water) 
 		{
 #ifdef NO_UTF8_ENCODING
-			output_msg(sformatf("%18s\n",
-				   " (solute contributions limited to 200 oC)"));
+			output_msgf("%18s\n",
+				   " (solute contributions limited to 200 oC)");
 #else
-			output_msg(sformatf("%18s\n",
-				   " (solute contributions limited to 200 �C)"));
+			output_msgf("%18s\n",
+				   " (solute contributions limited to 200 �C)");
 #endif
 		}
-		else output_msg(sformatf("\n"));
+		else output_msgf("\n");
 	}
 #endif
-	output_msg(sformatf("%45s%7.3f\n", "Activity of water  = ",
-			   exp(s_h2o->la * LOG_10)));
-	output_msg(sformatf("%45s%11.3e\n", "Ionic strength (mol/kgw)  = ",
-			   (double) mu_x));
-	output_msg(sformatf("%45s%11.3e\n", "Mass of water (kg)  = ",
-			   (double) mass_water_aq_x));
+	output_msgf("%45s%7.3f\n", "Activity of water  = ",
+			   exp(s_h2o->la * LOG_10));
+	output_msgf("%45s%11.3e\n", "Ionic strength (mol/kgw)  = ",
+			   (double) mu_x);
+	output_msgf("%45s%11.3e\n", "Mass of water (kg)  = ",
+			   (double) mass_water_aq_x);
 	if (alkalinity_unknown == NULL)
 	{
-		output_msg(sformatf("%45s%11.3e\n",
+		output_msgf("%45s%11.3e\n",
 				   "Total alkalinity (eq/kg)  = ",
-				   (double) (total_alkalinity / mass_water_aq_x)));
+				   (double) (total_alkalinity / mass_water_aq_x));
 	}
 	if (carbon_unknown == NULL && total_carbon)
 	{
-		output_msg(sformatf("%45s%11.3e\n",
+		output_msgf("%45s%11.3e\n",
 				   "Total carbon (mol/kg)  = ",
-				   (double) (total_carbon / mass_water_aq_x)));
+				   (double) (total_carbon / mass_water_aq_x));
 	}
 	if (total_co2)
-		output_msg(sformatf("%45s%11.3e\n", "Total CO2 (mol/kg)  = ",
-			   (double) (total_co2 / mass_water_aq_x)));
+		output_msgf("%45s%11.3e\n", "Total CO2 (mol/kg)  = ",
+			   (double) (total_co2 / mass_water_aq_x));
 #ifdef NO_UTF8_ENCODING
 	output_msg(sformatf("%45s%6.2f\n", "Temperature (oC)  = ",
 #else
@@ -2283,45 +2295,45 @@ print_totals(void)
 	if (patm_x != 1.0)
 	{
 		/* only print if different than default */
-		output_msg(sformatf("%45s%5.2f\n", "Pressure (atm)  = ",
-			(double) patm_x));
+		output_msgf("%45s%5.2f\n", "Pressure (atm)  = ",
+			(double) patm_x);
 	}
 
 	if (potV_x)
 	{
-		output_msg(sformatf("%45s%5.2f\n", "Electrical Potential (Volt)  = ",
-			(double)potV_x));
+		output_msgf("%45s%5.2f\n", "Electrical Potential (Volt)  = ",
+			(double)potV_x);
 	}
 
-	output_msg(sformatf("%45s%11.3e\n", "Electrical balance (eq)  = ",
-			   (double) cb_x));
-	output_msg(sformatf("%45s%6.2f\n",
+	output_msgf("%45s%11.3e\n", "Electrical balance (eq)  = ",
+			   (double) cb_x);
+	output_msgf("%45s%6.2f\n",
 			   "Percent error, 100*(Cat-|An|)/(Cat+|An|)  = ",
-			   (double) (100 * cb_x / total_ions_x)));
+			   (double) (100 * cb_x / total_ions_x));
 	if (iterations == overall_iterations)
-		output_msg(sformatf("%45s%3d\n", "Iterations  = ", iterations));
+		output_msgf("%45s%3d\n", "Iterations  = ", iterations);
 	else
-		output_msg(sformatf("%45s%3d (%d overall)\n", "Iterations  = ", iterations, overall_iterations));
+		output_msgf("%45s%3d (%d overall)\n", "Iterations  = ", iterations, overall_iterations);
 	if (pitzer_model == TRUE || sit_model == TRUE)
 	{
 		if (always_full_pitzer == FALSE)
 		{
-			output_msg(sformatf("%45s%3d\n", "Gamma iterations  = ",
-				   gamma_iterations));
+			output_msgf("%45s%3d\n", "Gamma iterations  = ",
+				   gamma_iterations);
 		}
 		else
 		{
-			output_msg(sformatf("%45s%3d\n", "Gamma iterations  = ",
-				  iterations));
+			output_msgf("%45s%3d\n", "Gamma iterations  = ",
+				  iterations);
 		}
-		output_msg(sformatf("%45s%9.5f\n", "Osmotic coefficient  = ",
-				    (double) COSMOT));
-		if (print_density) output_msg(sformatf("%45s%9.5f\n", "Density of water  = ",
-				   (double) DW0));
+		output_msgf("%45s%9.5f\n", "Osmotic coefficient  = ",
+				    (double) COSMOT);
+		if (print_density) output_msgf("%45s%9.5f\n", "Density of water  = ",
+				   (double) DW0);
 	}
-	output_msg(sformatf("%45s%e\n", "Total H  = ", (double) total_h_x));
-	output_msg(sformatf("%45s%e\n", "Total O  = ", (double) total_o_x));
-	output_msg(sformatf("\n"));
+	output_msgf("%45s%e\n", "Total H  = ", (double) total_h_x);
+	output_msgf("%45s%e\n", "Total O  = ", (double) total_o_x);
+	output_msgf("\n");
 
 	return (OK);
 }
@@ -2373,7 +2385,7 @@ print_user_print(void)
 		error_msg("Fatal Basic error in USER_PRINT.", STOP);
 	}
 	if (this->output_newline) {
-		output_msg(sformatf("\n"));
+		output_msgf("\n");
 	}
 	this->Set_output_newline(true);
 	if (use.Get_kinetics_in() == TRUE)
@@ -2419,13 +2431,13 @@ print_using(void)
 		{
 			if (state == TRANSPORT)
 			{
-				output_msg(sformatf("Using mix %d.\t%s\n",
-						   use.Get_n_mix_user(), mix_ptr->Get_description().c_str()));
+				output_msgf("Using mix %d.\t%s\n",
+						   use.Get_n_mix_user(), mix_ptr->Get_description().c_str());
 			}
 			else
 			{
-				output_msg(sformatf("Using mix %d.\t%s\n",
-						   use.Get_n_mix_user_orig(), mix_ptr->Get_description().c_str()));
+				output_msgf("Using mix %d.\t%s\n",
+						   use.Get_n_mix_user_orig(), mix_ptr->Get_description().c_str());
 			}
 
 		}
@@ -2433,8 +2445,8 @@ print_using(void)
 	else
 	{
 		solution_ptr = Utilities::Rxn_find(Rxn_solution_map, use.Get_n_solution_user());
-		output_msg(sformatf("Using solution %d.\t%s\n",
-				   use.Get_n_solution_user(), solution_ptr->Get_description().c_str()));
+		output_msgf("Using solution %d.\t%s\n",
+				   use.Get_n_solution_user(), solution_ptr->Get_description().c_str());
 	}
 /*
  *   Exchange and surface
@@ -2442,54 +2454,54 @@ print_using(void)
 	if (use.Get_exchange_in())
 	{
 		cxxExchange *exchange_ptr = Utilities::Rxn_find(Rxn_exchange_map, use.Get_n_exchange_user());
-		output_msg(sformatf("Using exchange %d.\t%s\n",
-				   use.Get_n_exchange_user(), exchange_ptr->Get_description().c_str()));
+		output_msgf("Using exchange %d.\t%s\n",
+				   use.Get_n_exchange_user(), exchange_ptr->Get_description().c_str());
 	}
 	if (use.Get_surface_in())
 	{
 		cxxSurface *surface_ptr = Utilities::Rxn_find(Rxn_surface_map, use.Get_n_surface_user());
-		output_msg(sformatf("Using surface %d.\t%s\n",
-				   use.Get_n_surface_user(), surface_ptr->Get_description().c_str()));
+		output_msgf("Using surface %d.\t%s\n",
+				   use.Get_n_surface_user(), surface_ptr->Get_description().c_str());
 	}
 	if (use.Get_pp_assemblage_in() == TRUE)
 	{
 		cxxPPassemblage * pp_assemblage_ptr = Utilities::Rxn_find(Rxn_pp_assemblage_map, use.Get_n_pp_assemblage_user());
-		output_msg(sformatf("Using pure phase assemblage %d.\t%s\n",
-				   use.Get_n_pp_assemblage_user(), pp_assemblage_ptr->Get_description().c_str()));
+		output_msgf("Using pure phase assemblage %d.\t%s\n",
+				   use.Get_n_pp_assemblage_user(), pp_assemblage_ptr->Get_description().c_str());
 	}
 	if (use.Get_ss_assemblage_in() == TRUE)
 	{
 		cxxSSassemblage * ss_assemblage_ptr = Utilities::Rxn_find(Rxn_ss_assemblage_map, use.Get_n_ss_assemblage_user());
-		output_msg(sformatf(
+		output_msgf(
 				   "Using solid solution assemblage %d.\t%s\n",
 				   use.Get_n_ss_assemblage_user(),
-				   ss_assemblage_ptr->Get_description().c_str()));
+				   ss_assemblage_ptr->Get_description().c_str());
 	}
 	if (use.Get_gas_phase_in())
 	{
 		cxxGasPhase * gas_phase_ptr = Utilities::Rxn_find(Rxn_gas_phase_map, use.Get_n_gas_phase_user());
-		output_msg(sformatf("Using gas phase %d.\t%s\n",
-				   use.Get_n_gas_phase_user(), gas_phase_ptr->Get_description().c_str()));
+		output_msgf("Using gas phase %d.\t%s\n",
+				   use.Get_n_gas_phase_user(), gas_phase_ptr->Get_description().c_str());
 	}
 	if (use.Get_temperature_in())
 	{
 		cxxTemperature *temperature_ptr = Utilities::Rxn_find(Rxn_temperature_map, use.Get_n_temperature_user());
-		output_msg(sformatf("Using temperature %d.\t%s\n",
-				   use.Get_n_temperature_user(), temperature_ptr->Get_description().c_str()));
+		output_msgf("Using temperature %d.\t%s\n",
+				   use.Get_n_temperature_user(), temperature_ptr->Get_description().c_str());
 	}
 	if (use.Get_pressure_in())
 	{
 		cxxPressure *pressure_ptr = Utilities::Rxn_find(Rxn_pressure_map, use.Get_n_pressure_user());
-		output_msg(sformatf("Using pressure %d.\t%s\n",
-				   use.Get_n_pressure_user(), pressure_ptr->Get_description().c_str()));
+		output_msgf("Using pressure %d.\t%s\n",
+				   use.Get_n_pressure_user(), pressure_ptr->Get_description().c_str());
 	}
 	if (use.Get_reaction_in())
 	{
 		if (state != TRANSPORT || transport_step > 0)
 		{
 			cxxReaction *reaction_ptr = Utilities::Rxn_find(Rxn_reaction_map, use.Get_n_reaction_user());
-			output_msg(sformatf("Using reaction %d.\t%s\n",
-					   use.Get_n_reaction_user(), reaction_ptr->Get_description().c_str()));
+			output_msgf("Using reaction %d.\t%s\n",
+					   use.Get_n_reaction_user(), reaction_ptr->Get_description().c_str());
 		}
 	}
 	if (use.Get_kinetics_in())
@@ -2503,10 +2515,10 @@ print_using(void)
 		{
 			kinetics_ptr = Utilities::Rxn_find(Rxn_kinetics_map, -2);
 		}
-		output_msg(sformatf("Using kinetics %d.\t%s\n",
-				   use.Get_n_kinetics_user(), kinetics_ptr->Get_description().c_str()));
+		output_msgf("Using kinetics %d.\t%s\n",
+				   use.Get_n_kinetics_user(), kinetics_ptr->Get_description().c_str());
 	}
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 
@@ -3553,17 +3565,22 @@ punch_user_graph(void)
 }
 #endif // MULTICHART
 
+#if !defined(va_copy)
+#define va_copy(dst, src) ((dst) = (src))
+#endif
+
 char * Phreeqc::
-sformatf(const char *format, ...)
+vformatf(const char *format, va_list args)
 {
+	// formats into sformatf_buffer, doubling it until the text fits
 	bool success = false;
 	do
 	{
-		va_list args;
-		va_start(args, format);
-		int j = vsnprintf(sformatf_buffer, sformatf_buffer_size, format, args);
+		va_list args_copy;
+		va_copy(args_copy, args);
+		int j = vsnprintf(sformatf_buffer, sformatf_buffer_size, format, args_copy);
 		success = (j > 0 && j < (int) sformatf_buffer_size);
-		va_end(args);
+		va_end(args_copy);
 		if (!success)
 		{
 			sformatf_buffer_size *= 2;
@@ -3576,6 +3593,30 @@ sformatf(const char *format, ...)
 	return sformatf_buffer;
 }
 
+char * Phreeqc::
+sformatf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	char *buffer = vformatf(format, args);
+	va_end(args);
+	return buffer;
+}
+
+void Phreeqc::
+output_msgf(const char *format, ...)
+{
+	// output_msg(sformatf(format, ...)) without formatting text
+	// that nothing would receive (see print_all)
+	if (!phrq_io || discard_output)
+		return;
+	va_list args;
+	va_start(args, format);
+	vformatf(format, args);
+	va_end(args);
+	output_msg(sformatf_buffer);
+}
+
 /* ---------------------------------------------------------------------- */
 int Phreeqc::
 print_alkalinity(void)
@@ -3607,11 +3648,11 @@ print_alkalinity(void)
 	min = fabs(censor * total_alkalinity / mass_water_aq_x);
 	if (alk_list.size() > 0)
 	{
-		output_msg(sformatf("\t%26s%11.3e\n\n",
+		output_msgf("\t%26s%11.3e\n\n",
 				   "Total alkalinity (eq/kgw)  = ",
-				   (double) (total_alkalinity / mass_water_aq_x)));
-		output_msg(sformatf("\t%-15s%12s%12s%10s\n\n", "Species",
-				   "Alkalinity", "Molality", "Alk/Mol"));
+				   (double) (total_alkalinity / mass_water_aq_x));
+		output_msgf("\t%-15s%12s%12s%10s\n\n", "Species",
+				   "Alkalinity", "Molality", "Alk/Mol");
 		if (alk_list.size() > 1) qsort(&alk_list[0], alk_list.size(),
 			  (size_t) sizeof(class species_list), species_list_compare_alk);
 		for (size_t i = 0; i < alk_list.size(); i++)
@@ -3619,16 +3660,16 @@ print_alkalinity(void)
 			if (fabs(alk_list[i].s->alk * (alk_list[i].s->moles) /
 				 mass_water_aq_x) < min)
 				continue;
-			output_msg(sformatf("\t%-15s%12.3e%12.3e%10.2f\n",
+			output_msgf("\t%-15s%12.3e%12.3e%10.2f\n",
 					   alk_list[i].s->name,
 					   (double) (alk_list[i].s->alk *
 								 (alk_list[i].s->moles) / mass_water_aq_x),
 					   (double) ((alk_list[i].s->moles) / mass_water_aq_x),
-					   (double) (alk_list[i].s->alk)));
+					   (double) (alk_list[i].s->alk));
 		}
 	}
 
-	output_msg(sformatf("\n"));
+	output_msgf("\n");
 	return (OK);
 }
 
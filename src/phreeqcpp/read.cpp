@@ -101,6 +101,33 @@ read_input(void)
 		if (next_keyword > 0 && next_keyword < Keywords::KEY_COUNT_KEYWORDS)
 		{
 			keycount[next_keyword]++;
+			switch (next_keyword)
+			{
+			// keywords that change entities only through tracked saves
+			case Keywords::KEY_END:
+			case Keywords::KEY_REACTION:
+			case Keywords::KEY_MIX:
+			case Keywords::KEY_USE:
+			case Keywords::KEY_SAVE:
+			case Keywords::KEY_SELECTED_OUTPUT:
+			case Keywords::KEY_KNOBS:
+			case Keywords::KEY_PRINT:
+			case Keywords::KEY_TITLE:
+			case Keywords::KEY_INCREMENTAL_REACTIONS:
+			case Keywords::KEY_USER_PRINT:
+			case Keywords::KEY_USER_PUNCH:
+			case Keywords::KEY_USER_GRAPH:
+			case Keywords::KEY_DUMP:
+			case Keywords::KEY_DELETE:
+			case Keywords::KEY_RUN_CELLS:
+			case Keywords::KEY_REACTION_RAW:
+			case Keywords::KEY_MIX_RAW:
+			case Keywords::KEY_REACTION_MODIFY:
+				break;
+			default:
+				mark_all_dirty();
+				break;
+			}
 		}
 		switch (next_keyword)
 		{
@@ -7393,9 +7420,12 @@ read_debug(void)
 		"minimum_total",                   /* 21 */  
 		"min_total",                       /* 22 */   
 		"debug_mass_action",               /* 23 */
-		"debug_mass_balance"               /* 24 */
+		"debug_mass_balance",              /* 24 */
+		"sparse_newton",                   /* 25 */
+		"logk_cache_size",                 /* 26 */
+		"model_cache_size"                 /* 27 */
 	};
-	int count_opt_list = 25;
+	int count_opt_list = 28;
 /*
  *   Read parameters:
  *	ineq_tol;
@@ -7503,6 +7533,27 @@ read_debug(void)
 		case 24:				/* debug_mass_balance */
 			debug_mass_balance = get_true_false(next_char, TRUE);
 			break;
+		case 25:				/* sparse_newton */
+			sparse_newton = get_true_false(next_char, TRUE);
+			break;
+		case 26:				/* logk_cache_size */
+			{
+				int n = 0;
+				(void)sscanf(next_char, "%d", &n);
+				logk_cache_max = (n > 0) ? (size_t)n : 0;
+				while (logk_cache.size() > logk_cache_max)
+					logk_cache.pop_back();
+			}
+			break;
+		case 27:				/* model_cache_size */
+			{
+				int n = 0;
+				(void)sscanf(next_char, "%d", &n);
+				model_cache_max = (n > 0) ? (size_t)n : 0;
+				while (model_cache.size() > model_cache_max)
+					model_cache.pop_back();
+			}
+			break;
 		}
 		if (return_value == EOF || return_value == KEYWORD)
 			break;
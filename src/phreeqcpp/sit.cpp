@@ -289,7 +289,7 @@ sit(void)
 /* ---------------------------------------------------------------------- */
 {
   int i, i0, i1;
-  LDBLE param, z0, z1;
+  LDBLE param, z0;
   LDBLE A, AGAMMA, T;
 	/*
 	   LDBLE CONV, XI, XX, OSUM, BIGZ, DI, F, XXX, GAMCLM, 
@@ -399,41 +399,24 @@ sit(void)
 	 *  Sums for sit_LGAMMA, and OSMOT
 	 *  epsilons are tabulated for log10 gamma (not ln gamma)
 	 */
-	for (size_t j = 0; j < param_list.size(); j++)
+	for (size_t j = 0; j < sit_terms.size(); j++)
 	{
-		int i = param_list[j];
-		i0 = sit_params[i]->ispec[0];
-		i1 = sit_params[i]->ispec[1];
-		//if (sit_IPRSNT[i0] == FALSE || sit_IPRSNT[i1] == FALSE) continue;
-		z0 = spec[i0]->z;
-		z1 = spec[i1]->z;
-		param = sit_params[i]->p;
-		switch (sit_params[i]->type)
+		const class pitz_term &t = sit_terms[j];
+		i0 = t.ispec[0];
+		i1 = t.ispec[1];
+		param = t.p;
+		switch (t.type)
 		{
 		case TYPE_SIT_EPSILON:
 			sit_LGAMMA[i0] += sit_M[i1] * param;
 			sit_LGAMMA[i1] += sit_M[i0] * param;
-			if (z0 == 0.0 && z1 == 0.0)
-			{
-				OSMOT += sit_M[i0] * sit_M[i1] * param / 2.0;
-			}
-			else
-			{
-				OSMOT += sit_M[i0] * sit_M[i1] * param;
-			}
+			OSMOT += sit_M[i0] * sit_M[i1] * param * t.os_coef;
 			break;
 		case TYPE_SIT_EPSILON_MU:
 			sit_LGAMMA[i0] += sit_M[i1] * I * param;
 			sit_LGAMMA[i1] += sit_M[i0] * I * param;
 			OSMOT += sit_M[i0] * sit_M[i1] * param;
-			if (z0 == 0.0 && z1 == 0.0)
-			{
-				OSMOT += sit_M[i0] * sit_M[i1] * param * I / 2.0;
-			}
-			else
-			{
-				OSMOT += sit_M[i0] * sit_M[i1] * param * I;
-			}
+			OSMOT += sit_M[i0] * sit_M[i1] * param * I * t.os_coef;
 			break;
 		default:
 		case TYPE_Other:
@@ -513,6 +496,7 @@ sit_clean_up(void)
 	spec.clear();
 	//delete aphi; 
 	sit_M.clear(); 
+	sit_terms.clear();
 
 	return OK;
 }
@@ -1602,6 +1586,10 @@ C     Set DW0
 		int i = param_list[j];
 		calc_sit_param(sit_params[i], TK, TR);
 	}
+	for (size_t j = 0; j < sit_terms.size(); j++)
+	{
+		sit_terms[j].p = sit_params[sit_terms[j].param]->p;
+	}
 	calc_dielectrics(TK - 273.15, patm_x);
 	sit_A0 = A0;
 	OTEMP = TK;
@@ -1681,4 +1669,22 @@ sit_make_lists(void)
 		if (sit_IPRSNT[i0] == FALSE || sit_IPRSNT[i1] == FALSE) continue;
 		param_list.push_back(i);
 	}
+	/*
+	 *  Epsilon matrix of the active species, one entry per parameter,
+	 *  values are set by PTEMP_SIT
+	 */
+	sit_terms.clear();
+	for (size_t j = 0; j < param_list.size(); j++)
+	{
+		class pitz_param *pz_ptr = sit_params[param_list[j]];
+		class pitz_term t;
+		t.ispec[0] = pz_ptr->ispec[0];
+		t.ispec[1] = pz_ptr->ispec[1];
+		t.type = pz_ptr->type;
+		t.param = param_list[j];
+		t.p = pz_ptr->p;
+		/* neutral-neutral terms count half in the osmotic coefficient */
+		t.os_coef = (spec[t.ispec[0]]->z == 0.0 && spec[t.ispec[1]]->z == 0.0) ? 0.5 : 1.0;
+		sit_terms.push_back(t);
+	}
 }
@@ -205,7 +205,7 @@ clean_up(void)
 	phases_map.clear();
 	logk_map.clear();
 	/* strings */
-	strings_map_clear();
+	strings_table_clear();
 	/* delete basic interpreter */
 	basic_free();
 	/* change_surf */
@@ -365,11 +365,10 @@ element_store(const char * element)
 	/*
 	 *   Search list
 	 */
-	std::map<std::string, class element *>::const_iterator it;
-	it = elements_map.find(element);
-	if (it != elements_map.end())
+	class element *found_ptr = elements_map.find(element);
+	if (found_ptr != NULL)
 	{
-		return (it->second);
+		return (found_ptr);
 	}
 	/*
 	 *   Save new element structure and return pointer to it
@@ -380,7 +379,7 @@ element_store(const char * element)
 	elt_ptr->primary = NULL;
 	elt_ptr->gfw = 0.0;
 	elements.push_back(elt_ptr);
-	elements_map[element] = elt_ptr;
+	elements_map.store(element, elt_ptr);
 	return (elt_ptr);
 }
 /* **********************************************************************
@@ -1264,11 +1263,9 @@ phase_store(const char *name_in)
  */
 	std::string name = name_in;
 	str_tolower(name);
-	std::map<std::string, class phase*>::iterator p_it =
-		phases_map.find(name);
-	if (p_it != phases_map.end())
+	phase_ptr = phases_map.find(name);
+	if (phase_ptr != NULL)
 	{
-		phase_ptr = p_it->second;
 		phase_free(phase_ptr);
 		phase_init(phase_ptr);
 		phase_ptr->name = string_hsave(name_in);
@@ -1285,7 +1282,7 @@ phase_store(const char *name_in)
 /*
  *   Update map
  */
-	phases_map[name] = phases[n];
+	phases_map.store(name, phases[n]);
 	return (phases[n]);
 }
 /* **********************************************************************
@@ -1627,14 +1624,7 @@ s_search(const char* name)
 	 *   If found, pointer to the appropriate species structure is returned.
 	 *       else, NULL pointer is returned.
 	 */
-	class species* s_ptr = NULL;
-	std::map<std::string, class species*>::iterator s_it = 
-		species_map.find(name);
-	if (s_it != species_map.end())
-	{
-		s_ptr = s_it->second;
-	}
-	return (s_ptr);
+	return (species_map.find(name));
 }
 /* ---------------------------------------------------------------------- */
 class species * Phreeqc::
@@ -1693,7 +1683,7 @@ s_store(const char *name, LDBLE l_z, int replace_if_found)
 /*
  *   Update map
  */
-	species_map[name] = s_ptr;
+	species_map.store(name, s_ptr);
 	return (s_ptr);
 }
 /* ---------------------------------------------------------------------- */
@@ -2570,17 +2560,14 @@ logk_store(const char *name_in, int replace_if_found)
 	class logk* logk_ptr = NULL;
 	std::string name = name_in;
 	str_tolower(name);
-	std::map<std::string, class logk*>::iterator it =
-		logk_map.find(name);
+	logk_ptr = logk_map.find(name);
 
-	if (it != logk_map.end() && replace_if_found == FALSE)
+	if (logk_ptr != NULL && replace_if_found == FALSE)
 	{
-		logk_ptr = it->second;
 		return (logk_ptr);
 	}
-	else if (it != logk_map.end() && replace_if_found == TRUE)
+	else if (logk_ptr != NULL && replace_if_found == TRUE)
 	{
-		logk_ptr = it->second;
 		logk_init(logk_ptr);
 	}
 	else
@@ -2596,7 +2583,7 @@ logk_store(const char *name_in, int replace_if_found)
 /*
  *   Update map
  */
-	logk_map[name] = logk_ptr;
+	logk_map.store(name, logk_ptr);
 	return (logk_ptr);
 }
 
@@ -2683,14 +2670,8 @@ logk_search(const char *name_in)
  */
 	std::string name = name_in;
 	str_tolower(name);
-	std::map<std::string, class logk*>::iterator l_it =
-		logk_map.find(name);
-	if (l_it != logk_map.end())
-	{
-		logk_ptr = l_it->second;
-		return (logk_ptr);
-	}
-	return (NULL);
+	logk_ptr = logk_map.find(name);
+	return (logk_ptr);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -160,33 +160,18 @@ tidy_model(void)
 		/* species */
 		if (s.size() > 1) //qsort(&s[0], s.size(), sizeof(class species*), s_compare);
 		{
-			s.clear();
-			std::map<std::string, class species*>::iterator it;
-			for (it = species_map.begin(); it != species_map.end(); it++)
-			{
-				s.push_back(it->second);
-			}
+			species_map.sorted(s);
 		}
 		/* master species */
 		if (master.size() > 1) qsort(&master[0], master.size(), sizeof(class master*), master_compare);
 		/* elements */
 		if (elements.size() > 1) //qsort(&elements[0], elements.size(), sizeof(class element*), element_compare);
 		{
-			elements.clear();
-			std::map<std::string, class element*>::iterator it;
-			for (it = elements_map.begin(); it != elements_map.end(); it++)
-			{
-				elements.push_back(it->second);
-			}
+			elements_map.sorted(elements);
 		}		/* phases */
 		if (phases.size() > 1) //qsort(&phases[0], phases.size(), sizeof(class phase *), phase_compare);
 		{
-			phases.clear();
-			std::map<std::string, class phase*>::iterator it;
-			for (it = phases_map.begin(); it != phases_map.end(); it++)
-			{
-				phases.push_back(it->second);
-			}
+			phases_map.sorted(phases);
 		}
 	}
 
@@ -592,8 +577,8 @@ add_other_logk(LDBLE * source_k, std::vector<class name_coef> &add_logk)
 		coef = add_logk[i].coef;
 		std::string token = add_logk[i].name;
 		str_tolower(token);
-		std::map<std::string, class logk *>::iterator l_it = logk_map.find(token);
-		if (l_it == logk_map.end())
+		class logk *found_ptr = logk_map.find(token);
+		if (found_ptr == NULL)
 		{
 			input_error++;
 			error_string = sformatf(
@@ -602,7 +587,7 @@ add_other_logk(LDBLE * source_k, std::vector<class name_coef> &add_logk)
 			error_msg(error_string, CONTINUE);
 			return (ERROR);
 		}
-		logk_ptr = l_it->second;
+		logk_ptr = found_ptr;
 		analytic = false;
 		for (j = T_A1; j <= T_A6; j++)
 		{
@@ -657,8 +642,8 @@ add_logks(class logk *logk_ptr, int repeats)
 		coef = logk_ptr->add_logk[i].coef;
 		std::string token = logk_ptr->add_logk[i].name;
 		str_tolower(token);
-		std::map<std::string, class logk*>::iterator l_it = logk_map.find(token);
-		if (l_it == logk_map.end())
+		class logk *found_ptr = logk_map.find(token);
+		if (found_ptr == NULL)
 		{
 			input_error++;
 			error_string = sformatf(
@@ -667,7 +652,7 @@ add_logks(class logk *logk_ptr, int repeats)
 			error_msg(error_string, CONTINUE);
 			return (ERROR);
 		}
-		next_logk_ptr = l_it->second;
+		next_logk_ptr = found_ptr;
 		if (next_logk_ptr->done == FALSE)
 		{
 			/*output_msg(sformatf( "Done == FALSE\n", token)); */
@@ -5535,6 +5520,8 @@ reset_last_model(void)
 	last_model.dl_type = cxxSurface::NO_DL;
 	last_model.surface_comp.clear();
 	last_model.surface_charge.clear();
+	/* species and phases may have been renumbered */
+	model_cache.clear();
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
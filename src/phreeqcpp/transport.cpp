@@ -8,6 +8,7 @@
 #include "cxxKinetics.h"
 #include "Solution.h"
 #include <limits.h>
+#include <algorithm>
 
 LDBLE F_Re3 = F_C_MOL / (R_KJ_DEG_MOL * 1e3);
 LDBLE tk_x2; // average tk_x of icell and jcell
@@ -20,7 +21,7 @@ std::set <std::string> dif_spec_names;
 std::set <std::string> dif_els_names;
 std::map<int, std::map<std::string, double> > neg_moles;
 std::map<std::string, double> els;
-double *Ct2, *l_tk_x2, **A, **LU, **mixf, **mixf_stag;
+double *Ct2, *l_tk_x2, **A, **mixf, **mixf_stag;
 int mixf_comp_size = 0;
 
 struct CURRENT_CELLS
@@ -42,15 +43,25 @@ struct CT /* summed parts of V_M and mcd transfer in a timestep for all cells, f
 	class J_ij *J_ij, *J_ij_il;
 	int count_m_s;
 	class M_S *m_s;
-	int v_m_size, J_ij_size, m_s_size;
+	int v_m_size, J_ij_size, m_s_size, v_m_il_size, J_ij_il_size;
 } *ct = NULL;
-std::map<int, std::map<std::string, J_ij_save> > cell_J_ij;
+std::vector<std::vector<J_ij_save> > cell_J_ij; /* [cell][i], aligned with ct[cell].J_ij */
 struct MOLES_ADDED /* total moles added to balance negative conc's */
 {
 	char *name;
 	LDBLE moles;
 } *moles_added;
 int count_moles_added;
+/* orders species_list by the rank of the species names */
+struct species_name_rank_less
+{
+	species_name_rank_less(const std::vector<int> &r) : rank(r) {}
+	bool operator()(const class species_list &a, const class species_list &b) const
+	{
+		return rank[a.s->number] < rank[b.s->number];
+	}
+	const std::vector<int> &rank;
+};
 
 #if defined(PHREEQCI_GUI)
 #ifdef _DEBUG
@@ -78,6 +89,8 @@ transport(void)
 	LDBLE step_fraction;
 
 	state = TRANSPORT;
+	s_name_rank.clear();
+	mcd_elts.clear();
 	diffc_tr = diffc;
 	diffc_max = 0.0;
 	transp_surf = warn_fixed_Surf = warn_MCD_X = 0;
@@ -143,6 +156,7 @@ transport(void)
 			ct[i].J_ij_il = NULL;
 			ct[i].m_s = NULL;
 			ct[i].v_m_size = ct[i].J_ij_size = ct[i].m_s_size = 0;
+			ct[i].v_m_il_size = ct[i].J_ij_il_size = 0;
 		}
 		count_moles_added = (int)elements.size();
 		moles_added = (struct MOLES_ADDED *) PHRQ_malloc((size_t) (count_moles_added)* sizeof(struct MOLES_ADDED));
@@ -1021,6 +1035,10 @@ transport_cleanup(void)
 			ct[i].m_s = (class M_S *) free_check_null(ct[i].m_s);
 		}
 		ct = (struct CT *) free_check_null(ct);
+		m_s = (class M_S *) free_check_null(m_s);
+		m_s_size = 0;
+		s_name_rank.clear();
+		mcd_elts.clear();
 		for (int i = 0; i < count_moles_added; i++)
 		{
 			moles_added[i].name = (char *)free_check_null(moles_added[i].name);
@@ -1037,7 +1055,6 @@ transport_cleanup(void)
 			for (i = 0; i < count_cells + 2 + l_stag * count_cells; i++)
 			{
 				A[i] = (LDBLE *)free_check_null(A[i]);
-				LU[i] = (LDBLE *)free_check_null(LU[i]);
 			}
 		}
 		if (mixf)
@@ -1056,7 +1073,6 @@ transport_cleanup(void)
 			}
 		}
 		A = (LDBLE **)free_check_null(A);
-		LU = (LDBLE **)free_check_null(LU);
 		mixf = (LDBLE **)free_check_null(mixf);
 		mixf_stag = (LDBLE **)free_check_null(mixf_stag);
 		dif_spec_names.clear();
@@ -1798,7 +1814,7 @@ set_initial_moles(int i)
 		comp.Set_totals(elt_list_NameDouble());
 		comp.Set_charge_balance(0.0);
 		temp_exchange.Get_exchange_comps().push_back(comp);
-		Rxn_exchange_map[i] = temp_exchange;
+		Utilities::Rxn_store(Rxn_exchange_map, i, temp_exchange);
 
 		state = INITIAL_EXCHANGE;
 		initial_exchangers(TRUE);
@@ -1901,12 +1917,25 @@ fill_spec(int l_cell_no, int ref_cell)
 
 	count_spec = count_exch_spec = 0;
 	/*
-	* sort species by name...
+	* sort species by name, using the rank of the names in s...
 	*/
-	if (species_list.size() > 1)
+	if (s_name_rank.size() != s.size())
+	{
+		std::vector<class species *> s_sorted = s;
+		if (s_sorted.size() > 1)
+			qsort(&s_sorted[0], s_sorted.size(), sizeof(class species *), s_compare);
+		s_name_rank.resize(s.size());
+		for (i = 0; i < (int)s_sorted.size(); i++)
+			s_name_rank[s_sorted[i]->number] = i;
+	}
+	for (i = 1; i < (int)species_list.size(); i++)
+	{
+		if (s_name_rank[species_list[i].s->number] < s_name_rank[species_list[(size_t)i - 1].s->number])
+			break;
+	}
+	if (i < (int)species_list.size())
 	{
-		qsort(&species_list[0], species_list.size(),
-			sizeof(class species_list), sort_species_name);
+		std::sort(species_list.begin(), species_list.end(), species_name_rank_less(s_name_rank));
 	}
 
 	for (i = 0; i < (int)species_list.size(); i++)
@@ -1922,7 +1951,7 @@ fill_spec(int l_cell_no, int ref_cell)
 		//	continue;
 		//if (s_ptr->type == SURF)
 		//	continue;
-		if (i > 0 && strcmp(s_ptr->name, species_list[(size_t)i - 1].s->name) == 0)
+		if (i > 0 && s_ptr == species_list[(size_t)i - 1].s)
 			continue;
 		//if (s_ptr == s_h2o)
 		//	continue;
@@ -2222,7 +2251,7 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 	int i, icell, cp, comp;
 	// ifirst = (bcon_first == 2 ? 1 : 0); ilast = (bcon_last == 2 ? count_cells - 1 : count_cells);
 	int ifirst, ilast;
-	int i_1, i0, i1, i2 = 0;
+	int i0, i1;
 	//double mfr, mfr1, max_b = 0, b, grad, dVc, j_0e, min_dif_M = pow(10, min_dif_LM);
 	double mfr, mfr1, grad, dVc, j_0e, min_dif_M = pow(10, min_dif_LM);
 	LDBLE dum1, dum2, dum_stag = 0.0, min_mol;
@@ -2240,16 +2269,12 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 	int c = count_cells, c1 = c + 1, c2 = c + 2, c_1 = c - 1, cc = c + stagnant * c, cc1 = cc + 1;
 
 	comp = sol_D[1].count_spec - sol_D[1].count_exch_spec;
-	cell_J_ij.clear();
+	cell_J_ij.resize((size_t)count_cells + 1);
 	for (i = 0; i <= count_cells; i++)
 	{
-		std::map<std::string, class J_ij_save> J_map;
+		cell_J_ij[i].assign(comp, J_ij_save());
 		for (cp = 0; cp < comp; cp++)
-		{
-			class J_ij_save J_save;
-			J_map[sol_D[1].spec[cp].name] = J_save;
-		}
-		cell_J_ij[i] = J_map;
+			cell_J_ij[i][cp].name = sol_D[1].spec[cp].name;
 	}
 	if (heat_nmix)
 		comp += 1;
@@ -2267,26 +2292,10 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 		if (A == NULL) malloc_error();
 		for (i = 0; i < count_cells + 2 + stagnant * count_cells; i++)
 		{
-			if (stagnant)
-				A[i] = (LDBLE *)PHRQ_calloc((2 * count_cells + 2), sizeof(LDBLE));
-			else 
-				A[i] = (LDBLE *)PHRQ_malloc(3 * sizeof(LDBLE));
+			A[i] = (LDBLE *)PHRQ_calloc((stagnant ? 4 : 3), sizeof(LDBLE));
 			if (A[i] == NULL) malloc_error();
 		}
 	}
-	if (LU == NULL)
-	{
-		LU = (LDBLE **)PHRQ_malloc((count_cells + 2 + (size_t)stagnant * count_cells) * sizeof(LDBLE *));
-		if (LU == NULL) malloc_error();
-		for (i = 0; i < count_cells + 2 + stagnant * count_cells; i++)
-		{
-			if (stagnant)
-				LU[i] = (LDBLE *)PHRQ_calloc((2 * count_cells + 2), sizeof(LDBLE));
-			else 
-				LU[i] = (LDBLE *)PHRQ_malloc(3 * sizeof(LDBLE));
-			if (LU[i] == NULL) malloc_error();
-		}
-	}
 	if (mixf == NULL)
 	{
 		mixf = (LDBLE **)PHRQ_malloc((count_cells + 2) * sizeof(LDBLE *));
@@ -2423,6 +2432,15 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 				Ct2[i] = sol_D[i].spec[cp].c;
 		}
 		// fill coefficient matrix A ...
+		// A is stored by rows: A[i][0] = A(i, i - 1), A[i][1] = A(i, i), A[i][2] = A(i, i + 1) for the mobile cells 0..c1,
+		//   A[i][3] = A(i, stagnant cell of i).
+		// Stagnant cell rows c2..cc1: A[i][0] = A(i, mobile cell i - c1), A[i][1] = A(i, i),
+		//   A[c2][2] = A(c2, 0), A[cc1][3] = A(cc1, c1).
+		if (stagnant)
+		{
+			for (i = 0; i <= cc1; i++)
+				A[i][0] = A[i][1] = A[i][2] = A[i][3] = 0;
+		}
 		// boundary cells ...
 		if (heat_nmix && cp == comp - 1)
 		{
@@ -2439,12 +2457,12 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 			A[1][0] = 0; A[1][1] = 1 + mfr1; A[1][2] = -mfr1;
 			if (stagnant)
 			{
-				A[0][0] = A[c2][c2] = 1;
+				A[0][1] = A[c2][1] = 1;
 				if (mixf_stag[1][cp])
 				{
 					A[1][1] += mixf_stag[1][cp];
-					A[1][c2] = A[c2][1] = -mixf_stag[1][cp];
-					A[c2][c2] += mixf_stag[1][cp];
+					A[1][3] = A[c2][0] = -mixf_stag[1][cp];
+					A[c2][1] += mixf_stag[1][cp];
 				}
 			}
 			else
@@ -2455,40 +2473,31 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 		else
 		{
 			A[1][0] = -mfr; A[1][1] = 1 + mfr + mfr1; A[1][2] = -mfr1;
+			if (dV_dcell)
+			{
+				A[0][1] = 1 + mfr; A[0][2] = -mfr;
+			}
+			else
+			{
+				A[0][1] = 1; A[0][2] = 0;
+			}
 			if (stagnant)
 			{
-				if (dV_dcell)
-				{
-					A[0][0] = 1 + mfr; A[0][1] = -mfr;
-				}
-				else
-					A[0][0] = 1;
-				A[c2][c2] = 1;
+				A[c2][1] = 1;
 				if (mixf_stag[0][cp])
 				{
 					if (dV_dcell)
 					{
-						A[0][0] += mixf_stag[0][cp]; A[0][c2] = -mixf_stag[0][cp];
+						A[0][1] += mixf_stag[0][cp]; A[0][3] = -mixf_stag[0][cp];
 					}
-					A[c2][0] = -mixf_stag[0][cp];
-					A[c2][c2] += mixf_stag[0][cp];
+					A[c2][2] = -mixf_stag[0][cp];
+					A[c2][1] += mixf_stag[0][cp];
 				}
 				if (mixf_stag[1][cp])
 				{
 					A[1][1] += mixf_stag[1][cp];
-					A[1][c2] = A[c2][1] = -mixf_stag[1][cp];
-					A[c2][c2] += mixf_stag[1][cp];
-				}
-			}
-			else
-			{
-				if (dV_dcell)
-				{
-					A[0][1] = 1 + mfr; A[0][2] = -mfr;
-				}
-				else
-				{
-					A[0][1] = 1; A[0][2] = 0;
+					A[1][3] = A[c2][0] = -mixf_stag[1][cp];
+					A[c2][1] += mixf_stag[1][cp];
 				}
 			}
 		}
@@ -2504,62 +2513,51 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 		}
 		if (bcon_last == 2)
 		{
+			A[count_cells][0] = -mfr; A[count_cells][1] = 1 + mfr;
 			if (stagnant)
 			{
-				A[count_cells][c_1] = -mfr; A[count_cells][count_cells] = 1 + mfr;
-				A[c1][c1] = A[cc1][cc1] = 1;
+				A[c1][1] = A[cc1][1] = 1;
 				if (mixf_stag[count_cells][cp])
 				{
-					A[count_cells][count_cells] += mixf_stag[count_cells][cp];
-					A[count_cells][cc1] = A[cc1][count_cells] = -mixf_stag[count_cells][cp];
-					A[cc1][cc1] += mixf_stag[count_cells][cp];
+					A[count_cells][1] += mixf_stag[count_cells][cp];
+					A[count_cells][3] = A[cc1][0] = -mixf_stag[count_cells][cp];
+					A[cc1][1] += mixf_stag[count_cells][cp];
 				}
 			}
 			else
 			{
-				A[count_cells][0] = -mfr; A[count_cells][1] = 1 + mfr; A[count_cells][2] = 0;
+				A[count_cells][2] = 0;
 				A[c1][0] = 0; A[c1][1] = 1;
 			}
 		}
 		else
 		{
+			A[count_cells][0] = -mfr; A[count_cells][1] = 1 + mfr + mfr1; A[count_cells][2] = -mfr1;
+			if (dV_dcell)
+			{
+				A[c1][0] = -mfr1; A[c1][1] = 1 + mfr1;
+			}
+			else
+			{
+				A[c1][0] = 0; A[c1][1] = 1;
+			}
 			if (stagnant)
 			{
-				A[count_cells][c_1] = -mfr; A[count_cells][count_cells] = 1 + mfr + mfr1;
-				A[count_cells][c1] = -mfr1;
-				if (dV_dcell)
-				{
-					A[c1][count_cells] = -mfr1; A[c1][c1] = 1 + mfr1;
-				}
-				else
-					A[c1][c1] = 1;
-				A[cc1][cc1] = 1;
+				A[cc1][1] = 1;
 				if (mixf_stag[count_cells][cp])
 				{
-					A[count_cells][count_cells] += mixf_stag[count_cells][cp];
-					A[count_cells][cc1] = A[cc1][count_cells] = -mixf_stag[count_cells][cp];
-					A[cc1][cc1] += mixf_stag[count_cells][cp];
+					A[count_cells][1] += mixf_stag[count_cells][cp];
+					A[count_cells][3] = A[cc1][0] = -mixf_stag[count_cells][cp];
+					A[cc1][1] += mixf_stag[count_cells][cp];
 				}
 				if (mixf_stag[c1][cp])
 				{
 					if (dV_dcell)
 					{
-						A[c1][c1] += mixf_stag[c1][cp]; A[c1][cc1] = -mixf_stag[c1][cp];
+						A[c1][1] += mixf_stag[c1][cp]; A[c1][3] = -mixf_stag[c1][cp];
 					}
-					A[cc1][c1] = -mixf_stag[c1][cp];
-					A[cc1][cc1] += mixf_stag[c1][cp];
-				}
-			}
-			else
-			{
-				A[count_cells][0] = -mfr; A[count_cells][1] = 1 + mfr + mfr1; A[count_cells][2] = -mfr1;
-				if (dV_dcell)
-				{
-					A[c1][0] = -mfr1; A[c1][1] = 1 + mfr1;
-				}
-				else
-				{
-					A[c1][0] = 0; A[c1][1] = 1;
+					A[cc1][3] = -mixf_stag[c1][cp];
+					A[cc1][1] += mixf_stag[c1][cp];
 				}
 			}
 		}
@@ -2576,122 +2574,83 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 				mfr = mixf[i - 1][cp] = DDt * ct[i - 1].v_m[cp].b_ij;
 				mfr1 = mixf[i][cp] = DDt * ct[i].v_m[cp].b_ij;
 			}
-			if (stagnant && mixf_stag[i][cp])
-			{
-				A[i][i - 1] = -mfr; A[i][i] = 1 + mfr + mfr1 + mixf_stag[i][cp]; A[i][i + 1] = -mfr1;
-				A[i + c1][i + c1] = 1 + mixf_stag[i][cp];
-				A[i][i + c1] = A[i + c1][i] = -mixf_stag[i][cp];
-			}
-			else
+			A[i][0] = -mfr; A[i][1] = 1 + mfr + mfr1; A[i][2] = -mfr1;
+			if (stagnant)
 			{
-				A[i][0] = -mfr; A[i][1] = 1 + mfr + mfr1; A[i][2] = -mfr1;
+				A[i + c1][1] = 1;
+				if (mixf_stag[i][cp])
+				{
+					A[i][1] += mixf_stag[i][cp];
+					A[i + c1][1] += mixf_stag[i][cp];
+					A[i][3] = A[i + c1][0] = -mixf_stag[i][cp];
+				}
 			}
 		}
-		if (stagnant)
-			// decompose full A in LU, bypass A[][] = 0...
+		if (stagnant && c < 2)
 		{
-			LDBLE s;
-			LU[0][0] = A[0][0]; LU[1][0] = A[1][0]; LU[c2][0] = A[c2][0];
-			LU[0][1] = A[0][1] / LU[0][0]; LU[0][c2] = A[0][c2] / LU[0][0];
-			for (i = 1; i <= cc1; i++)
+			// a single mobile cell: the stagnant cell couples 0 and c1, solve the small system in full...
+			int n = cc1 + 1;
+			std::vector<LDBLE> F((size_t)n * n, 0.0);
+			for (i = 0; i <= c1; i++)
 			{
-				i_1 = i - 1;
-				if (i < c2)
+				if (i > 0) F[(size_t)i * n + i - 1] = A[i][0];
+				F[(size_t)i * n + i] = A[i][1];
+				if (i < c1) F[(size_t)i * n + i + 1] = A[i][2];
+				F[(size_t)i * n + c2] += A[i][3];
+			}
+			F[(size_t)c2 * n + 1] = A[c2][0];
+			F[(size_t)c2 * n + c2] = A[c2][1];
+			F[(size_t)c2 * n] += A[c2][2];
+			F[(size_t)c2 * n + c1] += A[c2][3];
+			for (i = 0; i < n; i++)
+			{
+				for (i0 = i + 1; i0 < n; i0++)
 				{
-					LU[i][i] = A[i][i] - LU[i][i_1] * LU[i_1][i];
-					LU[i + 1][i] = A[i + 1][i];
-					LU[i][i + 1] = A[i][i + 1] / LU[i][i];
-					if (i == 1)
-					{
-						LU[c2][1] = A[c2][1] - LU[c2][0] * LU[0][1];
-						LU[1][c2] = (A[1][c2] - LU[1][0] * LU[0][c2]) / LU[1][1];
-					}
-					else
-					{
-						for (i0 = 0; i0 <= i_1; i0++)
-						{
-							if (i0 == i_1 && i0 < c)
-							{
-								LU[c2 + i0][i] = A[c2 + i0][i];
-								LU[i][c2 + i0] = A[i][c2 + i0] / LU[i][i];
-							}
-							else if (i0 < c)
-							{
-								LU[c2 + i0][i] = -LU[c2 + i0][i_1] * LU[i_1][i];
-								LU[i][c2 + i0] = -LU[i][i_1] * LU[i_1][c2 + i0] / LU[i][i];
-							}
-							if (i > c && i0 == c_1)
-							{
-								LU[c2 + i0][i] += A[c2 + i0][i];
-								LU[i][c2 + i0] += A[i][c2 + i0] / LU[i][i];
-							}
-						}
-					}
+					dum = F[(size_t)i0 * n + i] / F[(size_t)i * n + i];
+					if (!dum)
+						continue;
+					for (i1 = i; i1 < n; i1++)
+						F[(size_t)i0 * n + i1] -= dum * F[(size_t)i * n + i1];
+					Ct2[i0] -= dum * Ct2[i];
 				}
-				else
+			}
+			for (i = n - 1; i >= 0; i--)
+			{
+				for (i1 = i + 1; i1 < n; i1++)
+					Ct2[i] -= F[(size_t)i * n + i1] * Ct2[i1];
+				Ct2[i] /= F[(size_t)i * n + i];
+			}
+		}
+		else
+		{
+			if (stagnant)
+			{
+				// eliminate the stagnant cells: each one couples only to its mobile cell, and c2 and cc1 to
+				// the boundary cells 0 and c1, which are neighbors of cells 1 and c. What remains is tridiagonal.
+				for (i = c2; i <= cc1; i++)
 				{
-					// the i = count_cells + 2 and higher rows are filled from i0 onwards, need to subtract the L*U terms for the ith column of L.
-					for (i0 = i; i0 <= cc1; i0++)
+					int r[3], nr = 0;
+					LDBLE a_s[3];
+					r[nr] = i - c1; a_s[nr++] = A[i][0];
+					if (i == c2)
 					{
-						s = 0;
-						if (i0 == i)
-						{
-							i2 = (i == c2 ? 0 : i - c1);
-							for (i1 = i2; i1 <= i_1; i1++)
-								s += LU[i0][i1] * LU[i1][i];
-							LU[i][i] = A[i][i] - s;
-							i2 += (i2 == 0 ? 2 : 1);
-						}
-						else
-						{
-							for (i1 = i2; i1 <= i_1; i1++)
-								s += LU[i0][i1] * LU[i1][i];
-							LU[i0][i] = -s;
-						}
+						r[nr] = 0; a_s[nr++] = A[i][2];
 					}
-					// and the ith row of U...
 					if (i == cc1)
-						break;
-					for (i0 = i + 1; i0 <= cc1; i0++)
 					{
-						s = 0;
-						if (i0 == i + 1)
-							i2 = i - c;
-						for (i1 = i2; i1 <= i_1; i1++)
-							s += LU[i][i1] * LU[i1][i0];
-						LU[i][i0] = -s / LU[i][i];
-						i2++;
+						r[nr] = c1; a_s[nr++] = A[i][3];
 					}
-				}
-			}
-			Ct2[0] /= LU[0][0];
-			for (i = 1; i <= cc1; i++)
-			{
-				i_1 = i - 1;
-				if (i < c2)
-					s = LU[i][i_1] * Ct2[i_1];
-				else
-				{
-					i2 = 0;
-					s = 0;
-					for (i1 = i2; i1 <= i_1; i1++)
+					for (i0 = 0; i0 < nr; i0++)
 					{
-						s += LU[i][i1] * Ct2[i1];
-						i2 += (i2 == 0 ? 2 : 1);
+						if (!A[r[i0]][3])
+							continue;
+						dum = A[r[i0]][3] / A[i][1];
+						for (i1 = 0; i1 < nr; i1++)
+							A[r[i0]][1 + r[i1] - r[i0]] -= dum * a_s[i1];
+						Ct2[r[i0]] -= dum * Ct2[i];
 					}
 				}
-				Ct2[i] = (Ct2[i] - s) / LU[i][i];
 			}
-			for (i = cc; i >= 0; i--)
-			{
-				s = 0;
-				for (i1 = i + 1; i1 <= cc1; i1++)
-					s += LU[i][i1] * Ct2[i1];
-				Ct2[i] -= s;
-			}
-		}
-		else
-		{
 			// decompose A in LU : store L in A[..][0..1] and U in A[..][2] ...
 			for (i = 1; i <= count_cells + 1; i++)
 			{
@@ -2706,6 +2665,19 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 			// Now obtain Ct2 in U.Ct2 = 'y' ...
 			for (i = count_cells; i >= 0; i--)
 				Ct2[i] -= A[i][2] * Ct2[i + 1];
+			if (stagnant)
+			{
+				// and back-substitute the stagnant cells...
+				for (i = c2; i <= cc1; i++)
+				{
+					dum = Ct2[i] - A[i][0] * Ct2[i - c1];
+					if (i == c2)
+						dum -= A[i][2] * Ct2[0];
+					if (i == cc1)
+						dum -= A[i][3] * Ct2[c1];
+					Ct2[i] = dum / A[i][1];
+				}
+			}
 		}
 		// Moles transported by concentration gradient from cell [i] to [i + 1] go in tot1,
 		//        moles by stagnant exchange from cell [i] to [i + c1] go in tot_stag
@@ -2748,13 +2720,8 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 				if (!i0)
 				{
 					ct[i].J_ij[cp].tot1 = -mixf[i][cp] * grad;
-
-					std::map<int, std::map<std::string, class J_ij_save> >::iterator
-						cell_iter = cell_J_ij.find(i);
-					std::map< std::string, class J_ij_save >::iterator
-						s_iter = cell_iter->second.find(sol_D[1].spec[cp].name);
-					s_iter->second.flux_c = ct[i].J_ij[cp].tot1;
-					s_iter->second.flux_t = ct[i].J_ij[cp].tot1;
+					cell_J_ij[i][cp].flux_c = ct[i].J_ij[cp].tot1;
+					cell_J_ij[i][cp].flux_t = ct[i].J_ij[cp].tot1;
 				}
 				else
 					ct[i].J_ij[cp].tot_stag = -mixf_stag[i][cp] * grad;
@@ -2794,15 +2761,11 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 			comp -= 1;
 			break;
 		}
-		char * temp_name = string_duplicate(ct[1].J_ij[cp].name);
-		const char* cptr = temp_name;
-		count_elts = 0;
-		get_elts_in_species(&cptr, 1);
-		free_check_null(temp_name);
-		for (int k = 0; k < count_elts; k++)
+		const std::vector<class elt_list> &elts = mcd_species_elts(ct[1].J_ij[cp].name);
+		for (size_t k = 0; k < elts.size(); k++)
 		{
-			if (!strcmp(elt_list[k].elt->name, "X")) continue;
-			dif_els_names.insert(elt_list[k].elt->name);
+			if (!strcmp(elts[k].elt->name, "X")) continue;
+			dif_els_names.insert(elts[k].elt->name);
 		}
 	}
 	count_m_s = (int) dif_els_names.size();
@@ -2870,12 +2833,7 @@ diffuse_implicit(LDBLE DDt, int stagnant)
 			{
 				dVc = (cell_data[i + 1].potV - cell_data[i].potV) * F_Re3 / l_tk_x2[i];
 				ct[i].J_ij[cp].tot1 -= mixf[i][cp] * dVc;
-
-				std::map<int, std::map<std::string, class J_ij_save> >::iterator
-					cell_iter = cell_J_ij.find(i);
-				std::map< std::string, class J_ij_save >::iterator
-					s_iter = cell_iter->second.find(sol_D[1].spec[cp].name);
-				s_iter->second.flux_t = ct[i].J_ij[cp].tot1;
+				cell_J_ij[i][cp].flux_t = ct[i].J_ij[cp].tot1;
 			}
 			if (stagnant && ct[i].Dz2c_stag)
 			{
@@ -3309,7 +3267,8 @@ multi_D(LDBLE DDt, int mobile_cell, int stagnant)
 		dVtemp = dV_dcell;
 		dV_dcell = 0;
 	}
-	cell_J_ij.clear();
+	for (i = 0; i < (int)cell_J_ij.size(); i++)
+		cell_J_ij[i].clear();
 	icell = jcell = -1;
 	first_c = last_c = -1;
 	il_calcs = -1;
@@ -3435,13 +3394,17 @@ multi_D(LDBLE DDt, int mobile_cell, int stagnant)
 				if (!il_calcs)
 				{
 					tot1_h = tot1_o = tot2_h = tot2_o = 0.0;
-					m_s = (class M_S *) free_check_null(m_s);
 					count_m_s = (ct[icell].J_ij_count_spec < count_moles_added ?
 						ct[icell].J_ij_count_spec : count_moles_added);
-					m_s = (class M_S *) PHRQ_malloc((size_t) count_m_s *
-						sizeof(class M_S));
-					if (m_s == NULL)
-						malloc_error();
+					if (count_m_s > m_s_size)
+					{
+						m_s = (class M_S *) free_check_null(m_s);
+						m_s = (class M_S *) PHRQ_malloc((size_t) count_moles_added *
+							sizeof(class M_S));
+						if (m_s == NULL)
+							malloc_error();
+						m_s_size = count_moles_added;
+					}
 					for (i1 = 0; i1 < count_m_s; i1++)
 					{
 						m_s[i1].name = NULL;
@@ -3468,12 +3431,17 @@ multi_D(LDBLE DDt, int mobile_cell, int stagnant)
 					{
 						length = (int) strlen(m_s[l].name);
 						cxxNameDouble::iterator it;
-						for (it = use.Get_solution_ptr()->Get_totals().begin();
+						/* totals are sorted, names with the element as prefix are adjacent */
+						for (it = use.Get_solution_ptr()->Get_totals().lower_bound(m_s[l].name);
 							it != use.Get_solution_ptr()->Get_totals().end(); it++)
 						{
-							length2 =
-								(int) (size_t) strcspn(it->first.c_str(), "(");
-							if (strncmp(m_s[l].name, it->first.c_str(), length) == 0 && length == length2)
+							if (strncmp(m_s[l].name, it->first.c_str(), length) != 0)
+							{
+								it = use.Get_solution_ptr()->Get_totals().end();
+								break;
+							}
+							length2 = (int) (size_t) strcspn(it->first.c_str(), "(");
+							if (length == length2)
 							{
 								it->second -= m_s[l].tot1;
 								break;
@@ -3500,11 +3468,17 @@ multi_D(LDBLE DDt, int mobile_cell, int stagnant)
 					{
 						length = (int) strlen(m_s[l].name);
 						cxxNameDouble::iterator it;
-						for (it = use.Get_solution_ptr()->Get_totals().begin();
+						/* totals are sorted, names with the element as prefix are adjacent */
+						for (it = use.Get_solution_ptr()->Get_totals().lower_bound(m_s[l].name);
 							it != use.Get_solution_ptr()->Get_totals().end(); it++)
 						{
+							if (strncmp(m_s[l].name, it->first.c_str(), length) != 0)
+							{
+								it = use.Get_solution_ptr()->Get_totals().end();
+								break;
+							}
 							length2 = (int) (size_t) strcspn(it->first.c_str(), "(");
-							if (strncmp(m_s[l].name, it->first.c_str(), length) == 0 && length == length2)
+							if (length == length2)
 							{
 								it->second += m_s[l].tot2;
 								break;
@@ -3614,17 +3588,7 @@ multi_D(LDBLE DDt, int mobile_cell, int stagnant)
 		}
 	}
 
-	m_s = (class M_S *) free_check_null(m_s);
-
-	for (i = first_c; i < last_c2; i++)
-	{
-		if (stagnant && i > first_c && i <= count_cells + first_c)
-			continue;
-		ct[i].J_ij = (class J_ij *) free_check_null(ct[i].J_ij);
-		if (il_calcs)
-			ct[i].J_ij_il = (class J_ij *) free_check_null(ct[i].J_ij_il);
-		ct[i].v_m = (struct V_M *) free_check_null(ct[i].v_m);
-	}
+	/* m_s and the ct[] flux arrays are kept for the next time step, freed in transport_cleanup */
 	if (dVtemp && stagnant)
 	{
 		dV_dcell = dVtemp;
@@ -3641,37 +3605,31 @@ fill_m_s(class J_ij *l_J_ij, int l_J_ij_count_spec, int icell, int stagnant)
 	/*  sum up the primary or secondary master_species from solute species
 	*      H and O go in tot1&2_h and tot1&2_o
 	*/
-	int j, k, l;
+	int j, k, l, l_count_elts;
 	LDBLE fraction;
-	const char* cptr;
 
 	for (j = 0; j < l_J_ij_count_spec; j++)
 	{
-		{
-			char * temp_name = string_duplicate(l_J_ij[j].name);
-			cptr = temp_name;
-			count_elts = 0;
-			get_elts_in_species(&cptr, 1);
-			free_check_null(temp_name);
-		}
+		const std::vector<class elt_list> &elts = mcd_species_elts(l_J_ij[j].name);
+		l_count_elts = (int) elts.size();
 		if (implicit && stagnant < 2)
 		{
-			for (k = 0; k < count_elts; k++)
+			for (k = 0; k < l_count_elts; k++)
 			{
 				for (l = 0; l < count_m_s; l++)
 				{
-					if (strcmp(ct[icell].m_s[l].name, elt_list[k].elt->name) == 0)
+					if (strcmp(ct[icell].m_s[l].name, elts[k].elt->name) == 0)
 					{
-						fraction = fabs((double)elt_list[k].coef * l_J_ij[j].tot1) + fabs(ct[icell].m_s[l].tot1);
+						fraction = fabs((double)elts[k].coef * l_J_ij[j].tot1) + fabs(ct[icell].m_s[l].tot1);
 						if (fraction)
-							fraction = fabs((double)elt_list[k].coef * l_J_ij[j].tot1) / fraction;
+							fraction = fabs((double)elts[k].coef * l_J_ij[j].tot1) / fraction;
 						else
 							fraction = 1;
-						ct[icell].m_s[l].tot1 += elt_list[k].coef * l_J_ij[j].tot1;
+						ct[icell].m_s[l].tot1 += elts[k].coef * l_J_ij[j].tot1;
 						ct[icell].m_s[l].charge *= (1 - fraction);
 						ct[icell].m_s[l].charge += fraction * l_J_ij[j].charge;
 						if (stagnant)
-							ct[icell].m_s[l].tot_stag += elt_list[k].coef * l_J_ij[j].tot_stag;
+							ct[icell].m_s[l].tot_stag += elts[k].coef * l_J_ij[j].tot_stag;
 						break;
 					}
 				}
@@ -3679,36 +3637,36 @@ fill_m_s(class J_ij *l_J_ij, int l_J_ij_count_spec, int icell, int stagnant)
 		}
 		else
 		{
-			for (k = 0; k < count_elts; k++)
+			for (k = 0; k < l_count_elts; k++)
 			{
-				if (strcmp(elt_list[k].elt->name, "X") == 0)
+				if (strcmp(elts[k].elt->name, "X") == 0)
 					continue;
-				if (strcmp(elt_list[k].elt->name, "H") == 0)
+				if (strcmp(elts[k].elt->name, "H") == 0)
 				{
-					tot1_h += elt_list[k].coef * l_J_ij[j].tot1;
-					tot2_h += elt_list[k].coef * l_J_ij[j].tot2;
+					tot1_h += elts[k].coef * l_J_ij[j].tot1;
+					tot2_h += elts[k].coef * l_J_ij[j].tot2;
 				}
-				else if (strcmp(elt_list[k].elt->name, "O") == 0)
+				else if (strcmp(elts[k].elt->name, "O") == 0)
 				{
-					tot1_o += elt_list[k].coef * l_J_ij[j].tot1;
-					tot2_o += elt_list[k].coef * l_J_ij[j].tot2;
+					tot1_o += elts[k].coef * l_J_ij[j].tot1;
+					tot2_o += elts[k].coef * l_J_ij[j].tot2;
 				}
 				else
 				{
 					for (l = 0; l < count_m_s; l++)
 					{
-						if (strcmp(m_s[l].name, elt_list[k].elt->name) == 0)
+						if (strcmp(m_s[l].name, elts[k].elt->name) == 0)
 						{
-							m_s[l].tot1 += elt_list[k].coef * l_J_ij[j].tot1;
-							m_s[l].tot2 += elt_list[k].coef * l_J_ij[j].tot2;
+							m_s[l].tot1 += elts[k].coef * l_J_ij[j].tot1;
+							m_s[l].tot2 += elts[k].coef * l_J_ij[j].tot2;
 							break;
 						}
 					}
 					if (l == count_m_s)
 					{
-						m_s[l].name = elt_list[k].elt->name;
-						m_s[l].tot1 = elt_list[k].coef * l_J_ij[j].tot1;
-						m_s[l].tot2 = elt_list[k].coef * l_J_ij[j].tot2;
+						m_s[l].name = elts[k].elt->name;
+						m_s[l].tot1 = elts[k].coef * l_J_ij[j].tot1;
+						m_s[l].tot2 = elts[k].coef * l_J_ij[j].tot2;
 						count_m_s++;
 					}
 				}
@@ -3718,6 +3676,28 @@ fill_m_s(class J_ij *l_J_ij, int l_J_ij_count_spec, int icell, int stagnant)
 	return (OK);
 }
 /* ---------------------------------------------------------------------- */
+const std::vector<class elt_list> & Phreeqc::
+mcd_species_elts(const char *name)
+/* ---------------------------------------------------------------------- */
+{
+	/*
+	*  elements in a species of J_ij, parsed once in a transport run.
+	*  name is the saved species name, the pointer is the key.
+	*/
+	std::map<const char *, std::vector<class elt_list> >::iterator it = mcd_elts.find(name);
+	if (it != mcd_elts.end())
+		return (it->second);
+
+	char * temp_name = string_duplicate(name);
+	const char* cptr = temp_name;
+	count_elts = 0;
+	get_elts_in_species(&cptr, 1);
+	free_check_null(temp_name);
+	std::vector<class elt_list> &elts = mcd_elts[name];
+	elts.assign(elt_list.begin(), elt_list.begin() + count_elts);
+	return (elts);
+}
+/* ---------------------------------------------------------------------- */
 void Phreeqc::
 calc_b_ij(int icell, int jcell, int k, LDBLE b_i, LDBLE b_j, LDBLE g_i, LDBLE g_j, LDBLE free_i, LDBLE free_j, int stagnant)
 /* ---------------------------------------------------------------------- */ 
@@ -4135,15 +4115,23 @@ find_J(int icell, int jcell, LDBLE mixf, LDBLE DDt, int stagnant)
 		/* also for interlayer cations */
 		k = sol_D[icell].count_exch_spec + sol_D[jcell].count_exch_spec;
 
-		ct[icell].J_ij_il = (class J_ij *) free_check_null(ct[icell].J_ij_il);
-		ct[icell].J_ij_il = (class J_ij *) PHRQ_malloc((size_t) k * sizeof(class J_ij));
-		if (ct[icell].J_ij_il == NULL)
-			malloc_error();
+		if (k > ct[icell].J_ij_il_size)
+		{
+			ct[icell].J_ij_il = (class J_ij *) free_check_null(ct[icell].J_ij_il);
+			ct[icell].J_ij_il = (class J_ij *) PHRQ_malloc((size_t) k * sizeof(class J_ij));
+			if (ct[icell].J_ij_il == NULL)
+				malloc_error();
+			ct[icell].J_ij_il_size = k;
+		}
 
-		ct[icell].v_m_il = (struct V_M *) free_check_null(ct[icell].v_m_il);
-		ct[icell].v_m_il = (struct V_M *) PHRQ_malloc((size_t) k * sizeof(struct V_M));
-		if (ct[icell].v_m_il == NULL)
-			malloc_error();
+		if (k > ct[icell].v_m_il_size)
+		{
+			ct[icell].v_m_il = (struct V_M *) free_check_null(ct[icell].v_m_il);
+			ct[icell].v_m_il = (struct V_M *) PHRQ_malloc((size_t) k * sizeof(struct V_M));
+			if (ct[icell].v_m_il == NULL)
+				malloc_error();
+			ct[icell].v_m_il_size = k;
+		}
 
 		for (i = 0; i < k; i++)
 		{
@@ -4513,10 +4501,14 @@ dV_dcell2:
 		if (ct[icell].v_m[i].z)
 			Sum_zM += ct[icell].v_m[i].b_ij * ct[icell].v_m[i].z * ct[icell].v_m[i].grad;
 	}
-	std::map<std::string, class J_ij_save> J_map;
+	if ((int)cell_J_ij.size() <= icell)
+		cell_J_ij.resize((size_t)icell + 1);
+	std::vector<class J_ij_save> &J_save_v = cell_J_ij[icell];
+	J_save_v.resize(ct[icell].J_ij_count_spec);
 	for (i = 0; i < ct[icell].J_ij_count_spec; i++)
 	{
-		class J_ij_save J_save;
+		class J_ij_save &J_save = J_save_v[i];
+		J_save.name = ct[icell].J_ij[i].name;
 		ct[icell].J_ij[i].tot1 = -ct[icell].v_m[i].grad;
 		J_save.flux_c = ct[icell].J_ij[i].tot1;
 		ct[icell].J_ij[i].charge = ct[icell].v_m[i].z;
@@ -4537,11 +4529,9 @@ dV_dcell2:
 			J_save.flux_c *= ct[icell].v_m[i].b_ij * DDt;
 			J_save.flux_t *= ct[icell].v_m[i].b_ij * DDt;
 		}
-		J_map[ct[icell].J_ij[i].name] = J_save;
 		ct[icell].J_ij[i].tot2 = ct[icell].J_ij[i].tot1;
 		//ct[icell].J_ij_sum += ct[icell].v_m[i].z * ct[icell].J_ij[i].tot1;
 	}
-	cell_J_ij[icell] = J_map;
 	// assure that icell and jcell have dl water when checking negative conc's in MCD
 	ct[icell].dl_s = dl_aq1;
 	ct[jcell].dl_s = dl_aq2;
@@ -4603,11 +4593,15 @@ dV_dcell2:
 
 		/* express the transfer in elemental moles... */
 		tot1_h = tot1_o = tot2_h = tot2_o = 0.0;
-		m_s = (class M_S *) free_check_null(m_s);
-		m_s = (class M_S *) PHRQ_malloc((size_t) count_moles_added *
-			sizeof(class M_S));
-		if (m_s == NULL)
-			malloc_error();
+		if (count_moles_added > m_s_size)
+		{
+			m_s = (class M_S *) free_check_null(m_s);
+			m_s = (class M_S *) PHRQ_malloc((size_t) count_moles_added *
+				sizeof(class M_S));
+			if (m_s == NULL)
+				malloc_error();
+			m_s_size = count_moles_added;
+		}
 		for (i1 = 0; i1 < count_moles_added; i1++)
 		{
 			m_s[i1].charge = 0;
@@ -4793,8 +4787,6 @@ dV_dcell2:
 	/* do not transport charge imbalance */
 	//ct[icell].J_ij_sum = 0;
 	//V_M = (struct V_M *) free_check_null(V_M);
-	if (il_calcs)
-		ct[icell].v_m_il = (struct V_M *) free_check_null(ct[icell].v_m_il);
 	return (il_calcs);
 }
 /* ---------------------------------------------------------------------- */
@@ -5870,7 +5862,7 @@ LDBLE new_Dw, int l_cell)
 		}
 	}
 	temp_surface.Sort_comps();
-	Rxn_surface_map[l_cell] = temp_surface;
+	Utilities::Rxn_store(Rxn_surface_map, l_cell, temp_surface);
 	return OK;
 }
 
@@ -6159,22 +6151,23 @@ flux_mcd(const char* species_name, int option)
 		if (s_ptr != NULL && s_ptr->in != FALSE && s_ptr->type < EMINUS)
 		{
 			int n = cell_no;
-			std::map<int, std::map<std::string, class J_ij_save> >::iterator
-				j_map_iter = cell_J_ij.find(n);
-			if (j_map_iter != cell_J_ij.end())
+			if (n >= 0 && n < (int)cell_J_ij.size())
 			{
-				std::map<std::string, class J_ij_save>::iterator
-					j_save_iter = j_map_iter->second.find(species_name);
-				if (j_save_iter != j_map_iter->second.end())
+				/* species names are saved strings, compare pointers */
+				std::vector<class J_ij_save> &J_save_v = cell_J_ij[n];
+				for (size_t i = 0; i < J_save_v.size(); i++)
 				{
+					if (J_save_v[i].name != s_ptr->name)
+						continue;
 					if (option == 1)
 					{
-						f = j_save_iter->second.flux_t;
+						f = J_save_v[i].flux_t;
 					}
 					else if (option == 2)
 					{
-						f = j_save_iter->second.flux_c;
+						f = J_save_v[i].flux_c;
 					}
+					break;
 				}
 			}
 		}
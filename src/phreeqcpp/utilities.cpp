@@ -1069,37 +1069,17 @@ string_hsave(const char *str)
  *         starting address of saved string (str)
  */
 	if (str == NULL) return (NULL);
-	std::map<std::string, std::string *>::const_iterator it;
-	it = strings_map.find(str);
-	if (it != strings_map.end())
-	{
-		return (it->second->c_str());
-	}
-
-	std::string *stdstr = new std::string(str);
-	strings_map[*stdstr] = stdstr;
-	return(stdstr->c_str());
+	return (strings_table.Get(strings_table.Intern(str)));
 }
 /* ---------------------------------------------------------------------- */
 void Phreeqc::
-strings_map_clear()
+strings_table_clear()
 /* ---------------------------------------------------------------------- */
 {
 /*
- *      Save character string str
- *
- *      Arguments:
- *         str   input string to save.
- *
- *      Returns:
- *         starting address of saved string (str)
+ *      Free all strings saved by string_hsave
  */
-	std::map<std::string, std::string *>::iterator it;
-	for (it = strings_map.begin(); it != strings_map.end(); it++)
-	{
-		delete it->second;
-	}
-	strings_map.clear();
+	strings_table.Clear();
 }
 /* ---------------------------------------------------------------------- */
 LDBLE Phreeqc::